@@ -21,6 +21,7 @@
 // efficiency calculation.
 // prototype version by S.Arcelli silvia.arcelli@cern.ch
 ///////////////////////////////////////////////////////////////////////////
+#include "TBits.h"
 #include "AliCFCutBase.h"
 #include "AliCFManager.h"
 
@@ -136,6 +137,95 @@ Bool_t AliCFManager::CheckEventCuts(Int_t isel, TObject *obj, const TString  &se
   return kTRUE;
 }
 
+//_____________________________________________________________________________
+ULong64_t AliCFManager::CompileParticleSelection(Int_t isel, const TString  &selcuts) const {
+  //
+  // translate the selection string into a mask of the cuts of particle-level selection isel
+  //
+
+  if(isel>=fNStepPart || !fPartCutList || !fPartCutList[isel]) return kAllCuts;
+  return CompileSelection(fPartCutList[isel],selcuts);
+}
+
+//_____________________________________________________________________________
+ULong64_t AliCFManager::CompileEventSelection(Int_t isel, const TString  &selcuts) const {
+  //
+  // translate the selection string into a mask of the cuts of event-level selection isel
+  //
+
+  if(isel>=fNStepEvt || !fEvtCutList || !fEvtCutList[isel]) return kAllCuts;
+  return CompileSelection(fEvtCutList[isel],selcuts);
+}
+
+//_____________________________________________________________________________
+Bool_t AliCFManager::CheckParticleCuts(Int_t isel, TObject *obj, ULong64_t selmask) const {
+  //
+  // check whether object obj passes the cuts of particle-level selection isel
+  // selected by the mask (see CompileParticleSelection)
+  //
+
+  if(isel>=fNStepPart){
+    AliWarning(Form("Selection index out of Range! isel=%i, max. number of selections= %i", isel,fNStepPart));
+    return kTRUE;
+  }
+  if(!fPartCutList[isel])return kTRUE;
+  return CheckCuts(fPartCutList[isel],obj,selmask);
+}
+
+//_____________________________________________________________________________
+Bool_t AliCFManager::CheckEventCuts(Int_t isel, TObject *obj, ULong64_t selmask) const {
+  //
+  // check whether object obj passes the cuts of event-level selection isel
+  // selected by the mask (see CompileEventSelection)
+  //
+
+  if(isel>=fNStepEvt){
+    AliWarning(Form("Selection index out of Range! isel=%i, max. number of selections= %i", isel,fNStepEvt));
+    return kTRUE;
+  }
+  if(!fEvtCutList[isel])return kTRUE;
+  return CheckCuts(fEvtCutList[isel],obj,selmask);
+}
+
+//_____________________________________________________________________________
+Int_t AliCFManager::CheckParticleCut(Int_t isel, Int_t icut, const TObjArray *objects, TBits &passed) const {
+  //
+  // evaluate the cut icut of particle-level selection isel on all the objects
+  // of the array, and store the decisions in passed (bit i <-> object i)
+  // A step without cut list accepts all the objects, missing objects never pass.
+  // Invalid selection or cut indexes reject all the objects.
+  //
+
+  passed.ResetAllBits();
+  if (!objects) return 0;
+
+  if(isel<0 || isel>=fNStepPart){
+    AliWarning(Form("Selection index out of Range! isel=%i, max. number of selections= %i", isel,fNStepPart));
+    return 0;
+  }
+
+  AliCFCutBase *cut = 0;
+  if (fPartCutList && fPartCutList[isel]) {
+    if(icut<0 || icut>=fPartCutList[isel]->GetEntriesFast()){
+      AliWarning(Form("Cut index out of Range! icut=%i, number of cuts in selection %i = %i", icut,isel,fPartCutList[isel]->GetEntriesFast()));
+      return 0;
+    }
+    cut = (AliCFCutBase*)fPartCutList[isel]->UncheckedAt(icut);
+  }
+
+  Int_t nobj = objects->GetEntriesFast();
+
+  Int_t npassed = 0;
+  for (Int_t iobj=0; iobj<nobj; iobj++) {
+    TObject *obj = objects->UncheckedAt(iobj);
+    if (!obj) continue;
+    if (cut && !cut->IsSelected(obj)) continue;
+    passed.SetBitNumber(iobj);
+    npassed++;
+  }
+  return npassed;
+}
+
 //_____________________________________________________________________________
 void  AliCFManager::SetMCEventInfo(const TObject *obj) const {
 
@@ -222,6 +312,41 @@ Bool_t AliCFManager::CompareStrings(const TString  &cutname,const TString  &selc
 }
 
 
+//_____________________________________________________________________________
+ULong64_t AliCFManager::CompileSelection(const TObjArray *cuts, const TString  &selcuts) const{
+  //
+  // build the mask of the cuts of the list whose name is in selcuts
+  //
+
+  if(selcuts.Contains("all"))return kAllCuts;
+
+  ULong64_t selmask = 0;
+  for (Int_t icut=0; icut<cuts->GetEntriesFast(); icut++) {
+    TObject *cut = cuts->UncheckedAt(icut);
+    if (!cut || !CompareStrings(cut->GetName(),selcuts)) continue;
+    if (icut>=64) {
+      AliWarning(Form("Cut %s has index %d in its list and cannot be selected individually, use \"all\"",cut->GetName(),icut));
+      continue;
+    }
+    selmask |= ((ULong64_t)1 << icut);
+  }
+  return selmask;
+}
+
+//_____________________________________________________________________________
+Bool_t AliCFManager::CheckCuts(const TObjArray *cuts, TObject *obj, ULong64_t selmask) const{
+  //
+  // AND of the cuts of the list selected by the mask
+  //
+
+  for (Int_t icut=0; icut<cuts->GetEntriesFast(); icut++) {
+    if (icut<64 ? !(selmask & ((ULong64_t)1 << icut)) : selmask!=kAllCuts) continue;
+    AliCFCutBase *cut = (AliCFCutBase*)cuts->UncheckedAt(icut);
+    if (cut && !cut->IsSelected(obj)) return kFALSE;
+  }
+  return kTRUE;
+}
+
 //_____________________________________________________________________________
 void AliCFManager::SetEventCutsList(Int_t isel, TObjArray* array) {
   //
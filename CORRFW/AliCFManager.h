@@ -28,6 +28,8 @@
 #include "AliCFContainer.h"
 #include "AliLog.h"
 
+class TBits;
+
 //____________________________________________________________________________
 class AliCFManager : public TNamed 
 {
@@ -116,6 +118,25 @@ class AliCFManager : public TNamed
   virtual Bool_t CheckEventCuts(Int_t isel, TObject *obj, const TString &selcuts="all") const;
   virtual Bool_t CheckParticleCuts(Int_t isel, TObject *obj, const TString &selcuts="all") const;
 
+  //Precompiled selections: the string selcuts is translated once into a mask
+  //of the indices of the selected cuts in the list of step isel, which can be
+  //passed to the checkers below instead of the string (the string comparison
+  //is then not repeated for each object). Only the first 64 cuts of a list
+  //can be selected individually, the others are only checked with kAllCuts.
+
+  static const ULong64_t kAllCuts = ~((ULong64_t)0); // mask selecting all the cuts of a list
+
+  virtual ULong64_t CompileEventSelection(Int_t isel, const TString &selcuts="all") const;
+  virtual ULong64_t CompileParticleSelection(Int_t isel, const TString &selcuts="all") const;
+  virtual Bool_t CheckEventCuts(Int_t isel, TObject *obj, ULong64_t selmask) const;
+  virtual Bool_t CheckParticleCuts(Int_t isel, TObject *obj, ULong64_t selmask) const;
+
+  //Batched checker: evaluates the cut icut of particle selection step isel
+  //on all the objects of the array; bit i of passed is set if object i passes
+  //the cut. Returns the number of objects passing the cut (0 for invalid
+  //isel or icut).
+  virtual Int_t CheckParticleCut(Int_t isel, Int_t icut, const TObjArray *objects, TBits &passed) const;
+
  private:
   
   //number of steps
@@ -131,6 +152,8 @@ class AliCFManager : public TNamed
   TObjArray **fPartCutList ; //[fNStepPart] arrays of cuts for each particle-selection level
 
   Bool_t CompareStrings(const TString  &cutname,const TString  &selcuts) const;
+  ULong64_t CompileSelection(const TObjArray *cuts, const TString &selcuts) const;
+  Bool_t CheckCuts(const TObjArray *cuts, TObject *obj, ULong64_t selmask) const;
 
   ClassDef(AliCFManager,2);
 };
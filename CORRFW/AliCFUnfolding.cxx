@@ -130,7 +130,16 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fToyCondValue(),
+  fToyCondM(),
+  fToyCondT(),
+  fToyInvResponse(),
+  fToyPriorOrig(),
+  fToyEfficiencyBin(),
+  fToyMeasuredBin(),
+  fToyUnfoldedBin(),
+  fToyNMeasured(0)
 {
   //
   // default constructor
@@ -174,7 +183,16 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fToyCondValue(),
+  fToyCondM(),
+  fToyCondT(),
+  fToyInvResponse(),
+  fToyPriorOrig(),
+  fToyEfficiencyBin(),
+  fToyMeasuredBin(),
+  fToyUnfoldedBin(),
+  fToyNMeasured(0)
 {
   //
   // named constructor
@@ -454,33 +472,40 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
   //         -> fDeltaUnfoldedP (TProfile with option "S")
   // Step 4: Repeat Step 1-3 several times (fNRandomIterations)
   // Step 5: The spread of fDeltaUnfoldedP for each bin is the error on the unfolded spectrum of that specific bin
+  //
+  // Without smoothing, steps 1-4 are done on flat arrays (see UnfoldRandomizedDists),
+  // which avoids cloning the THnSparse objects at each bayes iteration of each
+  // randomized distribution. Smoothing needs the full THnSparse, so in this case
+  // the randomized distributions are unfolded with Unfold().
 
-
-  //Do fNRandomIterations = bayes iterations performed
-  for (int i=0; i<fNRandomIterations; i++) {
+  if (!fUseSmoothing) UnfoldRandomizedDists();
+  else {
+    //Do fNRandomIterations = bayes iterations performed
+    for (int i=0; i<fNRandomIterations; i++) {
     
-    // reset prior to original one
-    if (fPrior) delete fPrior ;
-    fPrior = (THnSparse*) fPriorOrig->Clone();
+      // reset prior to original one
+      if (fPrior) delete fPrior ;
+      fPrior = (THnSparse*) fPriorOrig->Clone();
 
-    // create randomized distribution and stick measured spectrum to it
-    CreateRandomizedDist();
+      // create randomized distribution and stick measured spectrum to it
+      CreateRandomizedDist();
 
-    if (fResponse) delete fResponse ;
-    fResponse = (THnSparse*) fRandomResponse->Clone();
-    fResponse->SetTitle("Response");
+      if (fResponse) delete fResponse ;
+      fResponse = (THnSparse*) fRandomResponse->Clone();
+      fResponse->SetTitle("Response");
 
-    if (fEfficiency) delete fEfficiency ;
-    fEfficiency = (THnSparse*) fRandomEfficiency->Clone();
-    fEfficiency->SetTitle("Efficiency");
+      if (fEfficiency) delete fEfficiency ;
+      fEfficiency = (THnSparse*) fRandomEfficiency->Clone();
+      fEfficiency->SetTitle("Efficiency");
 
-    if (fMeasured)   delete fMeasured   ;
-    fMeasured = (THnSparse*) fRandomMeasured->Clone();
-    fMeasured->SetTitle("Measured");
+      if (fMeasured)   delete fMeasured   ;
+      fMeasured = (THnSparse*) fRandomMeasured->Clone();
+      fMeasured->SetTitle("Measured");
 
-    //unfold with randomized distributions
-    Unfold();
-    FillDeltaUnfoldedProfile();
+      //unfold with randomized distributions
+      Unfold();
+      FillDeltaUnfoldedProfile();
+    }
   }
 
   // Get statistical errors for final unfolded spectrum
@@ -504,6 +529,159 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
   fNCalcCorrErrors = 2;
 }
 
+//______________________________________________________________
+void AliCFUnfolding::CompileToyUnfolding() {
+  //
+  // Converts the inputs of the unfolding of the randomized distributions into flat arrays.
+  // The conditional matrix is not modified by the randomization, so it is stored as
+  // a list of (measured index, true index, value) entries ; the measured and true
+  // coordinates are mapped to compact indices using empty THnSparse frames as hash tables.
+  // For each bin of the original efficiency, measured and final unfolded spectra,
+  // the corresponding index is stored, so that no coordinate lookup is needed per iteration.
+  //
+
+  THnSparse* trueFrame = (THnSparse*) fPrior->Clone();
+  trueFrame->Reset();
+  THnSparse* measuredFrame = (THnSparse*) fMeasured->Clone();
+  measuredFrame->Reset();
+
+  Long_t nCond = fConditional->GetNbins();
+  fToyCondValue  .Set(nCond);
+  fToyCondM      .Set(nCond);
+  fToyCondT      .Set(nCond);
+  fToyInvResponse.Set(nCond);
+  for (Long_t iBin=0; iBin<nCond; iBin++) {
+    fToyCondValue[iBin] = fConditional->GetBinContent(iBin,fCoordinates2N);
+    GetCoordinates();
+    fToyCondM[iBin]       = measuredFrame->GetBin(fCoordinatesN_M);
+    fToyCondT[iBin]       = trueFrame    ->GetBin(fCoordinatesN_T);
+    fToyInvResponse[iBin] = fInverseResponse->GetBinContent(fCoordinates2N);
+  }
+  fToyNMeasured = measuredFrame->GetNbins();
+
+  fToyPriorOrig.Set(trueFrame->GetNbins());
+  fToyPriorOrig.Reset();
+  for (Long_t iBin=0; iBin<fPriorOrig->GetNbins(); iBin++) {
+    Double_t priorValue = fPriorOrig->GetBinContent(iBin,fCoordinatesN_T);
+    Long64_t index = trueFrame->GetBin(fCoordinatesN_T,kFALSE);
+    if (index>=0) fToyPriorOrig[index] = priorValue;
+  }
+
+  fToyEfficiencyBin.Set(fEfficiencyOrig->GetNbins());
+  for (Long_t iBin=0; iBin<fEfficiencyOrig->GetNbins(); iBin++) {
+    fEfficiencyOrig->GetBinContent(iBin,fCoordinatesN_T);
+    fToyEfficiencyBin[iBin] = trueFrame->GetBin(fCoordinatesN_T,kFALSE);
+  }
+
+  fToyMeasuredBin.Set(fMeasuredOrig->GetNbins());
+  for (Long_t iBin=0; iBin<fMeasuredOrig->GetNbins(); iBin++) {
+    fMeasuredOrig->GetBinContent(iBin,fCoordinatesN_M);
+    fToyMeasuredBin[iBin] = measuredFrame->GetBin(fCoordinatesN_M,kFALSE);
+  }
+
+  fToyUnfoldedBin.Set(fUnfoldedFinal->GetNbins());
+  for (Long_t iBin=0; iBin<fUnfoldedFinal->GetNbins(); iBin++) {
+    fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_T);
+    fToyUnfoldedBin[iBin] = trueFrame->GetBin(fCoordinatesN_T,kFALSE);
+  }
+
+  AliInfo(Form("Compiled unfolding: %ld response bins, %d measured and %d true indices",nCond,fToyNMeasured,fToyPriorOrig.GetSize()));
+
+  delete trueFrame;
+  delete measuredFrame;
+}
+
+//______________________________________________________________
+void AliCFUnfolding::UnfoldRandomizedDists() {
+  //
+  // Steps 1-4 of CalculateCorrelatedErrors() on flat arrays : for each randomized
+  // distribution, the same bayes iterations as in Unfold() (CreateEstMeasured,
+  // CreateInvResponse, CreateUnfolded) are performed, with the same random sequence,
+  // then the delta with respect to fUnfoldedFinal is accumulated.
+  // The scratch arrays are allocated once for all the randomized distributions.
+  //
+
+  CompileToyUnfolding();
+
+  const Int_t nCond  = fToyCondValue.GetSize();
+  const Int_t nTrue  = fToyPriorOrig.GetSize();
+  const Int_t nFinal = fToyUnfoldedBin.GetSize();
+
+  TArrayD efficiency(nTrue), measured(fToyNMeasured), estMeasured(fToyNMeasured);
+  TArrayD prior(nTrue), priorTimesEff(nTrue), unfolded(nTrue);
+  TArrayD finalValue(nFinal), deltaMean(nFinal), deltaMeanX2(nFinal);
+
+  for (Int_t iFinal=0; iFinal<nFinal; iFinal++) finalValue[iFinal] = fUnfoldedFinal->GetBinContent((Long64_t)iFinal);
+
+  for (Int_t iRandom=0; iRandom<fNRandomIterations; iRandom++) {
+
+    // Step 1: randomize, in the same order as CreateRandomizedDist().
+    // The conditional matrix is computed once from the original response,
+    // the randomized response is only drawn to keep the random sequence.
+    for (Long_t iBin=0; iBin<fResponseOrig->GetNbins(); iBin++) {
+      fRandom3->Gaus(fResponseOrig->GetBinContent((Long64_t)iBin),fResponseOrig->GetBinError((Long64_t)iBin));
+    }
+    efficiency.Reset();
+    for (Long_t iBin=0; iBin<fEfficiencyOrig->GetNbins(); iBin++) {
+      Double_t ran = fRandom3->Gaus(fEfficiencyOrig->GetBinContent((Long64_t)iBin),fEfficiencyOrig->GetBinError((Long64_t)iBin));
+      if (fToyEfficiencyBin[iBin]>=0) efficiency[fToyEfficiencyBin[iBin]] = ran;
+    }
+    measured.Reset();
+    for (Long_t iBin=0; iBin<fMeasuredOrig->GetNbins(); iBin++) {
+      Double_t ran = fRandom3->Gaus(fMeasuredOrig->GetBinContent((Long64_t)iBin),fMeasuredOrig->GetBinError((Long64_t)iBin));
+      if (fToyMeasuredBin[iBin]>=0) measured[fToyMeasuredBin[iBin]] = ran;
+    }
+
+    // Step 2: unfold, starting from the original prior
+    for (Int_t iTrue=0; iTrue<nTrue; iTrue++) prior[iTrue] = fToyPriorOrig[iTrue];
+
+    for (Int_t iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) {
+      for (Int_t iTrue=0; iTrue<nTrue; iTrue++) priorTimesEff[iTrue] = prior[iTrue] * efficiency[iTrue];
+
+      // measured estimate
+      estMeasured.Reset();
+      for (Int_t iCond=0; iCond<nCond; iCond++) {
+        Double_t fill = fToyCondValue[iCond] * priorTimesEff[fToyCondT[iCond]];
+        if (fill>0.) estMeasured[fToyCondM[iCond]] += fill;
+      }
+
+      // inverse response
+      for (Int_t iCond=0; iCond<nCond; iCond++) {
+        Double_t estMeasuredValue = estMeasured[fToyCondM[iCond]];
+        Double_t fill = (estMeasuredValue>0. ? fToyCondValue[iCond] * priorTimesEff[fToyCondT[iCond]] / estMeasuredValue : 0.);
+        if (fill>0. || fToyInvResponse[iCond]>0.) fToyInvResponse[iCond] = fill;
+      }
+
+      // unfolded spectrum, which is the prior of the next iteration
+      unfolded.Reset();
+      for (Int_t iCond=0; iCond<nCond; iCond++) {
+        Double_t effValue = efficiency[fToyCondT[iCond]];
+        Double_t fill = (effValue>0. ? fToyInvResponse[iCond] * measured[fToyCondM[iCond]] / effValue : 0.);
+        if (fill>0.) unfolded[fToyCondT[iCond]] += fill;
+      }
+      for (Int_t iTrue=0; iTrue<nTrue; iTrue++) prior[iTrue] = unfolded[iTrue];
+    }
+
+    // Step 3: running mean of the delta and of its square, as in FillDeltaUnfoldedProfile()
+    for (Int_t iFinal=0; iFinal<nFinal; iFinal++) {
+      Double_t unfoldedValue = (fToyUnfoldedBin[iFinal]>=0 ? unfolded[fToyUnfoldedBin[iFinal]] : 0.);
+      Double_t deltaInBin = finalValue[iFinal] - unfoldedValue;
+      deltaMean  [iFinal] = (deltaMean  [iFinal] * iRandom + deltaInBin)            / (iRandom+1);
+      deltaMeanX2[iFinal] = (deltaMeanX2[iFinal] * iRandom + deltaInBin*deltaInBin) / (iRandom+1);
+    }
+  }
+
+  if (fNRandomIterations<=0) return;
+
+  for (Long_t iBin=0; iBin<nFinal; iBin++) {
+    fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_T);
+    fDeltaUnfoldedP->SetBinError  (fCoordinatesN_T,deltaMeanX2[iBin]);
+    fDeltaUnfoldedP->SetBinContent(fCoordinatesN_T,deltaMean[iBin]);
+    fDeltaUnfoldedN->SetBinContent(fCoordinatesN_T,fNRandomIterations);
+  }
+  AliInfo(Form("=======================\nUnfolded %d randomized distributions with %d iterations each\n",fNRandomIterations,fMaxNumIterations));
+}
+
 //______________________________________________________________
 void AliCFUnfolding::CreateRandomizedDist() {
   //
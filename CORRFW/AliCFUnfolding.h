@@ -12,6 +12,8 @@
 
 #include "TNamed.h"
 #include "THnSparse.h"
+#include "TArrayI.h"
+#include "TArrayD.h"
 #include "AliLog.h"
 
 class TF1;
@@ -112,6 +114,17 @@ class AliCFUnfolding : public TNamed {
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
 
+  /* flat-array representation used to unfold the randomized distributions */
+  TArrayD        fToyCondValue;      //! Content of each bin of the conditional matrix
+  TArrayI        fToyCondM;          //! Measured space index of each bin of the conditional matrix
+  TArrayI        fToyCondT;          //! True space index of each bin of the conditional matrix
+  TArrayD        fToyInvResponse;    //! Inverse response, one value per bin of the conditional matrix
+  TArrayD        fToyPriorOrig;      //! Original prior, indexed in true space
+  TArrayI        fToyEfficiencyBin;  //! True space index of each bin of fEfficiencyOrig (-1 if not in the response)
+  TArrayI        fToyMeasuredBin;    //! Measured space index of each bin of fMeasuredOrig (-1 if not in the response)
+  TArrayI        fToyUnfoldedBin;    //! True space index of each bin of fUnfoldedFinal (-1 if not in the response)
+  Int_t          fToyNMeasured;      //! Number of measured space indices
+
 
   // functions
   void     Init();                  // initialisation of the internal settings
@@ -130,9 +143,11 @@ class AliCFUnfolding : public TNamed {
   void     CalculateCorrelatedErrors(); // Calculates correlated errors for the final unfolded spectrum
   void     CreateRandomizedDist();      // Create randomized dist from measured distribution
   void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
+  void     CompileToyUnfolding();       // Converts the inputs of the randomized unfoldings into flat arrays
+  void     UnfoldRandomizedDists();     // Unfolds the randomized distributions on flat arrays and fills fDeltaUnfoldedP
   void     SetMaxConvergencePerDOF (Double_t val);
 
-  ClassDef(AliCFUnfolding,1);
+  ClassDef(AliCFUnfolding,2);
 };
 
 #endif
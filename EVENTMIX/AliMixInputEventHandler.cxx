@@ -11,6 +11,7 @@
 #include <TChain.h>
 #include <TChainElement.h>
 #include <TSystem.h>
+#include <TMath.h>
 
 #include "AliLog.h"
 #include "AliAnalysisManager.h"
@@ -37,6 +38,7 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fDoMixExtra(kTRUE),
    fDoMixIfNotEnoughEvents(kTRUE),
    fDoMixEventGetEntryAuto(kTRUE),
+   fMixTreeCacheSize(0),
    fCurrentEntry(0),
    fCurrentEntryMain(0),
    fCurrentEntryMix(0),
@@ -153,6 +155,7 @@ Bool_t AliMixInputEventHandler::Notify(const char *path)
    for (Int_t i = 0; i < fInputHandlers.GetEntries(); i++) {
       AliDebug(AliLog::kDebug + 5, Form("fInputHandlers[%d]", i));
       mixIHI = new AliMixInputHandlerInfo(fMixIntupHandlerInfoTmp->GetName(), fMixIntupHandlerInfoTmp->GetTitle());
+      mixIHI->SetTreeCacheSize(fMixTreeCacheSize);
       if (doPrepareEntry) mixIHI->PrepareEntry(che, -1, (AliInputEventHandler *)InputEventHandler(i), fAnalysisType);
       AliDebug(AliLog::kDebug + 5, Form("chain[%d]->GetEntries() = %lld", i, mixIHI->GetChain()->GetEntries()));
       fMixTrees.Add(mixIHI);
@@ -245,15 +248,18 @@ Bool_t AliMixInputEventHandler::MixStd()
    AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
    // reset mix number
    fNumberMixed = 0;
-   AliMixInputHandlerInfo *mihi = 0;
+   AliMixInputHandlerInfo *mihi = (AliMixInputHandlerInfo *) fMixTrees.At(0);
    Long64_t entryMix = 0, entryMixReal = 0;
    Int_t counter = 0;
-   for (counter = 0; counter < mixNum; counter++) {
-      entryMix = fEntryCounter - 1 - counter ;
+   // mixed events are read file by file (see AliMixInputHandlerInfo::SortEntriesByFile)
+   TArrayL64 entriesMix(TMath::Max(0, (Int_t) TMath::Min((Long64_t) mixNum, fEntryCounter)));
+   for (counter = 0; counter < entriesMix.GetSize(); counter++) entriesMix.AddAt(fEntryCounter - 1 - counter, counter);
+   if (fDoMixEventGetEntryAuto) fMixIntupHandlerInfoTmp->SortEntriesByFile(entriesMix, mihi->GetCurrentFileName());
+   for (counter = 0; counter < entriesMix.GetSize(); counter++) {
+      entryMix = entriesMix.At(counter);
       AliDebug(AliLog::kDebug + 5, Form("Handler[%d] entryMix %lld ", counter, entryMix));
       if (entryMix < 0) break;
       entryMixReal = entryMix;
-      mihi = (AliMixInputHandlerInfo *) fMixTrees.At(0);
       TChainElement *te = fMixIntupHandlerInfoTmp->GetEntryInTree(entryMix);
       if (!te) {
          AliError("te is null. this is error. tell to developer (#1)");
@@ -456,15 +462,25 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    Long64_t entryMix = 0, entryMixReal = 0;
    Int_t counter = 0;
    mihi = (AliMixInputHandlerInfo *) fMixTrees.At(0);
-   // fills num for main events
+   // collects mixing candidates from entry list (newest first), which are then
+   // read file by file (see AliMixInputHandlerInfo::SortEntriesByFile)
+   TArrayL64 entriesMix(mixNum);
+   Int_t nEntriesMix = 0;
    for (counter = 0; counter < mixNum; counter++) {
-      fCurrentMixEntry.Reset();
       Long64_t entryInEntryList =  elNum - 2 - counter;
       AliDebug(AliLog::kDebug + 3, Form("entryInEntryList=%lld", entryInEntryList));
       if (entryInEntryList < 0) break;
       entryMix = el->GetEntry(entryInEntryList);
       AliDebug(AliLog::kDebug + 3, Form("entryMix=%lld", entryMix));
       if (entryMix < 0) break;
+      entriesMix.AddAt(entryMix, nEntriesMix++);
+   }
+   entriesMix.Set(nEntriesMix);
+   if (fDoMixEventGetEntryAuto) fMixIntupHandlerInfoTmp->SortEntriesByFile(entriesMix, mihi->GetCurrentFileName());
+   // fills num for main events
+   for (counter = 0; counter < nEntriesMix; counter++) {
+      fCurrentMixEntry.Reset();
+      entryMix = entriesMix.At(counter);
       entryMixReal = entryMix;
       TChainElement *te = fMixIntupHandlerInfoTmp->GetEntryInTree(entryMix);
       if (!te) {
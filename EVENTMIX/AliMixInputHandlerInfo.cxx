@@ -12,6 +12,10 @@
 #include <TFile.h>
 #include <TChainElement.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "AliLog.h"
 #include "AliInputEventHandler.h"
 
@@ -24,7 +28,9 @@ AliMixInputHandlerInfo::AliMixInputHandlerInfo(const char *name, const char *tit
    fChain(0),
    fChainEntriesArray(),
    fZeroEntryNumber(0),
-   fNeedNotify(kFALSE)
+   fNeedNotify(kFALSE),
+   fChainEntriesSum(),
+   fTreeCacheSize(0)
 {
    //
    // Default constructor.
@@ -81,6 +87,8 @@ void AliMixInputHandlerInfo::AddTreeToChain(const char *path)
    fChainEntriesArray.Set(lastIndex);
    AliDebug(AliLog::kDebug + 3, Form("Adding %lld to id %d", fChain->GetTree()->GetEntries(), lastIndex - 1));
    fChainEntriesArray.AddAt((Int_t)fChain->GetTree()->GetEntries(), (Int_t)lastIndex - 1);
+   fChainEntriesSum.Set(lastIndex);
+   fChainEntriesSum.AddAt((lastIndex > 1 ? fChainEntriesSum.At(lastIndex - 2) : 0) + fChainEntriesArray.At(lastIndex - 1), lastIndex - 1);
    AliDebug(AliLog::kDebug + 5, Form("-> %s", path));
 }
 
@@ -98,22 +106,77 @@ TChainElement *AliMixInputHandlerInfo::GetEntryInTree(Long64_t &entry)
       AliDebug(AliLog::kDebug + 5, "->");
       return 0;
    }
-   Long64_t sumTree = fZeroEntryNumber;
-   for (Int_t i = 0; i < fChainEntriesArray.GetSize() ; i++) {
-      sumTree += fChainEntriesArray.At(i);
-      if (sumTree > entry) {
-         sumTree = entry - sumTree + fChainEntriesArray.At(i);
-         AliDebug(AliLog::kDebug + 1, Form("Entry in current tree num is %lld with i=%d", sumTree, i));
-         entry = sumTree;
-         AliDebug(AliLog::kDebug + 5, "->");
-         return (TChainElement *) fChain->GetListOfFiles()->At(i);
-      }
+   Int_t low = FindFile(entry);
+   if (low >= 0) {
+      entry -= fZeroEntryNumber + (low > 0 ? fChainEntriesSum.At(low - 1) : 0);
+      AliDebug(AliLog::kDebug + 1, Form("Entry in current tree num is %lld with i=%d", entry, low));
+      AliDebug(AliLog::kDebug + 5, "->");
+      return (TChainElement *) fChain->GetListOfFiles()->At(low);
    }
    entry = -1;
    AliDebug(AliLog::kDebug + 5, "->");
    return 0;
 }
 
+//_____________________________________________________________________________
+Int_t AliMixInputHandlerInfo::FindFile(Long64_t entry)
+{
+   //
+   // Returns index of file containing entry (binary search), -1 if not found
+   //
+   Int_t nFiles = fChainEntriesArray.GetSize();
+   if (fChainEntriesSum.GetSize() != nFiles) {
+      fChainEntriesSum.Set(nFiles);
+      Long64_t sumTree = 0;
+      for (Int_t i = 0; i < nFiles ; i++) {
+         sumTree += fChainEntriesArray.At(i);
+         fChainEntriesSum.AddAt(sumTree, i);
+      }
+   }
+   if (entry < fZeroEntryNumber) return -1;
+   // first file which ends after entry
+   Int_t low = 0, high = nFiles;
+   while (low < high) {
+      Int_t mid = (low + high) / 2;
+      if (fChainEntriesSum.At(mid) + fZeroEntryNumber > entry) high = mid;
+      else low = mid + 1;
+   }
+   return (low < nFiles) ? low : -1;
+}
+
+//_____________________________________________________________________________
+void AliMixInputHandlerInfo::SortEntriesByFile(TArrayL64 &entries, const char *firstFile)
+{
+   //
+   // Sorts entries (of full chain) file by file, entries of file firstFile
+   // (the one currently open for mixing) first, then the other files in chain
+   // order. Inside every file entries are in increasing order, so every file is
+   // opened once and read forward. Entries not found in chain are kept at the end.
+   //
+   Int_t n = entries.GetSize();
+   if (n < 2) return;
+   TString first(firstFile ? firstFile : "");
+   std::vector<std::pair<Int_t, Long64_t> > keys(n);
+   for (Int_t i = 0; i < n; i++) {
+      Int_t iFile = FindFile(entries.At(i));
+      Int_t key = (iFile < 0) ? fChainEntriesArray.GetSize() + 1 : iFile + 1;
+      if (iFile >= 0 && !first.IsNull() && !first.CompareTo(fChain->GetListOfFiles()->At(iFile)->GetTitle())) key = 0;
+      keys[i] = std::make_pair(key, entries.At(i));
+   }
+   std::stable_sort(keys.begin(), keys.end());
+   for (Int_t i = 0; i < n; i++) entries.AddAt(keys[i].second, i);
+}
+
+//_____________________________________________________________________________
+const char *AliMixInputHandlerInfo::GetCurrentFileName() const
+{
+   //
+   // Returns name of file currently open for mixing ("" if none)
+   //
+   if (!fChain || !fChain->GetTree() || !fChain->GetTree()->GetCurrentFile()) return "";
+   return fChain->GetTree()->GetCurrentFile()->GetName();
+}
+
 //_____________________________________________________________________________
 void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, AliInputEventHandler *eh, Option_t *opt)
 {
@@ -128,9 +191,7 @@ void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, Ali
    if (entry < 0) {
       AliDebug(AliLog::kDebug, Form("We are creating new chain from file %s ...", te->GetTitle()));
       if (!fChain) {
-         fChain = new TChain(te->GetName());
-         fChain->AddFile(te->GetTitle());
-         fChain->GetEntry(0);
+         fChain = OpenChain(te);
          eh->Init(opt);
          eh->Init(fChain->GetTree(), opt);
       }
@@ -145,10 +206,7 @@ void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, Ali
          AliDebug(AliLog::kDebug, Form("Filename %s is NOT same ...", te->GetTitle()));
          AliDebug(AliLog::kDebug, Form("We are changing to file %s ...", te->GetTitle()));
          // change file
-         delete fChain;
-         fChain = new TChain(te->GetName());
-         fChain->AddFile(te->GetTitle());
-         fChain->GetEntry(0);
+         fChain = OpenChain(te);
          eh->Init(opt);
          eh->Init(fChain->GetTree(), opt);
          eh->Notify(te->GetTitle());
@@ -171,6 +229,22 @@ void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, Ali
    AliDebug(AliLog::kDebug + 5, "->");
 }
 
+//_____________________________________________________________________________
+TChain *AliMixInputHandlerInfo::OpenChain(TChainElement *te)
+{
+   //
+   // Replaces current chain by chain with file of te only (first entry loaded).
+   // Only one file is kept open, since the input handler has one event object
+   // connected to the branches of the current tree.
+   //
+   if (fChain) delete fChain;
+   TChain *chain = new TChain(te->GetName());
+   chain->AddFile(te->GetTitle());
+   if (fTreeCacheSize > 0) chain->SetCacheSize(fTreeCacheSize);
+   chain->GetEntry(0);
+   return chain;
+}
+
 //_____________________________________________________________________________
 Long64_t AliMixInputHandlerInfo::GetEntries()
 {
@@ -10,6 +10,7 @@
 #ifndef ALIMIXINPUTHANDLERINFO_H
 #define ALIMIXINPUTHANDLERINFO_H
 #include <TArrayI.h>
+#include <TArrayL64.h>
 #include <TNamed.h>
 
 class TTree;
@@ -32,17 +33,27 @@ public:
    void SetZeroEntryNumber(Long64_t num) { fZeroEntryNumber = num; }
    TChainElement *GetEntryInTree(Long64_t &entry);
    Long64_t      GetEntries();
+   void          SortEntriesByFile(TArrayL64 &entries, const char *firstFile);
+   const char   *GetCurrentFileName() const;
+
+   void SetTreeCacheSize(Long64_t size) { fTreeCacheSize = size; }
+   Long64_t GetTreeCacheSize() const { return fTreeCacheSize; }
 
 private:
    TChain    *fChain;              // current chain
    TArrayI   fChainEntriesArray;   // array of entries of every chaing
    Long64_t  fZeroEntryNumber;     // zero entry number (will be used when we will delete not needed chains)
    Bool_t    fNeedNotify;          // flag if Notify is needed for current input handler
+   TArrayL64 fChainEntriesSum;     //! cumulative number of entries up to (including) every file
+   Long64_t  fTreeCacheSize;       // size of TTreeCache for opened files (0 = default)
+
+   TChain   *OpenChain(TChainElement *te);
+   Int_t     FindFile(Long64_t entry);
 
    AliMixInputHandlerInfo(const AliMixInputHandlerInfo &handler);
    AliMixInputHandlerInfo &operator=(const AliMixInputHandlerInfo &handler);
 
-   ClassDef(AliMixInputHandlerInfo, 1); // Mix Input Handler info
+   ClassDef(AliMixInputHandlerInfo, 2); // Mix Input Handler info
 };
 
 #endif // ALIMIXINPUTHANDLERINFO_H
@@ -27,7 +27,9 @@
 #include "TList.h"
 #include "TFile.h"
 #include "TStopwatch.h"
-#include "TArrayL64.h"
+#include <algorithm>
+#include <functional>
+#include <vector>
 
 ClassImp(AliMultSelectionCalibrator);
 
@@ -430,13 +432,35 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
     }
 
     // STEP 4: Actual determination of boundaries...
-    Long64_t *index;
-    Double_t *lValues; 
+    //Column buffers: value of each estimator for each event of the run being processed
+    //(memory allocation: reused for all runs)
+    std::vector< std::vector<Float_t> > lEstValues(lNEstimators);
+    std::vector<Float_t> lSelectBuffer;
+    Long64_t lPositions[1000];
+    Float_t  lPositionValues[1000];
 
     //Histograms to store calibration information
     TH1F *hCalib[1000][lNEstimators];
     
-    cout<<"(4) Look at average values"<<endl;
+    //might be needed
+    Long64_t lAcceptedEvents;
+    
+    //=========================================
+    // Determine Calibration Information 
+    //=========================================
+    
+    //Open output OADB file, generate everything within loop
+    TFile * f = new TFile (fOutputFileName.Data(), "recreate");
+    AliOADBContainer * oadbContMS = new AliOADBContainer("MultSel");
+    
+    AliOADBMultSelection * oadbMultSelection = 0x0; 
+    AliMultSelectionCuts * cuts = 0x0; 
+    AliMultSelection     * fsels = 0x0;
+
+    //Actual Calibration Histograms
+    TH1F * hCalibData[lNEstimators];
+
+    cout<<"(4) Look at average values and generate boundaries through a loop in all desired estimators"<<endl;
     for(Int_t iRun=0; iRun<fNRunRanges; iRun++) {
 
         //Contextualize AliMultSelection for this run
@@ -444,20 +468,28 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
 
         // Calibration pre-optimization and setup
         fSelection->Setup ( fInput );
-
-        const Int_t lNEstimatorsThis = fSelection->GetNEstimators();
 	
+        const Int_t lNEstimatorsThis = fSelection->GetNEstimators(); 
+
         const Long64_t ntot = (Long64_t) sTree[iRun]->GetEntries();
         if ( !lAutoDiscover ){
             cout<<"--- Processing run range "<<fFirstRun[iRun]<<"-"<<fLastRun[iRun]<<" ("<<iRun<<"/"<<fNRunRanges<<"), with "<<ntot<<" events..."<<endl;
         }else{
             cout<<"--- Processing run "<<lRunNumbers[iRun]<<" ("<<iRun<<"/"<<fNRunRanges<<"), with "<<ntot<<" events..."<<endl;
         }
-        sTree[iRun]->SetEstimate(ntot+1);
-        //Cast Run Number into drawing conditions
+        
+        //Single pass on the run: evaluate all estimators for each event into the column buffers
+        cout<<"--- Evaluating estimators... "<<flush;
+        for(Int_t iEst=0; iEst<lNEstimatorsThis; iEst++) lEstValues[iEst].resize(ntot);
+        for( Long64_t iEntry=0; iEntry<ntot; iEntry++) {
+            sTree[iRun]->GetEntry( iEntry );
+            fSelection->Evaluate ( fInput );
+            for(Int_t iEst=0; iEst<lNEstimatorsThis; iEst++) lEstValues[iEst][iEntry] = fSelection->GetEstimator(iEst)->GetValue();
+        }
+        cout<<"Done!"<<endl;
+        
         for(Int_t iEst=0; iEst<lNEstimatorsThis; iEst++) {
-            lRunStats[iRun] = sTree[iRun]->Draw(fSelection->GetEstimator(iEst)->GetDefinition(),"","goff");
-            lValues = sTree[iRun]->GetV1();
+            const std::vector<Float_t> &lValues = lEstValues[iEst];
             cout<<"--- Calculating averages: "<<flush;
             for( Long64_t iEntry=0; iEntry<ntot; iEntry++) {
                 Float_t lThisVal = lValues[iEntry]; //Test
@@ -469,75 +501,32 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
                     lMaxEst[iEst][iRun] = lThisVal;
                 }
             }
-            if( sTree[iRun]->GetEntries() < 1 ) {
+            if( ntot < 1 ) {
                 lAvEst[iEst][iRun] = -1;
             } else {
-                lAvEst[iEst][iRun] /= ( (Double_t) (sTree[iRun]->GetEntries()) );
+                lAvEst[iEst][iRun] /= ( (Double_t) (ntot) );
             }
             cout<<" Min = "<<lMinEst[iEst][iRun]<<", Max = "<<lMaxEst[iEst][iRun]<<", Av = "<<lAvEst[iEst][iRun]<<endl;
             
             if ( TMath::Abs( lMinEst[iEst][iRun] - lMaxEst[iEst][iRun] ) < 1e-6 ){
                 lInsane[iEst][iRun] = kTRUE; //No valid information to do calibration, please be careful !
             }
-            
         }
-    }
-    //might be needed
-    Long64_t lAcceptedEvents;
-    
-    //=========================================
-    // Determine Calibration Information 
-    //=========================================
-    
-    //Open output OADB file, generate everything within loop
-    TFile * f = new TFile (fOutputFileName.Data(), "recreate");
-    AliOADBContainer * oadbContMS = new AliOADBContainer("MultSel");
-    
-    AliOADBMultSelection * oadbMultSelection = 0x0; 
-    AliMultSelectionCuts * cuts = 0x0; 
-    AliMultSelection     * fsels = 0x0;
-
-    //Actual Calibration Histograms
-    TH1F * hCalibData[lNEstimators];
-
-    cout<<"(5) Generate Boundaries through a loop in all desired estimators"<<endl;
-    for(Int_t iRun=0; iRun<fNRunRanges; iRun++) {
-
-        //Contextualize AliMultSelection for this run
-        if ( !lAutoDiscover ) fSelection = (AliMultSelection*) fMultSelectionList->At(iRun);
-
-        // Calibration pre-optimization and setup
-        fSelection->Setup ( fInput );
-	
-        const Int_t lNEstimatorsThis = fSelection->GetNEstimators(); 
-
-        const Long64_t ntot = (Long64_t) sTree[iRun]->GetEntries();
-        if ( !lAutoDiscover ){
-            cout<<"--- Processing run range "<<fFirstRun[iRun]<<"-"<<fLastRun[iRun]<<" ("<<iRun<<"/"<<fNRunRanges<<"), with "<<ntot<<" events..."<<endl;
-        }else{
-            cout<<"--- Processing run "<<lRunNumbers[iRun]<<" ("<<iRun<<"/"<<fNRunRanges<<"), with "<<ntot<<" events..."<<endl;
-        }
-        sTree[iRun]->SetEstimate(ntot+1);
-        // Memory allocation: don't repeat it per estimator! only per run
-        TArrayL64 index(ntot);
-        //Cast Run Number into drawing conditions
+        
         for(Int_t iEst=0; iEst<lNEstimatorsThis; iEst++) {
+            const std::vector<Float_t> &lValues = lEstValues[iEst];
             if( ! ( fSelection->GetEstimator(iEst)->IsInteger() ) ) {
                 //==== Floating Point Calibration Engine ====
-                lRunStats[iRun] = sTree[iRun]->Draw(fSelection->GetEstimator(iEst)->GetDefinition(),"","goff");
-                cout<<"--- Sorting estimator "<<fSelection->GetEstimator(iEst)->GetName()<<"..."<<flush;
-                
-                TMath::Sort(ntot,sTree[iRun]->GetV1(), index.GetArray() );
-                cout<<" Done! Getting Boundaries... "<<flush;
+                lRunStats[iRun] = ntot;
                 
                 //Special override in case anchored estimator
                 if( fSelection->GetEstimator(iEst)->GetUseAnchor() ){
                     cout<<"Anchoring... "<<flush;
                     //Require determination of index after which values are to be discarded
-                    //Count fraction of accepted
-                    TString lCondition = fSelection->GetEstimator(iEst)->GetDefinition();
-                    lCondition.Append(Form("> %.10f",fSelection->GetEstimator(iEst)->GetAnchorPoint() ) );
-                    lAcceptedEvents = sTree[iRun]->Draw(fSelection->GetEstimator(iEst)->GetDefinition(),lCondition.Data(),"goff");
+                    //Count fraction of accepted (same threshold as the former TTree::Draw selection)
+                    Double_t lAnchorCut = TString::Format("%.10f",fSelection->GetEstimator(iEst)->GetAnchorPoint()).Atof();
+                    lAcceptedEvents = 0;
+                    for( Long64_t iEntry=0; iEntry<ntot; iEntry++) if( lValues[iEntry] > lAnchorCut ) lAcceptedEvents++;
                     lRunStats[iRun] = lAcceptedEvents;
                 }
                 lNrawBoundaries[0] = 0.0; //Defined OK even if anchored
@@ -559,13 +548,21 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
                         position = (Long64_t) ( ( 0.01 * ((Double_t)(ntot)* lDesiredBoundaries[lB] ) ) * lScalingFactor );
                         if(position > ntot-1 ) position = ntot-1; //protection !
                     }
-                    //cout<<"Position requested: "<<position<<flush;
-                    sTree[iRun]->GetEntry( index[position] );
-                    //Calculate the estimator with this input, please
+                    lPositions[lB-1] = position;
+                }
+                
+                //Boundaries: estimator values at the requested positions in decreasing order
+                cout<<"--- Selecting boundaries for estimator "<<fSelection->GetEstimator(iEst)->GetName()<<"..."<<flush;
+                if ( ntot > 0 ) {
+                    lSelectBuffer.assign( lValues.begin(), lValues.end() );
+                    SelectDescending( &lSelectBuffer[0], ntot, lNDesiredBoundaries-1, lPositions, lPositionValues );
+                } else {
+                    //No events: keep the value of the last evaluation
                     fSelection->Evaluate ( fInput );
-                    //fSelection->PrintInfo();
-                    lNrawBoundaries[lB] = fSelection->GetEstimator(iEst)->GetValue();
+                    for( Long_t lB=1; lB<lNDesiredBoundaries; lB++) lPositionValues[lB-1] = fSelection->GetEstimator(iEst)->GetValue();
                 }
+                for( Long_t lB=1; lB<lNDesiredBoundaries; lB++) lNrawBoundaries[lB] = lPositionValues[lB-1];
+                
                 //Cross-check correct rejection of anything beyond anchor point
                 if( fSelection->GetEstimator(iEst)->GetUseAnchor() && ntot != 0 ){
                     for( Long_t lB=0; lB<lNDesiredBoundaries-1; lB++) {
@@ -616,14 +613,15 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
                 Float_t lLowEdge = lMinEst[iEst][iRun]-0.5;
                 Float_t lHighEdge= lMaxEst[iEst][iRun]+0.5;
                 cout<<"Inspect: "<<lNBins<<", low "<<lLowEdge<<", high "<<lHighEdge<<endl;
-                if( sTree[iRun]->GetEntries() < 1 ) {
+                if( ntot < 1 ) {
                     //Case of an empty run!
                     hCalib[iRun][iEst] = new TH1F(Form("hCalib_%i_%s",lRunNumbers[iRun],fSelection->GetEstimator(iEst)->GetName()),"",1,0,1);
                     hCalib[iRun][iEst]->SetDirectory(0);
                 } else {
                     TH1F *hTemporary = new TH1F("hTemporary", "", lNBins, lMinEst[iEst][iRun]-0.5, lMaxEst[iEst][iRun]+0.5 );
                     //hTemporary->SetDirectory(0);
-                    lRunStats[iRun] = sTree[iRun]->Draw(Form("%s>>hTemporary",fSelection->GetEstimator(iEst)->GetDefinition().Data()),"","goff");
+                    for( Long64_t iEntry=0; iEntry<ntot; iEntry++) hTemporary->Fill( lValues[iEntry] );
+                    lRunStats[iRun] = ntot;
                     cout<<"entries = "<<lRunStats[iRun]<<endl;
                     //In memory now: histogram with content, please normalize to unity
                     hTemporary->Scale(1./((double)(lRunStats[iRun])));
@@ -765,6 +763,43 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
     return kTRUE;
 }
 //________________________________________________________________
+void AliMultSelectionCalibrator::SelectDescending( Float_t *lValues, Long64_t lN, Long_t lNPositions, const Long64_t *lPositions, Float_t *lResults ) {
+    //Find the values at the requested positions of the list of values ordered
+    //in decreasing order (i.e. lValues[index[position]] after TMath::Sort), without
+    //sorting the full list: O(N log(NPositions)) instead of O(N log(N)).
+    //The list of values is partially reordered.
+    if ( lNPositions < 1 || lN < 1 ) return;
+    
+    //Positions in increasing order
+    Long64_t lOrder[1000];
+    Long64_t lSorted[1000];
+    TMath::Sort( (Long64_t) lNPositions, lPositions, lOrder, kFALSE );
+    for( Long_t iP=0; iP<lNPositions; iP++) lSorted[iP] = TMath::Min( TMath::Max( lPositions[lOrder[iP]], (Long64_t) 0 ), lN-1 );
+    
+    Float_t lSortedResults[1000];
+    SelectDescendingRange( lValues, 0, lN, lSorted, lSortedResults, 0, lNPositions );
+    for( Long_t iP=0; iP<lNPositions; iP++) lResults[lOrder[iP]] = lSortedResults[iP];
+}
+//________________________________________________________________
+void AliMultSelectionCalibrator::SelectDescendingRange( Float_t *lValues, Long64_t lLow, Long64_t lHigh, const Long64_t *lPositions, Float_t *lResults, Long_t lFirst, Long_t lLast ) {
+    //Recursive multiple selection: lValues[lLow, lHigh) contains exactly the values
+    //with ranks lLow to lHigh-1, and lPositions[lFirst, lLast) are all within that range
+    if ( lFirst >= lLast ) return;
+    
+    Long_t lMid = (lFirst + lLast)/2;
+    Long64_t lPosition = lPositions[lMid];
+    std::nth_element( lValues + lLow, lValues + lPosition, lValues + lHigh, std::greater<Float_t>() );
+    
+    //Requests for the same position
+    Long_t lLeft = lMid, lRight = lMid;
+    while ( lLeft > lFirst && lPositions[lLeft-1] == lPosition ) lLeft--;
+    while ( lRight < lLast && lPositions[lRight] == lPosition ) lRight++;
+    for( Long_t iP=lLeft; iP<lRight; iP++) lResults[iP] = lValues[lPosition];
+    
+    SelectDescendingRange( lValues, lLow, lPosition, lPositions, lResults, lFirst, lLeft );
+    SelectDescendingRange( lValues, lPosition+1, lHigh, lPositions, lResults, lRight, lLast );
+}
+//________________________________________________________________
 Float_t AliMultSelectionCalibrator::MinVal( Float_t A, Float_t B ) {
     if( A < B ) {
         return A;
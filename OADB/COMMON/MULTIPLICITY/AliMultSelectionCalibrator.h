@@ -78,7 +78,12 @@ public:
     //Helper
     Float_t MinVal( Float_t A, Float_t B );
     
+    //Helper: values at given positions of the list sorted in decreasing order, without a full sort
+    static void SelectDescending( Float_t *lValues, Long64_t lN, Long_t lNPositions, const Long64_t *lPositions, Float_t *lResults );
+    
 private:
+    static void SelectDescendingRange( Float_t *lValues, Long64_t lLow, Long64_t lHigh, const Long64_t *lPositions, Float_t *lResults, Long_t lFirst, Long_t lLast );
+    
     AliMultInput     *fInput;     //Object for all input
     AliMultSelection *fSelection; //(current) transient pointer object
 
@@ -139,6 +139,7 @@ fhEMCALClusterEtaPhi(0),     fhEMCALClusterEtaPhiFidCut(0),
 fhEMCALClusterTimeE(0),
 fEnergyHistogramNbins(0),
 fhNEventsAfterCut(0),        fNMCGenerToAccept(0),            fMCGenerEventHeaderToAccept(""),
+fMCGenIndexCache(0),         fMCGenIndexPath(0),
 fGenEventHeader(0),          fGenPythiaEventHeader(0)
 {
   for(Int_t i = 0; i < 8; i++) fhEMCALClusterCutsE [i]= 0x0 ;    
@@ -306,7 +307,10 @@ Bool_t  AliCaloTrackReader::AcceptParticleMCLabel(Int_t mcLabel) const
 //_____________________________________________________________________
 /// Get the name of the generator that generated a given primary particle 
 /// Copy of AliMCEvent::GetCocktailGeneratorAndIndex(), modified to get the 
-/// the generator index in the cocktail
+/// the generator index in the cocktail.
+/// The generator index found for a label, and for the mothers walked
+/// through to find it, is kept until the next event, so that the
+/// following requests for the same labels do not walk the stack again.
 ///
 /// \param index: mc label index
 /// \param nameGen: cocktail generator name for this index
@@ -315,6 +319,16 @@ Bool_t  AliCaloTrackReader::AcceptParticleMCLabel(Int_t mcLabel) const
 Int_t AliCaloTrackReader::GetCocktailGeneratorAndIndex(Int_t index, TString & nameGen) const
 {
   //method that gives the generator for a given particle with label index (or that of the corresponding primary)
+  if ( index >= 0 && index < fMCGenIndexCache.GetSize() && fMCGenIndexCache.At(index) > -2 )
+  {
+    Int_t genIndex = fMCGenIndexCache.At(index);
+    
+    if ( genIndex >= 0 ) nameGen = GetMC()->GetCocktailList()->At(genIndex)->GetName();
+    else                 nameGen = "";
+    
+    return genIndex;
+  }
+  
   AliVParticle* mcpart0 = (AliVParticle*) GetMC()->GetTrack(index);
   Int_t genIndex = -1;
   
@@ -329,9 +343,13 @@ Int_t AliCaloTrackReader::GetCocktailGeneratorAndIndex(Int_t index, TString & na
   if(nameGen.Contains("nococktailheader") ) return -1;
   
   Int_t lab=index;
+  Int_t nPath = 0;
   
   while(nameGen.IsWhitespace())
   {
+    if ( nPath >= fMCGenIndexPath.GetSize() ) fMCGenIndexPath.Set(TMath::Max(2*nPath, 16));
+    fMCGenIndexPath[nPath++] = lab;
+    
     AliVParticle* mcpart = (AliVParticle*) GetMC()->GetTrack(lab);
     
     if(!mcpart)
@@ -361,6 +379,21 @@ Int_t AliCaloTrackReader::GetCocktailGeneratorAndIndex(Int_t index, TString & na
     nameGen = GetGeneratorNameAndIndex(mother,genIndex);
   }
   
+  // Keep the result for all the labels walked through
+  Int_t nMC = GetMC()->GetNumberOfTracks();
+  if ( fMCGenIndexCache.GetSize() < nMC )
+  {
+    Int_t size = fMCGenIndexCache.GetSize();
+    fMCGenIndexCache.Set(nMC);
+    for(Int_t i = size; i < nMC; i++) fMCGenIndexCache[i] = -2;
+  }
+  
+  if ( index < nMC ) fMCGenIndexCache[index] = genIndex;
+  for(Int_t i = 0; i < nPath; i++)
+  {
+    if ( fMCGenIndexPath[i] < nMC ) fMCGenIndexCache[fMCGenIndexPath[i]] = genIndex;
+  }
+  
   return genIndex;
 }
 //_____________________________________________________________________
@@ -1288,6 +1321,9 @@ Bool_t AliCaloTrackReader::FillInputEvent(Int_t iEntry, const char * /*curFileNa
   fIsTriggerMatchOpenCut[1] = kFALSE ;
   fIsTriggerMatchOpenCut[2] = kFALSE ;
   
+  // Forget the generators of the MC labels of the previous event
+  fMCGenIndexCache.Reset(-2);
+  
   //fCurrentFileName = TString(currentFileName);
   if(!fInputEvent)
   {
@@ -1010,6 +1010,9 @@ public:
 
   TString          fMCGenerEventHeaderToAccept;    ///<  Accept events that contain at least this event header name
   
+  mutable TArrayI  fMCGenIndexCache;               //!<! Cocktail generator index of each MC label in the current event, -2 if not known yet
+  mutable TArrayI  fMCGenIndexPath;                //!<! Labels walked through in GetCocktailGeneratorAndIndex()
+  
   
   AliGenEventHeader       * fGenEventHeader;       //!<! Event header
   AliGenPythiaEventHeader * fGenPythiaEventHeader; //!<! Event header casted to pythia
@@ -1021,7 +1024,7 @@ public:
   AliCaloTrackReader & operator = (const AliCaloTrackReader & r) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliCaloTrackReader,81) ;
+  ClassDef(AliCaloTrackReader,82) ;
   /// \endcond
 
 } ;
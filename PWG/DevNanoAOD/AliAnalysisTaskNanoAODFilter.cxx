@@ -63,7 +63,8 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter() // All data members
   fSaveAODZDC(kFALSE),
   fSaveVzero(kFALSE),
   fInputArrayName(""),
-  fOutputArrayName("")
+  fOutputArrayName(""),
+  fColumnar(kFALSE)
 {
   // Dummy constructor ALWAYS needed for I/O.
 }
@@ -83,7 +84,8 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter(const char *name, Boo
    fSaveAODZDC(kFALSE),
    fSaveVzero(kFALSE),
    fInputArrayName(""),
-   fOutputArrayName("")
+   fOutputArrayName(""),
+   fColumnar(kFALSE)
 
 {
   // Constructor
@@ -143,6 +145,7 @@ void AliAnalysisTaskNanoAODFilter::AddFilteredAOD(const char* aodfilename, const
   if (fVarListHeader_fTC) rep->SetVarListHeaderStringVariable(fVarListHeader_fTC);
   if (!fInputArrayName.IsNull()) rep->SetInputArrayName(fInputArrayName);
   if (!fOutputArrayName.IsNull()) rep->SetOutputArrayName(fOutputArrayName);
+  if (fColumnar) rep->SetColumnarMode(kTRUE);
 
   std::cout << "SETTER: " << fSetter << " " << rep->GetCustomSetter() << std::endl;
 
@@ -0,0 +1,119 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//-------------------------------------------------------------------------
+//     Columnar storage for NanoAOD tracks, see header for details
+//-------------------------------------------------------------------------
+
+#include <cstring>
+
+#include "AliNanoAODColumn.h"
+
+ClassImp(AliNanoAODColumn)
+ClassImp(AliNanoAODIntColumn)
+
+//______________________________________________________________________________
+AliNanoAODColumn::AliNanoAODColumn() :
+  TNamed(),
+  fN(0),
+  fCapacity(0),
+  fValues(0)
+{
+  // default constructor, needed for I/O: does not allocate
+}
+
+//______________________________________________________________________________
+AliNanoAODColumn::AliNanoAODColumn(const char * name) :
+  TNamed(name, name),
+  fN(0),
+  fCapacity(0),
+  fValues(0)
+{
+  // constructor
+}
+
+//______________________________________________________________________________
+AliNanoAODColumn::~AliNanoAODColumn()
+{
+  // destructor
+  delete [] fValues;
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumn::Clear(Option_t * /*opt*/)
+{
+  // reset the column for the next event, keeping the allocated buffer
+  fN = 0;
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumn::Reserve(Int_t n)
+{
+  // grow the buffer to hold at least n values, preserving the content
+  if (n <= fCapacity && fValues) return;
+
+  Double32_t * values = new Double32_t[n];
+  if (fValues && fN > 0) memcpy(values, fValues, fN * sizeof(Double32_t));
+  delete [] fValues;
+  fValues = values;
+  fCapacity = n;
+}
+
+//______________________________________________________________________________
+AliNanoAODIntColumn::AliNanoAODIntColumn() :
+  TNamed(),
+  fN(0),
+  fCapacity(0),
+  fValues(0)
+{
+  // default constructor, needed for I/O: does not allocate
+}
+
+//______________________________________________________________________________
+AliNanoAODIntColumn::AliNanoAODIntColumn(const char * name) :
+  TNamed(name, name),
+  fN(0),
+  fCapacity(0),
+  fValues(0)
+{
+  // constructor
+}
+
+//______________________________________________________________________________
+AliNanoAODIntColumn::~AliNanoAODIntColumn()
+{
+  // destructor
+  delete [] fValues;
+}
+
+//______________________________________________________________________________
+void AliNanoAODIntColumn::Clear(Option_t * /*opt*/)
+{
+  // reset the column for the next event, keeping the allocated buffer
+  fN = 0;
+}
+
+//______________________________________________________________________________
+void AliNanoAODIntColumn::Reserve(Int_t n)
+{
+  // grow the buffer to hold at least n values, preserving the content
+  if (n <= fCapacity && fValues) return;
+
+  Int_t * values = new Int_t[n];
+  if (fValues && fN > 0) memcpy(values, fValues, fN * sizeof(Int_t));
+  delete [] fValues;
+  fValues = values;
+  fCapacity = n;
+}
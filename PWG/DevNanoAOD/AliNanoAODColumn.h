@@ -0,0 +1,75 @@
+#ifndef ALINANOAODCOLUMN_H
+#define ALINANOAODCOLUMN_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//-------------------------------------------------------------------------
+//     Columnar storage for NanoAOD tracks
+//     Each AliNanoAODColumn holds one track variable for all the tracks
+//     of an event in a contiguous array. When the NanoAOD is produced in
+//     columnar mode (AliNanoAODReplicator::SetColumnarMode) every
+//     variable of the mapping is written as one of these objects, and
+//     therefore ends up in its own TTree branch: an analysis which
+//     only reads a few variables only decompresses those branches.
+//
+//     AliNanoAODIntColumn is the integer counterpart, used for the
+//     label and the charge which are not part of the variable mapping.
+//-------------------------------------------------------------------------
+
+#include "TNamed.h"
+
+class AliNanoAODColumn : public TNamed {
+
+public:
+  AliNanoAODColumn();
+  AliNanoAODColumn(const char * name);
+  virtual ~AliNanoAODColumn();
+
+  virtual void Clear(Option_t * opt = "");
+
+  Int_t              GetSize()            const { return fN; }
+  const Double32_t * GetArray()           const { return fValues; }
+  Double_t           At(Int_t i)          const { return fValues[i]; }
+
+  void Reserve(Int_t n);
+  void Push(Double_t value) { if (fN >= fCapacity) Reserve(fCapacity > 0 ? 2*fCapacity : 64); fValues[fN++] = value; }
+
+private:
+  AliNanoAODColumn(const AliNanoAODColumn&); // not implemented
+  AliNanoAODColumn& operator=(const AliNanoAODColumn&); // not implemented
+
+  Int_t        fN;        // number of tracks stored for the current event
+  Int_t        fCapacity; //! allocated size of fValues
+  Double32_t * fValues;   //[fN] values of the variable, one per track
+
+  ClassDef(AliNanoAODColumn, 1); // one NanoAOD track variable for all the tracks of the event
+};
+
+class AliNanoAODIntColumn : public TNamed {
+
+public:
+  AliNanoAODIntColumn();
+  AliNanoAODIntColumn(const char * name);
+  virtual ~AliNanoAODIntColumn();
+
+  virtual void Clear(Option_t * opt = "");
+
+  Int_t         GetSize()   const { return fN; }
+  const Int_t * GetArray()  const { return fValues; }
+  Int_t         At(Int_t i) const { return fValues[i]; }
+
+  void Reserve(Int_t n);
+  void Push(Int_t value) { if (fN >= fCapacity) Reserve(fCapacity > 0 ? 2*fCapacity : 64); fValues[fN++] = value; }
+
+private:
+  AliNanoAODIntColumn(const AliNanoAODIntColumn&); // not implemented
+  AliNanoAODIntColumn& operator=(const AliNanoAODIntColumn&); // not implemented
+
+  Int_t   fN;        // number of tracks stored for the current event
+  Int_t   fCapacity; //! allocated size of fValues
+  Int_t * fValues;   //[fN] values, one per track
+
+  ClassDef(AliNanoAODIntColumn, 1); // one integer NanoAOD track property for all the tracks of the event
+};
+
+#endif
@@ -0,0 +1,118 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//-------------------------------------------------------------------------
+//     Reader for NanoAODs produced in columnar mode, see header for usage
+//-------------------------------------------------------------------------
+
+#include "TTree.h"
+#include "TBranch.h"
+#include "TObjString.h"
+
+#include "AliLog.h"
+#include "AliAODEvent.h"
+
+#include "AliNanoAODColumnReader.h"
+
+ClassImp(AliNanoAODColumnReader)
+
+//______________________________________________________________________________
+AliNanoAODColumnReader::AliNanoAODColumnReader(const char * arrayName) :
+  TObject(),
+  fArrayName(arrayName),
+  fVarNames(),
+  fColumns(),
+  fLabels(0),
+  fCharges(0)
+{
+  // constructor
+  fVarNames.SetOwner(kTRUE);
+}
+
+//______________________________________________________________________________
+Int_t AliNanoAODColumnReader::AddVariable(const char * var)
+{
+  // Request a variable. Returns the slot to be used in GetColumn.
+  // Requesting the same variable twice returns the same slot.
+
+  for (Int_t islot = 0; islot < fVarNames.GetEntriesFast(); islot++) {
+    if (!strcmp(fVarNames.UncheckedAt(islot)->GetName(), var)) return islot;
+  }
+  fVarNames.AddLast(new TObjString(var));
+  return fVarNames.GetEntriesFast() - 1;
+}
+
+//______________________________________________________________________________
+Bool_t AliNanoAODColumnReader::Connect(const AliAODEvent * event, TTree * tree)
+{
+  // Resolve the requested columns in the event. To be called once per
+  // file (e.g. from UserNotify): the column objects are owned by the event
+  // and stay the same for all the entries of the file.
+  // If the tree is given, the branches of the columns which were not
+  // requested are disabled.
+
+  fColumns.Clear();
+  fColumns.Expand(fVarNames.GetEntriesFast());
+  fLabels  = 0;
+  fCharges = 0;
+
+  if (!event) {
+    AliError("No event");
+    return kFALSE;
+  }
+
+  Bool_t allFound = kTRUE;
+  for (Int_t islot = 0; islot < fVarNames.GetEntriesFast(); islot++) {
+    TString colName = GetColumnName(fArrayName, fVarNames.UncheckedAt(islot)->GetName());
+    AliNanoAODColumn * col = dynamic_cast<AliNanoAODColumn*>(event->FindListObject(colName));
+    if (!col) {
+      AliError(Form("Column %s not found: was the NanoAOD produced in columnar mode with this variable?", colName.Data()));
+      allFound = kFALSE;
+    }
+    fColumns.AddAt(col, islot);
+  }
+  fLabels  = dynamic_cast<AliNanoAODIntColumn*>(event->FindListObject(GetColumnName(fArrayName, "label")));
+  fCharges = dynamic_cast<AliNanoAODIntColumn*>(event->FindListObject(GetColumnName(fArrayName, "charge")));
+  if (!fLabels) {
+    AliError(Form("Column %s not found", GetColumnName(fArrayName, "label").Data()));
+    allFound = kFALSE;
+  }
+
+  if (tree) DisableUnusedBranches(tree);
+
+  return allFound;
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumnReader::DisableUnusedBranches(TTree * tree) const
+{
+  // Switch off all the column branches of our array which were not requested
+
+  TString prefix = fArrayName + "_";
+  TObjArray * branches = tree->GetListOfBranches();
+  for (Int_t ib = 0; ib < branches->GetEntriesFast(); ib++) {
+    TString brName = branches->UncheckedAt(ib)->GetName();
+    if (!brName.BeginsWith(prefix)) continue;
+
+    TString var = brName(prefix.Length(), brName.Length());
+    if (var == "label" || var == "charge") continue;
+
+    Bool_t used = kFALSE;
+    for (Int_t islot = 0; islot < fVarNames.GetEntriesFast() && !used; islot++) {
+      used = (var == fVarNames.UncheckedAt(islot)->GetName());
+    }
+    if (!used) tree->SetBranchStatus(brName + "*", 0);
+  }
+}
@@ -0,0 +1,81 @@
+#ifndef ALINANOAODCOLUMNREADER_H
+#define ALINANOAODCOLUMNREADER_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//-------------------------------------------------------------------------
+//     Reader for NanoAODs produced in columnar mode
+//
+//     Usage (in an analysis task):
+//       - in the constructor / UserCreateOutputObjects register the
+//         variables you need:  fPtSlot = fReader->AddVariable("pt");
+//       - in UserNotify call fReader->Connect(aodEvent, tree): the
+//         columns are looked up once per file, and (if a tree is
+//         given) the branches of the variables which were not
+//         requested are switched off so that they are not read at all
+//       - in UserExec loop over the tracks:
+//           AliNanoAODColumnSpan pt = fReader->GetColumn(fPtSlot);
+//           for (Int_t i = 0; i < pt.GetSize(); i++) ... pt[i] ...
+//-------------------------------------------------------------------------
+
+#include "TObject.h"
+#include "TString.h"
+#include "TObjArray.h"
+
+#include "AliNanoAODColumn.h"
+
+class AliAODEvent;
+class TTree;
+
+// Light-weight view over the values of one column for the current event
+class AliNanoAODColumnSpan {
+
+public:
+  AliNanoAODColumnSpan() : fData(0), fSize(0) {}
+  AliNanoAODColumnSpan(const Double32_t * data, Int_t size) : fData(data), fSize(size) {}
+
+  Int_t              GetSize()              const { return fSize; }
+  const Double32_t * GetData()              const { return fData; }
+  Double_t           operator[](Int_t i)    const { return fData[i]; }
+  Bool_t             IsValid()              const { return fData != 0 || fSize == 0; }
+
+private:
+  const Double32_t * fData; // first element
+  Int_t              fSize; // number of elements
+};
+
+class AliNanoAODColumnReader : public TObject {
+
+public:
+  AliNanoAODColumnReader(const char * arrayName = "tracks");
+  virtual ~AliNanoAODColumnReader() {}
+
+  Int_t  AddVariable(const char * var);
+  Bool_t Connect(const AliAODEvent * event, TTree * tree = 0);
+
+  Int_t  GetNTracks() const { return fLabels ? fLabels->GetSize() : 0; }
+  AliNanoAODColumnSpan GetColumn(Int_t slot) const {
+    const AliNanoAODColumn * col = static_cast<const AliNanoAODColumn*>(fColumns.At(slot));
+    return col ? AliNanoAODColumnSpan(col->GetArray(), col->GetSize()) : AliNanoAODColumnSpan();
+  }
+  const Int_t * GetLabels()  const { return fLabels  ? fLabels->GetArray()  : 0; }
+  const Int_t * GetCharges() const { return fCharges ? fCharges->GetArray() : 0; }
+
+  static TString GetColumnName(const char * arrayName, const char * var) { return TString::Format("%s_%s", arrayName, var); }
+
+private:
+  AliNanoAODColumnReader(const AliNanoAODColumnReader&); // not implemented
+  AliNanoAODColumnReader& operator=(const AliNanoAODColumnReader&); // not implemented
+
+  void DisableUnusedBranches(TTree * tree) const;
+
+  TString               fArrayName; // name of the track array the columns were produced for
+  TObjArray             fVarNames;  // names of the requested variables, indexed by slot
+  TObjArray             fColumns;   //! columns of the current file, indexed by slot (not owned)
+  AliNanoAODIntColumn * fLabels;    //! label column of the current file
+  AliNanoAODIntColumn * fCharges;   //! charge column of the current file
+
+  ClassDef(AliNanoAODColumnReader, 1); // reader for columnar NanoAOD tracks
+};
+
+#endif
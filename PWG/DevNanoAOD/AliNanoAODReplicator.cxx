@@ -75,6 +75,8 @@ class AliAODRecoDecay;
 #include "TCanvas.h"
 #include "AliNanoAODHeader.h"
 #include "AliNanoAODCustomSetter.h"
+#include "AliNanoAODColumn.h"
+#include "AliNanoAODColumnReader.h"
 
 using std::cout;
 using std::endl;
@@ -103,6 +105,10 @@ AliAODBranchReplicator(),
   fSaveVzero(0),
   fInputArrayName(""),
   fOutputArrayName("tracks"),
+  fColumnar(kFALSE),
+  fColumns(0x0),
+  fLabelColumn(0x0),
+  fChargeColumn(0x0),
   fVarListHeader_fTC(""){
   // Default ctor. we need it to avoid instantiating a wrong mapping when reading from file
   }
@@ -134,6 +140,10 @@ AliNanoAODReplicator::AliNanoAODReplicator(const char* name, const char* title,
   fSaveVzero(0),
   fInputArrayName(""),
   fOutputArrayName("tracks"),
+  fColumnar(kFALSE),
+  fColumns(0x0),
+  fLabelColumn(0x0),
+  fChargeColumn(0x0),
   fVarListHeader_fTC("")
 {
   // default ctor
@@ -158,6 +168,8 @@ AliNanoAODReplicator::~AliNanoAODReplicator()
   // dtor
   delete fTrackCut;
   delete fList;
+  delete fColumns;
+  if(fColumnar) delete fTracks; // not part of fList in columnar mode
 }
 
 //_____________________________________________________________________________
@@ -437,7 +449,21 @@ TList* AliNanoAODReplicator::GetList() const
 
       fTracks = new TClonesArray("AliNanoAODTrack");
       fTracks->SetName(fOutputArrayName.Data()); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
-      fList->Add(fTracks);
+      if(!fColumnar) {
+        fList->Add(fTracks);
+      } else {
+        // fTracks is only used as in-memory staging area: one branch per variable is written instead
+        fColumns = new TObjArray(fNTracksVariables);
+        for (Int_t ivar = 0; ivar < fNTracksVariables; ivar++) {
+          AliNanoAODColumn * col = new AliNanoAODColumn(AliNanoAODColumnReader::GetColumnName(fOutputArrayName, AliNanoAODTrackMapping::GetInstance()->GetVarName(ivar)));
+          fColumns->AddAt(col, ivar);
+          fList->Add(col);
+        }
+        fLabelColumn = new AliNanoAODIntColumn(AliNanoAODColumnReader::GetColumnName(fOutputArrayName, "label"));
+        fList->Add(fLabelColumn);
+        fChargeColumn = new AliNanoAODIntColumn(AliNanoAODColumnReader::GetColumnName(fOutputArrayName, "charge"));
+        fList->Add(fChargeColumn);
+      }
 
       fHeader = new AliNanoAODHeader(fNumberOfHeaderParam, fNumberOfHeaderParamInt);
       fHeader->SetName("header"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
@@ -519,7 +545,11 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
     entries = source.GetNumberOfTracks();
   }
 
-  if(entries<=0) return;
+  if(entries<=0) {
+    // make sure that the columns of the previous event are not written again
+    if(fColumnar) FillColumns();
+    return;
+  }
 
   for(Int_t j=0; j<entries; j++){
     AliVTrack *track = 0x0;
@@ -574,12 +604,44 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   if ( fMCMode > 0 ) {
     FilterMC(source);      
   }
+
+  // Columns are filled last, so that they get the remapped MC labels
+  if ( fColumnar ) {
+    FillColumns();
+  }
   
 
 }
 
 
 
+//_____________________________________________________________________________
+void AliNanoAODReplicator::FillColumns()
+{
+  // Transpose the selected tracks into the output columns
+
+  const Int_t ntracks = fTracks->GetEntriesFast();
+
+  for (Int_t ivar = 0; ivar < fNTracksVariables; ivar++) {
+    AliNanoAODColumn * col = static_cast<AliNanoAODColumn*>(fColumns->UncheckedAt(ivar));
+    col->Clear();
+    col->Reserve(ntracks);
+    for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+      col->Push(static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(itrack))->GetVar(ivar));
+    }
+  }
+
+  fLabelColumn->Clear();
+  fLabelColumn->Reserve(ntracks);
+  fChargeColumn->Clear();
+  fChargeColumn->Reserve(ntracks);
+  for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+    AliNanoAODTrack * track = static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(itrack));
+    fLabelColumn->Push(track->GetLabel());
+    fChargeColumn->Push(track->Charge());
+  }
+}
+
 //-----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
@@ -57,6 +57,7 @@ class AliNanoAODTrack;
 class AliAODTrack;
 class AliNanoAODCustomSetter;
 class AliAODZDC;
+class AliNanoAODIntColumn;
 
 class TH1F;
 
@@ -102,6 +103,10 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   void SetOutputArrayName(TString name) {fOutputArrayName=name;}
 
   void SetVarListHeaderStringVariable(TString var) {fVarListHeader_fTC=var;}
+
+  // Columnar mode: each track variable is written as its own branch (see AliNanoAODColumn), instead of a TClonesArray of AliNanoAODTrack
+  void SetColumnarMode(Bool_t b = kTRUE) {fColumnar=b;}
+  Bool_t GetColumnarMode() const {return fColumnar;}
     
  private:
 
@@ -110,6 +115,7 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   void CreateLabelMap(const AliAODEvent& source);
   Int_t GetNewLabel(Int_t i);
   void FilterMC(const AliAODEvent& source);
+  void FillColumns();
  
 
  private:
@@ -146,13 +152,18 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
 
   TString fInputArrayName; // name of array if tracks are stored in a TObjectArray
   TString fOutputArrayName; // name of the output array, where the NanoAODTracks are stored
+
+  Bool_t fColumnar; // if kTRUE the tracks are written in columnar mode
+  mutable TObjArray* fColumns; //! columns of the track variables, in mapping order (owned by fList)
+  mutable AliNanoAODIntColumn* fLabelColumn; //! column of the track labels
+  mutable AliNanoAODIntColumn* fChargeColumn; //! column of the track charges
  private:
 
 
   AliNanoAODReplicator(const AliNanoAODReplicator&);
   AliNanoAODReplicator& operator=(const AliNanoAODReplicator&);
 
-  ClassDef(AliNanoAODReplicator,4) // Branch replicator for ESD to muon AOD.
+  ClassDef(AliNanoAODReplicator,5) // Branch replicator for ESD to muon AOD.
 };
 
 #endif
@@ -26,6 +26,8 @@
 #include <TMath.h>
 #include <TRandom.h>
 #include <TChain.h>
+#include <TTreeCacheUnzip.h>
+#include <TEnv.h>
 #include <TGrid.h>
 #include <TGridResult.h>
 #include <TSystem.h>
@@ -166,6 +168,8 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fPythiaCrossSection(0.),
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
+  fPrefetchEmbeddedEvents(false),
+  fPrefetchCacheSize(100000000),
   fPrintTimingInfoToLog(false),
   fTimer()
 {
@@ -238,6 +242,8 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fPythiaCrossSection(0.),
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
+  fPrefetchEmbeddedEvents(false),
+  fPrefetchCacheSize(100000000),
   fPrintTimingInfoToLog(false),
   fTimer()
 {
@@ -324,6 +330,8 @@ void AliAnalysisTaskEmcalEmbeddingHelper::RetrieveTaskPropertiesFromYAMLConfig()
   res = fYAMLConfig.GetProperty("randomFileAccess", fRandomFileAccess, false);
   res = fYAMLConfig.GetProperty("createHisto", fCreateHisto, false);
   res = fYAMLConfig.GetProperty("printTimingInfoInLog", fPrintTimingInfoToLog, false);
+  res = fYAMLConfig.GetProperty("prefetchEmbeddedEvents", fPrefetchEmbeddedEvents, false);
+  res = fYAMLConfig.GetProperty("prefetchCacheSize", fPrefetchCacheSize, false);
   // More general embedding helper properties
   res = fYAMLConfig.GetProperty("filePattern", fFilePattern, false);
   res = fYAMLConfig.GetProperty("inputFilename", fInputFilename, false);
@@ -1316,13 +1324,76 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::SetupInputFiles()
     AliErrorStream() << "Number of input files (" << fFilenames.size() << ") is larger than the number of available files (" << fMaxNumberOfFiles << "). Something went wrong when adding some of those files to the TChain!\n";
   }
 
+  // Configure background reading before the first tree is loaded
+  if (fPrefetchEmbeddedEvents) {
+    SetupPrefetching();
+  }
+
   // Setup input event
+  // The first file of the TChain may be opened here, so it needs the prefetching setting as well
+  int parallelUnzip = 0;
+  int asyncPrefetching = EnableAsyncPrefetching(parallelUnzip);
   Bool_t res = InitEvent();
+  RestoreAsyncPrefetching(asyncPrefetching, parallelUnzip);
   if (!res) return kFALSE;
 
   return kTRUE;
 }
 
+/**
+ * Configure the embedded TChain to be read in the background. The TTreeCache is filled by the
+ * asynchronous prefetching thread of TFile and the baskets are decompressed ahead of time by the
+ * parallel unzipping thread of TTreeCacheUnzip, so GetEntry() in GetNextEntry() mostly has to copy
+ * already decompressed buffers. Since the event selection is applied on the full event (and the
+ * vertex distance selection depends on the internal event), the selection itself remains in the
+ * main event loop.
+ *
+ * The asynchronous prefetching and the parallel unzipping are only switched on while the embedded
+ * TChain opens its files (see EnableAsyncPrefetching()). The TTreeCache of each embedded file is
+ * created at that time, so the main input chain and the trees of other tasks are not affected.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::SetupPrefetching()
+{
+  fChain->SetCacheSize(fPrefetchCacheSize);
+  fChain->AddBranchToCache("*", kTRUE);
+
+  AliInfoStream() << "Enabled prefetching of the embedded events with a cache of " << fPrefetchCacheSize << " bytes.\n";
+}
+
+/**
+ * Switch on the asynchronous prefetching of TFile and the parallel unzipping of TTreeCacheUnzip,
+ * which are used by the TTreeCache created when the embedded TChain opens a new file. Both are
+ * process-wide settings, so they must be restored with RestoreAsyncPrefetching() right after the
+ * file has been opened.
+ *
+ * @param[out] parallelUnzip Previous parallel unzipping mode, to be passed to RestoreAsyncPrefetching()
+ * @return Previous value of the asynchronous prefetching setting, to be passed to RestoreAsyncPrefetching()
+ */
+int AliAnalysisTaskEmcalEmbeddingHelper::EnableAsyncPrefetching(int & parallelUnzip) const
+{
+  int previous = gEnv->GetValue("TFile.AsyncPrefetching", 0);
+  parallelUnzip = TTreeCacheUnzip::GetParallelUnzip();
+  if (fPrefetchEmbeddedEvents) {
+    gEnv->SetValue("TFile.AsyncPrefetching", 1);
+    TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+  }
+  return previous;
+}
+
+/**
+ * Restore the asynchronous prefetching and parallel unzipping settings changed by EnableAsyncPrefetching().
+ *
+ * @param[in] previous Asynchronous prefetching value returned by EnableAsyncPrefetching()
+ * @param[in] parallelUnzip Parallel unzipping mode returned by EnableAsyncPrefetching()
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::RestoreAsyncPrefetching(int previous, int parallelUnzip) const
+{
+  if (fPrefetchEmbeddedEvents) {
+    gEnv->SetValue("TFile.AsyncPrefetching", previous);
+    TTreeCacheUnzip::SetParallelUnzip(static_cast<TTreeCacheUnzip::EParUnzipMode>(parallelUnzip));
+  }
+}
+
 /**
  * Check if the file pythia base filename can be found in the folder or archive corresponding where
  * the external event input file is found.
@@ -1433,7 +1504,10 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
   // (it is unaccessible otherwise).
   // Since fUpperEntry is the total number of entries, loading it will retrieve the
   // next tree (in the next file) since entries are indexed starting from 0.
+  int parallelUnzip = 0;
+  int asyncPrefetching = EnableAsyncPrefetching(parallelUnzip);
   fChain->GetEntry(fUpperEntry);
+  RestoreAsyncPrefetching(asyncPrefetching, parallelUnzip);
 
   // Determine tree size and current entry
   // Set the limits of the new tree
@@ -1800,6 +1874,10 @@ std::string AliAnalysisTaskEmcalEmbeddingHelper::toString(bool includeFileList)
   tempSS << "File list filename: \"" << fFileListFilename << "\"\n";
   tempSS << "Tree name: " << fTreeName << "\n";
   tempSS << "Print timing info to log: " << fPrintTimingInfoToLog << "\n";
+  tempSS << "Prefetch embedded events: " << fPrefetchEmbeddedEvents << "\n";
+  if (fPrefetchEmbeddedEvents) {
+    tempSS << "Prefetch cache size: " << fPrefetchCacheSize << "\n";
+  }
   tempSS << "Random event number access: " << fRandomEventNumberAccess << "\n";
   tempSS << "Random file access: " << fRandomFileAccess << "\n";
   tempSS << "Starting file index: " << fFilenameIndex << "\n";
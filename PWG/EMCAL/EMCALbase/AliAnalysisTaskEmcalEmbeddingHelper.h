@@ -152,6 +152,23 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void SetConfigurationPath(const char * path)                    { fConfigurationPath = path; }
   /* @} */
 
+  /**
+   * @{
+   * @name Prefetching of the embedded events
+   *
+   * If enabled, the embedded TChain is read through a TTreeCache which is filled by a background
+   * prefetching thread and decompressed by a parallel unzipping thread, while the main event loop
+   * runs. The asynchronous prefetching of TFile and the parallel unzipping of TTreeCacheUnzip are
+   * only switched on while the embedded files are opened, so other input files are read as before.
+   */
+  bool GetPrefetchEmbeddedEvents()                          const { return fPrefetchEmbeddedEvents; }
+  Long64_t GetPrefetchCacheSize()                           const { return fPrefetchCacheSize; }
+  /// Enable background reading of the embedded events. Must be set before the embedding is setup.
+  void SetPrefetchEmbeddedEvents(bool b = true)                   { fPrefetchEmbeddedEvents = b; }
+  /// Size (in bytes) of the TTreeCache used for the embedded TChain when prefetching is enabled
+  void SetPrefetchCacheSize(Long64_t size)                        { fPrefetchCacheSize = size; }
+  /* @} */
+
   /**
    * @{
    * @name Internal event selection
@@ -299,6 +316,9 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Bool_t          CheckIsEmbeddedEventSelected();
   Bool_t          InitEvent()           ;
   void            InitTree()            ;
+  void            SetupPrefetching()    ;
+  int             EnableAsyncPrefetching(int & parallelUnzip) const;
+  void            RestoreAsyncPrefetching(int previous, int parallelUnzip) const;
   bool            PythiaInfoFromCrossSectionFile(std::string filename);
   // Helper functions
   bool            IsFileAccessible() const;
@@ -368,6 +388,9 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   double                                        fPythiaCrossSectionFromFile; //!<! Average pythia cross section extracted from a xsec file.
   double                                        fPythiaPtHard     ; //!<! Pt hard of the current event (extracted from the pythia header).
   
+  bool                                          fPrefetchEmbeddedEvents; ///< If true, the embedded events are read in the background (see SetPrefetchEmbeddedEvents())
+  Long64_t                                      fPrefetchCacheSize; ///< Size of the TTreeCache of the embedded TChain when prefetching
+
   bool                                          fPrintTimingInfoToLog; ///< Flag to print time to execute InitTree(), for logging purposes
   TStopwatch                                    fTimer            ;    //!<! Timer for the InitTree() function
 
@@ -378,7 +401,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 11);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 12);
   /// \endcond
 };
 #endif
@@ -189,6 +189,7 @@ public:
                                                            SwitchOnRecalibration()           ; }      
   // Time Recalibration  
   void     SetConstantTimeShift(Float_t shift)           { fConstantTimeShift = shift  ; }
+  Float_t  GetConstantTimeShift()                 const { return fConstantTimeShift ; }
 
   void     RecalibrateCellTime(Int_t absId, Int_t bc, Double_t & time,Bool_t isLGon = kFALSE) const;
   
@@ -0,0 +1,240 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <algorithm>
+
+#include <TMath.h>
+#include <TVector2.h>
+#include <TVector3.h>
+
+#include "AliVCluster.h"
+#include "AliVTrack.h"
+
+#include "AliEmcalClusterEtaPhiGrid.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalClusterEtaPhiGrid);
+/// \endcond
+
+/**
+ * Default constructor.
+ */
+AliEmcalClusterEtaPhiGrid::AliEmcalClusterEtaPhiGrid() :
+  TObject(),
+  fCellSize(0),
+  fEtaMin(0),
+  fEtaCellSize(0),
+  fPhiCellSize(0),
+  fNEtaCells(0),
+  fNPhiCells(0),
+  fNClusters(0),
+  fClusterEta(),
+  fClusterPhi(),
+  fClusterCell(),
+  fCellStart(),
+  fCellClusters()
+{
+}
+
+/**
+ * Remove all the clusters (the allocated memory is kept for the next event).
+ * @param[in] cellSize Minimum size of the cells in \f$\eta\f$ and \f$\phi\f$, i.e. the largest distance that will be searched
+ */
+void AliEmcalClusterEtaPhiGrid::Reset(Double_t cellSize)
+{
+  fCellSize = cellSize;
+  fNClusters = 0;
+  fNEtaCells = 0;
+  fNPhiCells = 0;
+}
+
+/**
+ * Add a cluster to the grid. Build() must be called after all the clusters have been added.
+ * @param[in] cluster Cluster to be added
+ * @return Index of the cluster in the grid (clusters are numbered in the order they are added)
+ */
+Int_t AliEmcalClusterEtaPhiGrid::AddCluster(const AliVCluster *cluster)
+{
+  if (fNClusters >= fClusterEta.GetSize()) {
+    Int_t size = TMath::Max(2 * fClusterEta.GetSize(), 64);
+    fClusterEta.Set(size);
+    fClusterPhi.Set(size);
+  }
+
+  Double_t eta = 999;
+  Double_t phi = 999;
+  if (cluster) GetClusterEtaPhi(cluster, eta, phi);
+  fClusterEta[fNClusters] = eta;
+  fClusterPhi[fNClusters] = phi;
+
+  return fNClusters++;
+}
+
+/**
+ * Define the cells from the range of the clusters and sort the clusters in the cells.
+ */
+void AliEmcalClusterEtaPhiGrid::Build()
+{
+  Double_t etaMin = 0;
+  Double_t etaMax = 0;
+  for (Int_t i = 0; i < fNClusters; i++) {
+    if (i == 0 || fClusterEta[i] < etaMin) etaMin = fClusterEta[i];
+    if (i == 0 || fClusterEta[i] > etaMax) etaMax = fClusterEta[i];
+  }
+
+  // cells smaller than the requested size would miss some neighbours,
+  // larger cells only cost more candidates
+  Double_t cellSize = fCellSize > 0 ? fCellSize : TMath::TwoPi() / fgkMaxCells;
+  fEtaMin = etaMin;
+  fEtaCellSize = TMath::Max(cellSize, (etaMax - etaMin) / (fgkMaxCells - 1));
+  fNEtaCells = TMath::Min(Int_t((etaMax - etaMin) / fEtaCellSize) + 1, fgkMaxCells);
+  fNPhiCells = TMath::Max(TMath::Min(Int_t(TMath::TwoPi() / cellSize), fgkMaxCells), 1);
+  fPhiCellSize = TMath::TwoPi() / fNPhiCells;
+
+  // counting sort of the clusters in the cells, keeping them ordered by id within each cell
+  Int_t ncells = fNEtaCells * fNPhiCells;
+  if (fCellStart.GetSize() < ncells + 1) fCellStart.Set(ncells + 1);
+  if (fClusterCell.GetSize() < fNClusters) fClusterCell.Set(fClusterEta.GetSize());
+  if (fCellClusters.GetSize() < fNClusters) fCellClusters.Set(fClusterEta.GetSize());
+
+  Int_t *start = fCellStart.GetArray();
+  std::fill(start, start + ncells + 1, 0);
+  for (Int_t i = 0; i < fNClusters; i++) {
+    Int_t icell = GetEtaCell(fClusterEta[i]) * fNPhiCells + GetPhiCell(fClusterPhi[i]);
+    fClusterCell[i] = icell;
+    start[icell + 1]++;
+  }
+  for (Int_t icell = 0; icell < ncells; icell++) start[icell + 1] += start[icell];
+  for (Int_t i = 0; i < fNClusters; i++) {
+    fCellClusters[start[fClusterCell[i]]++] = i;
+  }
+  for (Int_t icell = ncells; icell > 0; icell--) start[icell] = start[icell - 1];
+  start[0] = 0;
+}
+
+/**
+ * Find the clusters in the 3x3 cells around a position on the EMCal surface.
+ * @param[in] eta \f$\eta\f$ of the position (e.g. AliVTrack::GetTrackEtaOnEMCal())
+ * @param[in] phi \f$\phi\f$ of the position (e.g. AliVTrack::GetTrackPhiOnEMCal())
+ * @param[out] ids Indices of the candidate clusters, in increasing order (the array is enlarged if needed)
+ * @return Number of candidate clusters
+ */
+Int_t AliEmcalClusterEtaPhiGrid::FindCandidates(Double_t eta, Double_t phi, TArrayI &ids) const
+{
+  if (fNClusters == 0 || fNEtaCells == 0) return 0;
+
+  // positions further than one cell from the grid cannot be matched
+  if (!(eta >= fEtaMin - fEtaCellSize && eta <= fEtaMin + (fNEtaCells + 1) * fEtaCellSize)) return 0;
+  if (!(TMath::Abs(phi) < 1e3)) return 0;
+
+  Int_t ieta = TMath::FloorNint((eta - fEtaMin) / fEtaCellSize);
+  Int_t iphi = GetPhiCell(phi);
+  Int_t etaFirst = TMath::Max(ieta - 1, 0);
+  Int_t etaLast  = TMath::Min(ieta + 1, fNEtaCells - 1);
+  Int_t nphi = TMath::Min(fNPhiCells, 3);
+
+  if (ids.GetSize() < fNClusters) ids.Set(fNClusters);
+
+  const Int_t *start = fCellStart.GetArray();
+  Int_t n = 0;
+  for (Int_t je = etaFirst; je <= etaLast; je++) {
+    for (Int_t k = 0; k < nphi; k++) {
+      Int_t jp = (nphi < 3) ? k : iphi - 1 + k;
+      if (jp < 0) jp += fNPhiCells;
+      if (jp >= fNPhiCells) jp -= fNPhiCells;
+      Int_t icell = je * fNPhiCells + jp;
+      for (Int_t j = start[icell]; j < start[icell + 1]; j++) ids[n++] = fCellClusters[j];
+    }
+  }
+
+  // keep the same order as a loop on all the clusters
+  std::sort(ids.GetArray(), ids.GetArray() + n);
+
+  return n;
+}
+
+/**
+ * Calculate the \f$\eta\f$ and \f$\phi\f$ differences between a track and a cluster of the grid.
+ * Same as AliAnalysisTaskEmcal::GetEtaPhiDiff(), without computing again the cluster position.
+ * @param[in] t Track
+ * @param[in] id Index of the cluster in the grid
+ * @param[out] phidiff Difference in \f$\phi\f$
+ * @param[out] etadiff Difference in \f$\eta\f$
+ */
+void AliEmcalClusterEtaPhiGrid::GetEtaPhiDiff(const AliVTrack *t, Int_t id, Double_t &phidiff, Double_t &etadiff) const
+{
+  GetEtaPhiDiff(t, fClusterEta[id], fClusterPhi[id], phidiff, etadiff);
+}
+
+/**
+ * Calculate the position of a cluster on the EMCal surface.
+ * @param[in] cluster Cluster
+ * @param[out] eta \f$\eta\f$ of the cluster
+ * @param[out] phi \f$\phi\f$ of the cluster
+ */
+void AliEmcalClusterEtaPhiGrid::GetClusterEtaPhi(const AliVCluster *cluster, Double_t &eta, Double_t &phi)
+{
+  Float_t pos[3] = {0};
+  cluster->GetPosition(pos);
+  TVector3 cpos(pos);
+  eta = cpos.Eta();
+  phi = cpos.Phi();
+}
+
+/**
+ * Calculate the \f$\eta\f$ and \f$\phi\f$ differences between a track and a cluster position.
+ * @param[in] t Track
+ * @param[in] ceta \f$\eta\f$ of the cluster
+ * @param[in] cphi \f$\phi\f$ of the cluster
+ * @param[out] phidiff Difference in \f$\phi\f$
+ * @param[out] etadiff Difference in \f$\eta\f$
+ */
+void AliEmcalClusterEtaPhiGrid::GetEtaPhiDiff(const AliVTrack *t, Double_t ceta, Double_t cphi, Double_t &phidiff, Double_t &etadiff)
+{
+  phidiff = 999;
+  etadiff = 999;
+
+  if (!t) return;
+
+  Double_t veta = t->GetTrackEtaOnEMCal();
+  Double_t vphi = t->GetTrackPhiOnEMCal();
+
+  etadiff = veta - ceta;
+  phidiff = TVector2::Phi_mpi_pi(vphi - cphi);
+}
+
+/**
+ * @param[in] eta \f$\eta\f$ of a cluster
+ * @return Index of the cell in \f$\eta\f$
+ */
+Int_t AliEmcalClusterEtaPhiGrid::GetEtaCell(Double_t eta) const
+{
+  Int_t ieta = TMath::FloorNint((eta - fEtaMin) / fEtaCellSize);
+  if (ieta < 0) ieta = 0;
+  if (ieta >= fNEtaCells) ieta = fNEtaCells - 1;
+  return ieta;
+}
+
+/**
+ * @param[in] phi Azimuthal angle, in any range
+ * @return Index of the cell in \f$\phi\f$
+ */
+Int_t AliEmcalClusterEtaPhiGrid::GetPhiCell(Double_t phi) const
+{
+  phi = TMath::IsNaN(phi) ? 0 : TVector2::Phi_0_2pi(phi);
+  Int_t iphi = TMath::FloorNint(phi / fPhiCellSize);
+  if (iphi < 0) iphi = 0;
+  if (iphi >= fNPhiCells) iphi = fNPhiCells - 1;
+  return iphi;
+}
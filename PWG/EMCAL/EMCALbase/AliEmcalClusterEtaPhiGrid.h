@@ -0,0 +1,78 @@
+#ifndef ALIEMCALCLUSTERETAPHIGRID_H
+#define ALIEMCALCLUSTERETAPHIGRID_H
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/**
+ * \class AliEmcalClusterEtaPhiGrid
+ * \brief Index of the clusters of an event in a grid of their \f$\eta\f$/\f$\phi\f$ position on the EMCal surface
+ *
+ * Used to find the clusters close to a track without testing all the clusters of the event.
+ * The grid is filled once per event:
+ * ~~~{.cxx}
+ * fClusterGrid.Reset(fMaxDistance);
+ * for (Int_t icluster = 0; icluster < nclusters; icluster++) fClusterGrid.AddCluster(cluster);
+ * fClusterGrid.Build();
+ * ~~~
+ * and then, for each track, FindCandidates() returns the clusters in the 3x3 cells around the
+ * track position. Since the cells are at least as large as the cell size given in Reset(),
+ * all the clusters with a distance up to that size from the track are among the candidates.
+ * The position of each cluster is computed only once and can be accessed with GetClusterEta()
+ * and GetClusterPhi(), with the same convention as AliAnalysisTaskEmcal::GetEtaPhiDiff().
+ *
+ * \ingroup EMCALCOREFW
+ */
+
+#include <TObject.h>
+#include <TArrayD.h>
+#include <TArrayI.h>
+
+class AliVCluster;
+class AliVTrack;
+
+class AliEmcalClusterEtaPhiGrid : public TObject {
+ public:
+  AliEmcalClusterEtaPhiGrid();
+  virtual ~AliEmcalClusterEtaPhiGrid() {}
+
+  void          Reset(Double_t cellSize);
+  Int_t         AddCluster(const AliVCluster *cluster);
+  void          Build();
+  Int_t         FindCandidates(Double_t eta, Double_t phi, TArrayI &ids) const;
+
+  Int_t         GetNClusters()             const { return fNClusters          ; }
+  Double_t      GetClusterEta(Int_t id)    const { return fClusterEta[id]     ; }
+  Double_t      GetClusterPhi(Int_t id)    const { return fClusterPhi[id]     ; }
+  void          GetEtaPhiDiff(const AliVTrack *t, Int_t id, Double_t &phidiff, Double_t &etadiff) const;
+
+  static void   GetClusterEtaPhi(const AliVCluster *cluster, Double_t &eta, Double_t &phi);
+  static void   GetEtaPhiDiff(const AliVTrack *t, Double_t ceta, Double_t cphi, Double_t &phidiff, Double_t &etadiff);
+
+ protected:
+  Int_t         GetEtaCell(Double_t eta)   const;
+  Int_t         GetPhiCell(Double_t phi)   const;
+
+  static const Int_t fgkMaxCells = 720;   //!<! maximum number of cells along eta and along phi
+
+  Double_t      fCellSize;                //!<! requested cell size
+  Double_t      fEtaMin;                  //!<! lower edge of the grid in eta
+  Double_t      fEtaCellSize;             //!<! size of the cells in eta
+  Double_t      fPhiCellSize;             //!<! size of the cells in phi
+  Int_t         fNEtaCells;               //!<! number of cells in eta
+  Int_t         fNPhiCells;               //!<! number of cells in phi (covering the full azimuth)
+  Int_t         fNClusters;               //!<! number of clusters added
+  TArrayD       fClusterEta;              //!<! eta of the clusters on the EMCal surface
+  TArrayD       fClusterPhi;              //!<! phi of the clusters on the EMCal surface
+  TArrayI       fClusterCell;             //!<! cell of each cluster
+  TArrayI       fCellStart;               //!<! index of the first cluster of each cell in fCellClusters
+  TArrayI       fCellClusters;            //!<! clusters ordered by cell (and by id within a cell)
+
+ private:
+  AliEmcalClusterEtaPhiGrid(const AliEmcalClusterEtaPhiGrid&);            // not implemented
+  AliEmcalClusterEtaPhiGrid &operator=(const AliEmcalClusterEtaPhiGrid&); // not implemented
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalClusterEtaPhiGrid, 1); // Eta-phi index of EMCal clusters
+  /// \endcond
+};
+#endif
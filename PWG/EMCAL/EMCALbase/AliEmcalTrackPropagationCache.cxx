@@ -0,0 +1,202 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <TMath.h>
+#include <TTree.h>
+
+#include "AliAnalysisManager.h"
+#include "AliEMCALRecoUtils.h"
+#include "AliLog.h"
+#include "AliVEvent.h"
+#include "AliVTrack.h"
+
+#include "AliEmcalTrackPropagationCache.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalTrackPropagationCache);
+/// \endcond
+
+/**
+ * Default constructor, for ROOT I/O purposes.
+ */
+AliEmcalTrackPropagationCache::AliEmcalTrackPropagationCache() :
+  TNamed(),
+  fEvent(0),
+  fEntry(-1),
+  fTreeNumber(-1),
+  fNRequests(0),
+  fNPropagations(0),
+  fFirstEntry(),
+  fUsedSlots(),
+  fNUsedSlots(0),
+  fEntries()
+{
+}
+
+/**
+ * Standard constructor.
+ * @param[in] name Name of the cache, used to find it in the event
+ */
+AliEmcalTrackPropagationCache::AliEmcalTrackPropagationCache(const char *name) :
+  TNamed(name, name),
+  fEvent(0),
+  fEntry(-1),
+  fTreeNumber(-1),
+  fNRequests(0),
+  fNPropagations(0),
+  fFirstEntry(),
+  fUsedSlots(),
+  fNUsedSlots(0),
+  fEntries()
+{
+}
+
+/**
+ * Get the cache attached to the event, creating it if needed.
+ * The cache is emptied if the event changed since the last call.
+ * @param[in] event Input event
+ * @return Pointer to the cache, 0 if the event is not available
+ */
+AliEmcalTrackPropagationCache *AliEmcalTrackPropagationCache::GetCache(AliVEvent *event)
+{
+  if (!event) return 0;
+
+  AliEmcalTrackPropagationCache *cache = dynamic_cast<AliEmcalTrackPropagationCache*>(event->FindListObject(GetDefaultName()));
+  if (!cache) {
+    cache = new AliEmcalTrackPropagationCache(GetDefaultName());
+    event->AddObject(cache);
+  }
+  cache->CheckEvent(event);
+
+  return cache;
+}
+
+/**
+ * Empty the cache if the event is not the same as the one the cache was filled with.
+ * The event is identified by the entry being processed by the analysis manager and by the
+ * number of the tree in the input chain (the header of the event may not be loaded yet when
+ * the cache is requested). The entry is the one in the current tree, and the event object is
+ * reused from one event to the next, so the entry alone does not tell a new file apart.
+ * @param[in] event Input event
+ */
+void AliEmcalTrackPropagationCache::CheckEvent(AliVEvent *event)
+{
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+  TTree *tree = mgr ? mgr->GetTree() : 0;
+  Int_t treeNumber = tree ? tree->GetTreeNumber() : -1;
+
+  if (event == fEvent && entry == fEntry && treeNumber == fTreeNumber && entry >= 0 && tree) return;
+
+  Clear();
+
+  fEvent = event;
+  fEntry = entry;
+  fTreeNumber = treeNumber;
+}
+
+/**
+ * Remove all the entries (the allocated memory is kept for the next event).
+ */
+void AliEmcalTrackPropagationCache::Clear(Option_t * /*opt*/)
+{
+  if (fNRequests > 0) {
+    AliDebug(2, Form("%d extrapolations requested, %d done", fNRequests, fNPropagations));
+  }
+
+  for (Int_t i = 0; i < fNUsedSlots; i++) fFirstEntry[fUsedSlots[i]] = -1;
+  fNUsedSlots = 0;
+  fEntries.clear();
+  fEvent = 0;
+  fEntry = -1;
+  fTreeNumber = -1;
+  fNRequests = 0;
+  fNPropagations = 0;
+}
+
+/**
+ * Extrapolate the track to the EMCal surface, see AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface().
+ * If the same track was already extrapolated in this event with the same arguments, the
+ * result is taken from the cache.
+ * @return kTRUE if the extrapolation succeeded
+ */
+Bool_t AliEmcalTrackPropagationCache::ExtrapolateTrackToEMCalSurface(AliVTrack *track, Double_t emcalR, Double_t mass, Double_t step,
+                                                                     Double_t minpT, Bool_t useMassForTracking, Bool_t useDCA,
+                                                                     Bool_t useOuterParam)
+{
+  if (!track) return kFALSE;
+
+  fNRequests++;
+
+  Int_t slot = GetSlot(track->GetID());
+  if (slot < 0 || slot >= fgkMaxSlots) {
+    fNPropagations++;
+    return AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, emcalR, mass, step, minpT, useMassForTracking, useDCA, useOuterParam);
+  }
+
+  Double_t p[3] = {track->Px(), track->Py(), track->Pz()};
+  Double_t x[3] = {0};
+  track->GetXYZ(x);
+  Short_t charge = track->Charge();
+  UInt_t flags = (useMassForTracking ? 1 : 0) | (useDCA ? 2 : 0) | (useOuterParam ? 4 : 0);
+
+  // look for the same request in the cache
+  Int_t ientry = slot < fFirstEntry.GetSize() ? fFirstEntry[slot] : -1;
+  while (ientry >= 0) {
+    const Entry &e = fEntries[ientry];
+    if (e.fCharge == charge && e.fFlags == flags &&
+        e.fEmcalR == emcalR && e.fMass == mass && e.fStep == step && e.fMinPt == minpT &&
+        e.fP[0] == p[0] && e.fP[1] == p[1] && e.fP[2] == p[2] &&
+        e.fX[0] == x[0] && e.fX[1] == x[1] && e.fX[2] == x[2]) {
+      track->SetTrackPhiEtaPtOnEMCal(e.fPhi, e.fEta, e.fPt);
+      return e.fResult;
+    }
+    ientry = e.fNext;
+  }
+
+  // not found: propagate and store the result
+  fNPropagations++;
+  Bool_t result = AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, emcalR, mass, step, minpT, useMassForTracking, useDCA, useOuterParam);
+
+  if (slot >= fFirstEntry.GetSize()) {
+    Int_t size = fFirstEntry.GetSize();
+    fFirstEntry.Set(TMath::Max(2 * size, slot + 1));
+    for (Int_t i = size; i < fFirstEntry.GetSize(); i++) fFirstEntry[i] = -1;
+  }
+  if (fFirstEntry[slot] < 0) {
+    if (fNUsedSlots >= fUsedSlots.GetSize()) fUsedSlots.Set(TMath::Max(2 * fUsedSlots.GetSize(), 64));
+    fUsedSlots[fNUsedSlots++] = slot;
+  }
+
+  Entry e;
+  e.fNext = fFirstEntry[slot];
+  e.fCharge = charge;
+  for (Int_t i = 0; i < 3; i++) {
+    e.fP[i] = p[i];
+    e.fX[i] = x[i];
+  }
+  e.fEmcalR = emcalR;
+  e.fMass = mass;
+  e.fStep = step;
+  e.fMinPt = minpT;
+  e.fFlags = flags;
+  e.fResult = result;
+  e.fEta = track->GetTrackEtaOnEMCal();
+  e.fPhi = track->GetTrackPhiOnEMCal();
+  e.fPt = track->GetTrackPtOnEMCal();
+  fFirstEntry[slot] = fEntries.size();
+  fEntries.push_back(e);
+
+  return result;
+}
@@ -0,0 +1,98 @@
+#ifndef ALIEMCALTRACKPROPAGATIONCACHE_H
+#define ALIEMCALTRACKPROPAGATIONCACHE_H
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/**
+ * \class AliEmcalTrackPropagationCache
+ * \brief Per-event cache of the track extrapolations to the EMCal surface
+ *
+ * Several EMCal tasks in the same train propagate the same tracks to the EMCal surface
+ * with the same settings (e.g. the track filter, the track propagator and the cluster-track matcher).
+ * The cache is attached to the input event (see GetCache()) and is shared by all the tasks:
+ * ~~~{.cxx}
+ * AliEmcalTrackPropagationCache *cache = AliEmcalTrackPropagationCache::GetCache(InputEvent());
+ * cache->ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA, fUseOuterParam);
+ * ~~~
+ * ExtrapolateTrackToEMCalSurface() has the same arguments and the same effect on the track as
+ * AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(). The propagation is done only the first time
+ * a track is requested with a given set of arguments: the following requests (for the same track
+ * or for a copy of it) take the result from the cache. The tracks are identified by their ID,
+ * charge, momentum and position, so that copies of a track with different parameters
+ * (e.g. constrained to the vertex) are propagated separately.
+ * The cache is emptied automatically when a new event is processed.
+ *
+ * \ingroup EMCALCOREFW
+ */
+
+#include <vector>
+
+#include <TNamed.h>
+#include <TArrayI.h>
+
+class AliVEvent;
+class AliVTrack;
+
+class AliEmcalTrackPropagationCache : public TNamed {
+ public:
+  AliEmcalTrackPropagationCache();
+  AliEmcalTrackPropagationCache(const char *name);
+  virtual ~AliEmcalTrackPropagationCache() {}
+
+  static AliEmcalTrackPropagationCache *GetCache(AliVEvent *event);
+
+  Bool_t        ExtrapolateTrackToEMCalSurface(AliVTrack *track, Double_t emcalR = 440, Double_t mass = 0.1396, Double_t step = 20,
+                                               Double_t minpT = 0.35, Bool_t useMassForTracking = kFALSE, Bool_t useDCA = kFALSE,
+                                               Bool_t useOuterParam = kFALSE);
+  void          Clear(Option_t *opt = "");
+
+  Int_t         GetNPropagations()   const { return fNPropagations ; }
+  Int_t         GetNRequests()       const { return fNRequests     ; }
+
+  static const char *GetDefaultName()      { return "EmcalTrackPropagationCache"; }
+
+ protected:
+  /**
+   * \struct Entry
+   * \brief Arguments and result of one track extrapolation
+   */
+  struct Entry {
+    Int_t       fNext;        ///< next entry with the same track ID, -1 if none
+    Short_t     fCharge;      ///< charge of the track
+    Double_t    fP[3];        ///< momentum of the track
+    Double_t    fX[3];        ///< position of the track
+    Double_t    fEmcalR;      ///< distance of the EMCal surface
+    Double_t    fMass;        ///< mass hypothesis
+    Double_t    fStep;        ///< propagation step
+    Double_t    fMinPt;       ///< minimum pt to propagate
+    UInt_t      fFlags;       ///< useMassForTracking, useDCA, useOuterParam
+    Bool_t      fResult;      ///< return value of the extrapolation
+    Double_t    fEta;         ///< eta on the EMCal surface
+    Double_t    fPhi;         ///< phi on the EMCal surface
+    Double_t    fPt;          ///< pt on the EMCal surface
+  };
+
+  void          CheckEvent(AliVEvent *event);
+  Int_t         GetSlot(Int_t id) const { return id >= 0 ? 2 * id : -2 * id - 1; }
+
+  static const Int_t fgkMaxSlots = 1 << 22;   //!<! tracks with a larger ID are not cached
+
+  AliVEvent          *fEvent;           //!<! event the cache refers to
+  Long64_t            fEntry;           //!<! entry of the event in the current tree of the analysis manager
+  Int_t               fTreeNumber;      //!<! number of the current tree in the input chain
+  Int_t               fNRequests;       //!<! number of extrapolations requested in this event
+  Int_t               fNPropagations;   //!<! number of extrapolations done in this event
+  TArrayI             fFirstEntry;      //!<! first entry for each track ID (see GetSlot())
+  TArrayI             fUsedSlots;       //!<! slots of fFirstEntry used in this event
+  Int_t               fNUsedSlots;      //!<! number of slots used in this event
+  std::vector<Entry>  fEntries;         //!<! table of the extrapolations done in this event
+
+ private:
+  AliEmcalTrackPropagationCache(const AliEmcalTrackPropagationCache&);            // not implemented
+  AliEmcalTrackPropagationCache &operator=(const AliEmcalTrackPropagationCache&); // not implemented
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalTrackPropagationCache, 1); // Per-event cache of the track extrapolations to the EMCal surface
+  /// \endcond
+};
+#endif
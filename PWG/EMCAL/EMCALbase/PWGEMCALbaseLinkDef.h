@@ -11,12 +11,14 @@
 #pragma link C++ class AliAnalysisTaskEmcalEmbeddingHelper+;
 #pragma link C++ class AliEmcalEmbeddingQA+;
 #pragma link C++ class AliClusterContainer+;
+#pragma link C++ class AliEmcalClusterEtaPhiGrid+;
 #pragma link C++ class AliEmcalContainer+;
 #pragma link C++ class AliEmcalContainerUtils+;
 #pragma link C++ class AliEmcalParticle+;
 #pragma link C++ class AliEmcalPhysicsSelection+;
 #pragma link C++ class AliEmcalPythiaInfo+;
 #pragma link C++ class AliEmcalManagedObject+;
+#pragma link C++ class AliEmcalTrackPropagationCache+;
 #pragma link C++ class AliEmcalTrackSelection+;
 #pragma link C++ class AliEmcalTrackSelectionESD+;
 #pragma link C++ class AliEmcalTrackSelectionAOD+;
@@ -11,6 +11,7 @@
 #include <AliAnalysisManager.h>
 #include <AliEMCALRecoUtils.h>
 #include <AliLog.h>
+#include "AliEmcalTrackPropagationCache.h"
 
 ClassImp(AliEmcalAodTrackFilterTask)
 
@@ -108,6 +109,9 @@ void AliEmcalAodTrackFilterTask::UserExec(Option_t *)
     InputEvent()->AddObject(fTracksOut);
   }
 
+  // the propagations are shared with the other tasks propagating the same tracks in this event
+  AliEmcalTrackPropagationCache *propagationCache = AliEmcalTrackPropagationCache::GetCache(InputEvent());
+
   // loop over tracks
   const Int_t Ntracks = fTracksIn->GetEntriesFast();
   for (Int_t iTracks = 0, nacc = 0; iTracks < Ntracks; ++iTracks) {
@@ -168,7 +172,7 @@ void AliEmcalAodTrackFilterTask::UserExec(Option_t *)
         propthistrack = kTRUE;
     }
     if (propthistrack)
-      AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(newt,fDist);
+      propagationCache->ExtrapolateTrackToEMCalSurface(newt,fDist);
 
     Int_t label = 0;
     if (fIsMC) {
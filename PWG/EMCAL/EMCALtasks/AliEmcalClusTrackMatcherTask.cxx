@@ -16,6 +16,7 @@
 #include <AliEMCALRecoUtils.h>
 
 #include "AliEmcalParticle.h"
+#include "AliEmcalTrackPropagationCache.h"
 #include "AliParticleContainer.h"
 #include "AliClusterContainer.h"
 
@@ -36,6 +37,8 @@ AliEmcalClusTrackMatcherTask::AliEmcalClusTrackMatcherTask() :
   fEmcalClusters(0),
   fNEmcalTracks(0),
   fNEmcalClusters(0),
+  fClusterGrid(),
+  fClusterCandidates(),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0)
 {
@@ -66,6 +69,8 @@ AliEmcalClusTrackMatcherTask::AliEmcalClusTrackMatcherTask(const char *name, Boo
   fEmcalClusters(0),
   fNEmcalTracks(0),
   fNEmcalClusters(0),
+  fClusterGrid(),
+  fClusterCandidates(),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0)
 {
@@ -241,6 +246,9 @@ void AliEmcalClusTrackMatcherTask::GenerateEmcalParticles()
     fNEmcalClusters++;
   }
 
+  // the propagations are shared with the other tasks propagating the same tracks in this event
+  AliEmcalTrackPropagationCache *propagationCache = AliEmcalTrackPropagationCache::GetCache(InputEvent());
+
   tracks->ResetCurrentID();
   while ((track = static_cast<AliVTrack*>(tracks->GetNextAcceptParticle()))) {
 
@@ -261,7 +269,7 @@ void AliEmcalClusTrackMatcherTask::GenerateEmcalParticles()
         propthistrack = kTRUE;
       }
     }
-    if (propthistrack) AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fPropDist);
+    if (propthistrack) propagationCache->ExtrapolateTrackToEMCalSurface(track, fPropDist);
 
     // Create AliEmcalParticle objects to handle the matching
     AliEmcalParticle* emcalTrack = new ((*fEmcalTracks)[fNEmcalTracks]) AliEmcalParticle(track, tracks->GetCurrentID());
@@ -283,17 +291,30 @@ void AliEmcalClusTrackMatcherTask::DoMatching()
 
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  // index the clusters in eta/phi, so that each track is only compared
+  // with the clusters in the neighbouring cells
+  fClusterGrid.Reset(fMaxDistance);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+    fClusterGrid.AddCluster(emcalCluster->GetCluster());
+  }
+  fClusterGrid.Build();
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
+    if (!track) continue;
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    Int_t ncandidates = fClusterGrid.FindCandidates(track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), fClusterCandidates);
+    for (Int_t icandidate = 0; icandidate < ncandidates; icandidate++) {
+      Int_t icluster = fClusterCandidates[icandidate];
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
+      if (!cluster) continue;
 
       Double_t deta = 999;
       Double_t dphi = 999;
-      GetEtaPhiDiff(track, cluster, dphi, deta);
+      fClusterGrid.GetEtaPhiDiff(track, icluster, dphi, deta);
       Double_t d2 = deta * deta + dphi * dphi;
       if (d2 > maxd2) continue;
 
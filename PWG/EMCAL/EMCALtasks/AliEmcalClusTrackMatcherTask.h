@@ -1,7 +1,10 @@
 #ifndef ALIEMCALCLUSTRACKMATCHERTASK_H
 #define ALIEMCALCLUSTRACKMATCHERTASK_H
 
+#include <TArrayI.h>
+
 #include "AliAnalysisTaskEmcal.h"
+#include "AliEmcalClusterEtaPhiGrid.h"
 
 class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
  public:
@@ -42,6 +45,8 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   TClonesArray *fEmcalClusters;         //!emcal clusters
   Int_t         fNEmcalTracks;          //!number of emcal tracks
   Int_t         fNEmcalClusters;        //!number of emcal clusters
+  AliEmcalClusterEtaPhiGrid fClusterGrid; //!eta-phi index of the emcal clusters
+  TArrayI       fClusterCandidates;     //!clusters close to the current track
   TH1          *fHistMatchEtaAll;       //!deta distribution
   TH1          *fHistMatchPhiAll;       //!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!deta distribution
@@ -51,6 +56,6 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   AliEmcalClusTrackMatcherTask(const AliEmcalClusTrackMatcherTask&);            // not implemented
   AliEmcalClusTrackMatcherTask &operator=(const AliEmcalClusTrackMatcherTask&); // not implemented
 
-  ClassDef(AliEmcalClusTrackMatcherTask, 8) // Cluster-Track matching task
+  ClassDef(AliEmcalClusTrackMatcherTask, 9) // Cluster-Track matching task
 };
 #endif
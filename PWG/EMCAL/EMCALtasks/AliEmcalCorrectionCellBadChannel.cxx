@@ -88,6 +88,29 @@ void AliEmcalCorrectionCellBadChannel::UserCreateOutputObjects()
  * Called for each event to process the event data.
  */
 Bool_t AliEmcalCorrectionCellBadChannel::Run()
+{
+  if (!BeginCellKernel())
+    return kFALSE;
+
+  if(fCreateHisto)
+    FillCellQA(fCellEnergyDistBefore); // "before" QA
+  
+  // CELL RECALIBRATION -------------------------------------------------------
+  // update cell objects
+  UpdateCells();
+  
+  if(fCreateHisto)
+    FillCellQA(fCellEnergyDistAfter); // "after" QA
+
+  return kTRUE;
+}
+
+/**
+ * Prepare the event for the bad channel removal. Called by Run(), or by the correction task
+ * when the cells are corrected by several components in a single loop.
+ * @return False if the cells should not be corrected in this event
+ */
+Bool_t AliEmcalCorrectionCellBadChannel::BeginCellKernel()
 {
   AliEmcalCorrectionComponent::Run();
   
@@ -113,17 +136,21 @@ Bool_t AliEmcalCorrectionCellBadChannel::Run()
   // mark the cells not recalibrated
   fRecoUtils->ResetCellsCalibrated();
 
+  return kTRUE;
+}
+
+/**
+ * Remove one cell if it is bad, filling the QA histograms as in Run().
+ */
+void AliEmcalCorrectionCellBadChannel::ApplyCellKernel(Short_t absId, Float_t &amp, Double_t &time, Bool_t highGain)
+{
   if(fCreateHisto)
-    FillCellQA(fCellEnergyDistBefore); // "before" QA
-  
-  // CELL RECALIBRATION -------------------------------------------------------
-  // update cell objects
-  UpdateCells();
-  
-  if(fCreateHisto)
-    FillCellQA(fCellEnergyDistAfter); // "after" QA
+    fCellEnergyDistBefore->Fill(amp); // "before" QA
 
-  return kTRUE;
+  RecalibrateCell(absId, amp, time, highGain);
+
+  if(fCreateHisto)
+    fCellEnergyDistAfter->Fill(amp); // "after" QA
 }
 
 /**
@@ -84,6 +84,31 @@ void AliEmcalCorrectionCellEnergy::UserCreateOutputObjects()
  * Called for each event to process the event data.
  */
 Bool_t AliEmcalCorrectionCellEnergy::Run()
+{
+  if (!BeginCellKernel())
+    return kFALSE;
+  
+  if(fCreateHisto)
+    FillCellQA(fCellEnergyDistBefore); // "before" QA
+  
+  // CELL RECALIBRATION -------------------------------------------------------
+  // update cell objects
+  UpdateCells();
+  
+  if(fCreateHisto)
+    FillCellQA(fCellEnergyDistAfter); // "after" QA
+  
+  EndCellKernel();
+
+  return kTRUE;
+}
+
+/**
+ * Prepare the event for the energy recalibration. Called by Run(), or by the correction task
+ * when the cells are corrected by several components in a single loop.
+ * @return False if the cells should not be corrected in this event
+ */
+Bool_t AliEmcalCorrectionCellEnergy::BeginCellKernel()
 {
   AliEmcalCorrectionComponent::Run();
   
@@ -107,24 +132,33 @@ Bool_t AliEmcalCorrectionCellEnergy::Run()
   
   // mark the cells not recalibrated
   fRecoUtils->ResetCellsCalibrated();
-  
-  
+
+  return kTRUE;
+}
+
+/**
+ * Recalibrate the energy of one cell, filling the QA histograms as in Run().
+ */
+void AliEmcalCorrectionCellEnergy::ApplyCellKernel(Short_t absId, Float_t &amp, Double_t &time, Bool_t highGain)
+{
   if(fCreateHisto)
-    FillCellQA(fCellEnergyDistBefore); // "before" QA
-  
-  // CELL RECALIBRATION -------------------------------------------------------
-  // update cell objects
-  UpdateCells();
-  
+    fCellEnergyDistBefore->Fill(amp); // "before" QA
+
+  RecalibrateCell(absId, amp, time, highGain);
+
   if(fCreateHisto)
-    FillCellQA(fCellEnergyDistAfter); // "after" QA
-  
+    fCellEnergyDistAfter->Fill(amp); // "after" QA
+}
+
+/**
+ * Called after the cells of the event have been recalibrated.
+ */
+void AliEmcalCorrectionCellEnergy::EndCellKernel()
+{
   // switch off recalibrations so those are not done multiple times
   // this is just for safety, the recalibrated flag of cell object
   // should not allow for farther processing anyways
   fRecoUtils->SwitchOffRecalibration();
-
-  return kTRUE;
 }
 
 /**
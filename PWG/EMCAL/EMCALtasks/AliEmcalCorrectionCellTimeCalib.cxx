@@ -80,6 +80,29 @@ void AliEmcalCorrectionCellTimeCalib::UserCreateOutputObjects()
  * Called for each event to process the event data.
  */
 Bool_t AliEmcalCorrectionCellTimeCalib::Run()
+{
+  if (!BeginCellKernel())
+    return kFALSE;
+  
+  if(fCreateHisto)
+    FillCellQA(fCellTimeDistBefore); // "before" QA
+  
+  // CELL RECALIBRATION -------------------------------------------------------
+  // cell objects will be updated
+  UpdateCells();
+  
+  if(fCreateHisto)
+    FillCellQA(fCellTimeDistAfter); // "after" QA
+  
+  return kTRUE;
+}
+
+/**
+ * Prepare the event for the time calibration. Called by Run(), or by the correction task
+ * when the cells are corrected by several components in a single loop.
+ * @return False if the cells should not be corrected in this event
+ */
+Bool_t AliEmcalCorrectionCellTimeCalib::BeginCellKernel()
 {
   AliEmcalCorrectionComponent::Run();
   
@@ -115,17 +138,21 @@ Bool_t AliEmcalCorrectionCellTimeCalib::Run()
   // mark the cells not recalibrated
   fRecoUtils->ResetCellsCalibrated();
   
+  return kTRUE;
+}
+
+/**
+ * Calibrate the time of one cell, filling the QA histograms as in Run().
+ */
+void AliEmcalCorrectionCellTimeCalib::ApplyCellKernel(Short_t absId, Float_t &amp, Double_t &time, Bool_t highGain)
+{
   if(fCreateHisto)
-    FillCellQA(fCellTimeDistBefore); // "before" QA
-  
-  // CELL RECALIBRATION -------------------------------------------------------
-  // cell objects will be updated
-  UpdateCells();
-  
+    fCellTimeDistBefore->Fill(time); // "before" QA
+
+  RecalibrateCell(absId, amp, time, highGain);
+
   if(fCreateHisto)
-    FillCellQA(fCellTimeDistAfter); // "after" QA
-  
-  return kTRUE;
+    fCellTimeDistAfter->Fill(time); // "after" QA
 }
 
 /**
@@ -31,6 +31,9 @@ class AliEmcalCorrectionCellTimeCalib : public AliEmcalCorrectionComponent {
   Bool_t Initialize();
   void UserCreateOutputObjects();
   Bool_t Run();
+  Bool_t HasCellKernel() const { return kTRUE; }
+  Bool_t BeginCellKernel();
+  void ApplyCellKernel(Short_t absId, Float_t &amp, Double_t &time, Bool_t highGain);
   Bool_t CheckIfRunChanged();
   
 protected:
@@ -13,6 +13,7 @@
 #include "AliAODCaloCluster.h"
 #include "AliVParticle.h"
 #include "AliEmcalParticle.h"
+#include "AliEmcalTrackPropagationCache.h"
 #include "AliEMCALGeometry.h"
 #include "AliMCEvent.h"
 
@@ -44,6 +45,8 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fEmcalClusters(0),
   fNEmcalTracks(0),
   fNEmcalClusters(0),
+  fClusterGrid(),
+  fClusterCandidates(),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0),
   fNMCGenerToAccept(0),
@@ -292,6 +295,9 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
     mass = 0.1396;
   }
 
+  // the propagations are shared with the other tasks propagating the same tracks in this event
+  AliEmcalTrackPropagationCache *propagationCache = AliEmcalTrackPropagationCache::GetCache(fEventManager.InputEvent());
+
   AliParticleContainer * partCont = 0;
   TIter nextPartCont(&fParticleCollArray);
   while ((partCont = static_cast<AliParticleContainer*>(nextPartCont()))) {
@@ -335,7 +341,12 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
         }
         
         // Propagate the track
-        AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA, fUseOuterParamInESDs);
+        if (propagationCache) {
+          propagationCache->ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA, fUseOuterParamInESDs);
+        }
+        else {
+          AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA, fUseOuterParamInESDs);
+        }
       }
 
       // Reset properties of the track to fix TRefArray errors which occur when AddTrackMatched(obj) is called.
@@ -370,17 +381,30 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  // index the clusters in eta/phi, so that each track is only compared
+  // with the clusters in the neighbouring cells
+  fClusterGrid.Reset(fMaxDistance);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+    fClusterGrid.AddCluster(emcalCluster->GetCluster());
+  }
+  fClusterGrid.Build();
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
+    if (!track) continue;
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    Int_t ncandidates = fClusterGrid.FindCandidates(track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), fClusterCandidates);
+    for (Int_t icandidate = 0; icandidate < ncandidates; icandidate++) {
+      Int_t icluster = fClusterCandidates[icandidate];
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
+      if (!cluster) continue;
       
       Double_t deta = 999;
       Double_t dphi = 999;
-      GetEtaPhiDiff(track, cluster, dphi, deta);
+      fClusterGrid.GetEtaPhiDiff(track, icluster, dphi, deta);
       Double_t d2 = deta * deta + dphi * dphi;
 
       if (d2 > maxd2) continue;
@@ -51,8 +51,13 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent() :
   fRecoUtils(0),
   fOutput(0),
   fBasePath(""),
-  fCustomBadChannelFilePath("")
-
+  fCustomBadChannelFilePath(""),
+  fCellCalibration(),
+  fCellL1Phase(),
+  fCellCalibrationRun(-1),
+  fCellCalibrationSwitches(0),
+  fCellTimeShift(0),
+  fCellBunchCrossing(-1)
 {
   fVertex[0] = 0;
   fVertex[1] = 0;
@@ -86,7 +91,13 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent(const char * name) :
   fRecoUtils(0),
   fOutput(0),
   fBasePath(""),
-  fCustomBadChannelFilePath("")
+  fCustomBadChannelFilePath(""),
+  fCellCalibration(),
+  fCellL1Phase(),
+  fCellCalibrationRun(-1),
+  fCellCalibrationSwitches(0),
+  fCellTimeShift(0),
+  fCellBunchCrossing(-1)
 {
   fVertex[0] = 0;
   fVertex[1] = 0;
@@ -212,6 +223,138 @@ void AliEmcalCorrectionComponent::UpdateCells()
   fCaloCells->Sort();
 }
 
+/**
+ * Apply the correction of the component to one cell. Used by AliEmcalCorrectionTask to run consecutive
+ * cell corrections in a single loop on the cells: it is called for each cell after BeginCellKernel()
+ * and PrepareCellKernel(), and must have the same effect on the cell as the loop on the cells done in Run().
+ * By default the cell is recalibrated with RecalibrateCell().
+ *
+ * @param[in] absId Absolute ID of the cell
+ * @param[in,out] amp Energy of the cell
+ * @param[in,out] time Time of the cell
+ * @param[in] highGain True if the cell is high gain
+ */
+void AliEmcalCorrectionComponent::ApplyCellKernel(Short_t absId, Float_t &amp, Double_t &time, Bool_t highGain)
+{
+  RecalibrateCell(absId, amp, time, highGain);
+}
+
+/**
+ * Fill the per-cell calibration used by RecalibrateCell() from the reco utils. The table is
+ * filled again only if the run or the reco utils switches changed since the last call.
+ */
+void AliEmcalCorrectionComponent::PrepareCellKernel()
+{
+  fCellBunchCrossing = fEventManager.InputEvent() ? fEventManager.InputEvent()->GetBunchCrossNumber() : -1;
+
+  if (!fRecoUtils || !fGeom) {
+    fCellCalibration.clear();
+    fCellCalibrationSwitches = 0;
+    return;
+  }
+
+  UInt_t switches = (fRecoUtils->IsRecalibrationOn() ? 1 : 0) | (fRecoUtils->IsTimeRecalibrationOn() ? 2 : 0) |
+                    (fRecoUtils->IsBadChannelsRemovalSwitchedOn() ? 4 : 0) | (fRecoUtils->IsL1PhaseInTimeRecalibrationOn() ? 8 : 0) |
+                    (fRecoUtils->IsLGOn() ? 16 : 0);
+  fCellTimeShift = fRecoUtils->GetConstantTimeShift();
+
+  if (fRun == fCellCalibrationRun && switches == fCellCalibrationSwitches && !fCellCalibration.empty()) return;
+
+  fCellCalibrationRun = fRun;
+  fCellCalibrationSwitches = switches;
+
+  Int_t nSM = fGeom->GetNumberOfSuperModules();
+  fCellCalibration.resize(24*48*nSM);
+  fCellL1Phase.assign(nSM, 0);
+
+  Int_t imod = -1, iphi =-1, ieta=-1,iTower = -1, iIphi = -1, iIeta = -1, status = 0;
+  for (Int_t absId = 0; absId < Int_t(fCellCalibration.size()); absId++)
+  {
+    CellCalibration &calib = fCellCalibration[absId];
+    calib.fSM = -1;
+    calib.fBad = kTRUE;
+    calib.fEnergyFactor = 1;
+    for (Int_t bc = 0; bc < 4; bc++) {
+      calib.fTimeShift[0][bc] = 0;
+      calib.fTimeShift[1][bc] = 0;
+    }
+
+    if (!fGeom->GetCellIndex(absId, imod, iTower, iIphi, iIeta)) continue;
+    fGeom->GetCellPhiEtaIndexInSModule(imod, iTower, iIphi, iIeta, iphi, ieta);
+
+    calib.fSM = imod;
+    calib.fBad = fRecoUtils->IsBadChannelsRemovalSwitchedOn() && fRecoUtils->GetEMCALChannelStatus(imod, ieta, iphi, status);
+    if (fRecoUtils->IsRecalibrationOn())
+      calib.fEnergyFactor = fRecoUtils->GetEMCALChannelRecalibrationFactor(imod, ieta, iphi);
+    if (fRecoUtils->IsTimeRecalibrationOn()) {
+      for (Int_t bc = 0; bc < 4; bc++) {
+        calib.fTimeShift[0][bc] = fRecoUtils->GetEMCALChannelTimeRecalibrationFactor(bc, absId, kFALSE);
+        calib.fTimeShift[1][bc] = fRecoUtils->GetEMCALChannelTimeRecalibrationFactor(bc, absId, fRecoUtils->IsLGOn());
+      }
+    }
+  }
+
+  if (fRecoUtils->IsL1PhaseInTimeRecalibrationOn()) {
+    for (Int_t iSM = 0; iSM < nSM; iSM++)
+      fCellL1Phase[iSM] = fRecoUtils->GetEMCALL1PhaseInTimeRecalibrationForSM(iSM);
+  }
+}
+
+/**
+ * Recalibrate one cell with the table filled by PrepareCellKernel(). Same as
+ * AliEMCALRecoUtils::AcceptCalibrateCell() as called by AliEMCALRecoUtils::RecalibrateCells(),
+ * without looking up the histograms of the reco utils for each cell.
+ *
+ * @param[in] absId Absolute ID of the cell
+ * @param[in,out] amp Energy of the cell, set to 0 if the cell is rejected
+ * @param[in,out] time Time of the cell, set to -1 if the cell is rejected
+ * @param[in] highGain True if the cell is high gain
+ *
+ * @return False if the cell is rejected
+ */
+Bool_t AliEmcalCorrectionComponent::RecalibrateCell(Short_t absId, Float_t &amp, Double_t &time, Bool_t highGain) const
+{
+  // nothing is done if neither the energy/time recalibration nor the bad channel removal are on
+  if (!(fCellCalibrationSwitches & 7)) return kTRUE;
+
+  if (absId < 0 || absId >= Int_t(fCellCalibration.size()) || fCellCalibration[absId].fBad) {
+    amp = 0;
+    time = -1;
+    return kFALSE;
+  }
+
+  const CellCalibration &calib = fCellCalibration[absId];
+
+  amp *= calib.fEnergyFactor;
+
+  time -= fCellTimeShift*1e-9;
+  if (fCellBunchCrossing >= 0) {
+    Int_t bc = fCellBunchCrossing%4;
+
+    if (fCellCalibrationSwitches & 2)
+      time -= calib.fTimeShift[highGain ? 0 : 1][bc]*1.e-9;
+
+    if (fCellCalibrationSwitches & 8) {
+      Float_t offsetPerSM = 0.;
+      Int_t l1PhaseShift = fCellL1Phase[calib.fSM];
+      Int_t l1Phase = l1PhaseShift & 3;
+
+      if (bc >= l1Phase)
+        offsetPerSM = (bc - l1Phase)*25;
+      else
+        offsetPerSM = (bc - l1Phase + 4)*25;
+
+      Int_t l1shiftOffset = l1PhaseShift>>2;
+      l1shiftOffset *= 25;
+
+      time -= offsetPerSM*1.e-9;
+      time -= l1shiftOffset*1.e-9;
+    }
+  }
+
+  return kTRUE;
+}
+
 /**
  * Check whether the run changed.
  */
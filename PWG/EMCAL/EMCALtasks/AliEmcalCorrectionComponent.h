@@ -3,6 +3,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 class TH1F;
 #include <TNamed.h>
@@ -54,6 +55,13 @@ class AliEmcalCorrectionComponent : public TNamed {
   virtual Bool_t UserNotify();
   virtual Bool_t CheckIfRunChanged();
   
+  // Per-cell corrections, which can be run by AliEmcalCorrectionTask in a single loop on the cells
+  virtual Bool_t HasCellKernel() const { return kFALSE; }
+  virtual Bool_t BeginCellKernel() { return kFALSE; }
+  virtual void ApplyCellKernel(Short_t absId, Float_t &amp, Double_t &time, Bool_t highGain);
+  virtual void EndCellKernel() {}
+  void PrepareCellKernel();
+
   void GetEtaPhiDiff(const AliVTrack *t, const AliVCluster *v, Double_t &phidiff, Double_t &etadiff);
   void UpdateCells();
   void GetPass();
@@ -110,6 +118,19 @@ class AliEmcalCorrectionComponent : public TNamed {
   /// Retrieve property
   template<typename T> bool GetProperty(std::string propertyName, T & property, bool requiredProperty = true, std::string correctionName = "");
  protected:
+  /**
+   * @struct CellCalibration
+   * @brief Calibration of one cell by the reco utils of the component, see RecalibrateCell()
+   */
+  struct CellCalibration {
+    Int_t                 fSM;                            ///< Supermodule of the cell, -1 if the cell does not exist
+    Bool_t                fBad;                           ///< True if the cell is rejected
+    Float_t               fEnergyFactor;                  ///< Energy recalibration factor
+    Float_t               fTimeShift[2][4];               ///< Time shift (ns) for high/low gain, for each bunch crossing mod 4
+  };
+
+  Bool_t RecalibrateCell(Short_t absId, Float_t &amp, Double_t &time, Bool_t highGain) const;
+
   PWG::Tools::AliYAMLConfiguration fYAMLConfig;           ///< Contains the %YAML configuration used to configure the component
   Bool_t                  fCreateHisto;                   ///< Flag to make some basic histograms
   Int_t                   fRun;                           //!<! Run number
@@ -136,12 +157,19 @@ class AliEmcalCorrectionComponent : public TNamed {
   TString                fBasePath;                       ///< Base folder path to get root files
   TString                fCustomBadChannelFilePath;       ///< Custom path to bad channel map OADB file
 
+  std::vector<CellCalibration> fCellCalibration;          //!<! Calibration of each cell (indexed by absId) used by RecalibrateCell()
+  std::vector<Int_t>      fCellL1Phase;                   //!<! L1 phase of each supermodule used by RecalibrateCell()
+  Int_t                   fCellCalibrationRun;            //!<! Run for which fCellCalibration was filled
+  UInt_t                  fCellCalibrationSwitches;       //!<! Reco utils switches with which fCellCalibration was filled
+  Float_t                 fCellTimeShift;                 //!<! Constant time shift (ns) used by RecalibrateCell()
+  Int_t                   fCellBunchCrossing;             //!<! Bunch crossing number of the event used by RecalibrateCell()
+
  private:
   AliEmcalCorrectionComponent(const AliEmcalCorrectionComponent &);               // Not implemented
   AliEmcalCorrectionComponent &operator=(const AliEmcalCorrectionComponent &);    // Not implemented
   
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionComponent, 6); // EMCal correction component
+  ClassDef(AliEmcalCorrectionComponent, 7); // EMCal correction component
   /// \endcond
 };
 
@@ -61,6 +61,7 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask() :
   fBeamType(kNA),
   fForceBeamType(kNA),
   fNeedEmcalGeom(kTRUE),
+  fFuseCellCorrections(kTRUE),
   fGeom(0),
   fParticleCollArray(),
   fClusterCollArray(),
@@ -107,6 +108,7 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const char * name) :
   fBeamType(kNA),
   fForceBeamType(kNA),
   fNeedEmcalGeom(kTRUE),
+  fFuseCellCorrections(kTRUE),
   fGeom(0),
   fParticleCollArray(),
   fClusterCollArray(),
@@ -153,6 +155,7 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const AliEmcalCorrectionTask & ta
   fBeamType(task.fBeamType),
   fForceBeamType(task.fForceBeamType),
   fNeedEmcalGeom(task.fNeedEmcalGeom),
+  fFuseCellCorrections(task.fFuseCellCorrections),
   fGeom(task.fGeom),
   fParticleCollArray(*(static_cast<TObjArray *>(task.fParticleCollArray.Clone()))),
   fClusterCollArray(*(static_cast<TObjArray *>(task.fClusterCollArray.Clone()))),
@@ -217,6 +220,7 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
   swap(first.fBeamType, second.fBeamType);
   swap(first.fForceBeamType, second.fForceBeamType);
   swap(first.fNeedEmcalGeom, second.fNeedEmcalGeom);
+  swap(first.fFuseCellCorrections, second.fFuseCellCorrections);
   swap(first.fGeom, second.fGeom);
   swap(first.fParticleCollArray, second.fParticleCollArray);
   swap(first.fClusterCollArray, second.fClusterCollArray);
@@ -1310,19 +1314,36 @@ Bool_t AliEmcalCorrectionTask::RetrieveEventObjects()
 /**
  * Executed each event. It sets run-by-run properties in the correction components and calls Run() for each
  * component.
+ *
+ * Consecutive components which correct the cells one by one (see AliEmcalCorrectionComponent::HasCellKernel())
+ * and which act on the same cells are run together in a single loop on the cells (see RunCellKernels()).
+ * This can be disabled with SetFuseCellCorrections(false).
  */
 Bool_t AliEmcalCorrectionTask::Run()
 {
-  // Run the initialization for all derived classes.
-  for (auto component : fCorrectionComponents)
+  std::size_t nComponents = fCorrectionComponents.size();
+  for (std::size_t i = 0; i < nComponents; )
   {
-    component->SetInputEvent(InputEvent());
-    component->SetMCEvent(MCEvent());
-    component->SetCentralityBin(fCentBin);
-    component->SetCentrality(fCent);
-    component->SetVertex(fVertex);
+    AliEmcalCorrectionComponent * component = fCorrectionComponents.at(i);
+
+    // Find the consecutive cell corrections which act on the same cells
+    std::size_t last = i;
+    if (fFuseCellCorrections && component->HasCellKernel() && component->GetCaloCells()) {
+      while (last + 1 < nComponents && fCorrectionComponents.at(last + 1)->HasCellKernel() &&
+             fCorrectionComponents.at(last + 1)->GetCaloCells() == component->GetCaloCells()) {
+        last++;
+      }
+    }
+
+    if (last > i) {
+      RunCellKernels(i, last);
+    }
+    else {
+      SetupComponentForEvent(component);
+      component->Run();
+    }
 
-    component->Run();
+    i = last + 1;
   }
 
   PostData(1, fOutput);
@@ -1330,6 +1351,73 @@ Bool_t AliEmcalCorrectionTask::Run()
   return kTRUE;
 }
 
+/**
+ * Sets the event properties in a correction component before running it.
+ *
+ * @param[in] component Correction component to be run on the current event
+ */
+void AliEmcalCorrectionTask::SetupComponentForEvent(AliEmcalCorrectionComponent * component)
+{
+  component->SetInputEvent(InputEvent());
+  component->SetMCEvent(MCEvent());
+  component->SetCentralityBin(fCentBin);
+  component->SetCentrality(fCent);
+  component->SetVertex(fVertex);
+}
+
+/**
+ * Run a sequence of cell corrections acting on the same cells in a single loop on the cells.
+ * Each cell is passed through the kernels of all the components, in the order in which the
+ * components are configured, and it is written back only once. The result is the same as
+ * running the components one after the other.
+ *
+ * @param[in] first Index of the first component of the sequence in fCorrectionComponents
+ * @param[in] last Index of the last component of the sequence in fCorrectionComponents
+ */
+void AliEmcalCorrectionTask::RunCellKernels(std::size_t first, std::size_t last)
+{
+  std::vector<AliEmcalCorrectionComponent *> kernels;
+  for (std::size_t i = first; i <= last; i++)
+  {
+    AliEmcalCorrectionComponent * component = fCorrectionComponents.at(i);
+    SetupComponentForEvent(component);
+
+    // Components which do not correct the cells in this event are skipped, as in their Run()
+    if (component->BeginCellKernel()) {
+      component->PrepareCellKernel();
+      kernels.push_back(component);
+    }
+  }
+  if (kernels.empty()) return;
+
+  AliVCaloCells * cells = kernels.front()->GetCaloCells();
+  Short_t absId = -1;
+  Double_t ecell = 0;
+  Double_t tcell = 0;
+  Double_t efrac = 0;
+  Int_t mclabel = -1;
+
+  Int_t nCells = cells->GetNumberOfCells();
+  for (Int_t iCell = 0; iCell < nCells; iCell++)
+  {
+    cells->GetCell(iCell, absId, ecell, tcell, mclabel, efrac);
+    Bool_t highGain = cells->GetHighGain(iCell);
+
+    Float_t amp = ecell;
+    Double_t time = tcell;
+    for (auto component : kernels) {
+      component->ApplyCellKernel(absId, amp, time, highGain);
+    }
+
+    cells->SetCell(iCell, absId, amp, time, mclabel, efrac);
+  }
+  cells->Sort();
+
+  for (auto component : kernels) {
+    component->EndCellKernel();
+  }
+}
+
 /**
  * Executed when the file is changed. Also calls UserNotify() for each component.
  */
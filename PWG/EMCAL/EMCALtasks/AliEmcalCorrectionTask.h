@@ -100,6 +100,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Set
   void                        SetForceBeamType(BeamType f)                          { fForceBeamType     = f                              ; }
   void                        SetNeedEmcalGeometry(Bool_t b)                        { fNeedEmcalGeom     = b                              ; }
+  void                        SetFuseCellCorrections(Bool_t b)                      { fFuseCellCorrections = b                            ; }
   // Centrality options
   void                        SetUseNewCentralityEstimation(Bool_t b)               { fUseNewCentralityEstimation = b                     ; }
   void                        SetCentralityEstimator(const char * c)                { fCentEst           = c                              ; }
@@ -191,6 +192,8 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Execute component functions
   void UserCreateOutputObjectsComponents();
   void ExecOnceComponents();
+  void SetupComponentForEvent(AliEmcalCorrectionComponent * component);
+  void RunCellKernels(std::size_t first, std::size_t last);
 
   // Initialization functions
   void InitializeConfiguration();
@@ -241,6 +244,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   BeamType                    fBeamType;                   //!<! Event beam type
   BeamType                    fForceBeamType;              ///< forced beam type
   Bool_t                      fNeedEmcalGeom;              ///< whether or not the task needs the emcal geometry
+  Bool_t                      fFuseCellCorrections;        ///< run consecutive cell corrections on the same cells in a single loop on the cells
   AliEMCALGeometry           *fGeom;                       //!<! Emcal geometry
 
   TObjArray                   fParticleCollArray;          ///< Particle/track collection array
@@ -250,7 +254,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   TList *                     fOutput;                     //!<! Output for histograms
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionTask, 6); // EMCal correction task
+  ClassDef(AliEmcalCorrectionTask, 7); // EMCal correction task
   /// \endcond
 };
 
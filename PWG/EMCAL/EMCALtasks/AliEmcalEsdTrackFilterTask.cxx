@@ -13,6 +13,7 @@
 #include <AliESDtrackCuts.h>
 #include <AliMagF.h>
 #include <AliTrackerBase.h>
+#include "AliEmcalTrackPropagationCache.h"
 
 
 ClassImp(AliEmcalEsdTrackFilterTask)
@@ -111,6 +112,9 @@ void AliEmcalEsdTrackFilterTask::UserExec(Option_t *)
   if (!(InputEvent()->FindListObject(fTracksName)))
     InputEvent()->AddObject(fTracks);
 
+  // the propagations are shared with the other tasks propagating the same tracks in this event
+  AliEmcalTrackPropagationCache *propagationCache = AliEmcalTrackPropagationCache::GetCache(InputEvent());
+
   if (!fHybridTrackCuts) { // constrain TPC tracks to SPD vertex if fDoSpdVtxCon==kTRUE
     am->LoadBranch("AliESDRun.");
     am->LoadBranch("AliESDHeader.");
@@ -164,7 +168,7 @@ void AliEmcalEsdTrackFilterTask::UserExec(Option_t *)
         }
 
         if (fDoPropagation)
-          AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(ntrack,fDist);
+          propagationCache->ExtrapolateTrackToEMCalSurface(ntrack,fDist);
         new ((*fTracks)[ntrnew++]) AliESDtrack(*ntrack);
         delete ntrack;
       }
@@ -186,7 +190,7 @@ void AliEmcalEsdTrackFilterTask::UserExec(Option_t *)
 
         AliESDtrack *ntrack = new ((*fTracks)[ntrnew++]) AliESDtrack(*etrack);
         if (fDoPropagation)
-          AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(ntrack,fDist);
+          propagationCache->ExtrapolateTrackToEMCalSurface(ntrack,fDist);
       }
     }
 
@@ -207,7 +211,7 @@ void AliEmcalEsdTrackFilterTask::UserExec(Option_t *)
         }
         AliESDtrack *newTrack = new ((*fTracks)[ntrnew]) AliESDtrack(*etrack);
         if (fDoPropagation)
-          AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(newTrack,fDist);
+          propagationCache->ExtrapolateTrackToEMCalSurface(newTrack,fDist);
         newTrack->SetBit(BIT(22),0); 
         newTrack->SetBit(BIT(23),0);
         if (!fMCEvent) newTrack->SetLabel(0);
@@ -226,7 +230,7 @@ void AliEmcalEsdTrackFilterTask::UserExec(Option_t *)
         }
         AliESDtrack *newTrack = new ((*fTracks)[ntrnew]) AliESDtrack(*etrack);
         if (fDoPropagation)
-          AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(newTrack,fDist);
+          propagationCache->ExtrapolateTrackToEMCalSurface(newTrack,fDist);
         const AliExternalTrackParam* constrainParam = etrack->GetConstrainedParam();
         newTrack->Set(constrainParam->GetX(),
             constrainParam->GetAlpha(),
@@ -6,6 +6,7 @@
 #include "AliEmcalTrackPropagatorTask.h"
 
 #include "AliParticleContainer.h"
+#include "AliEmcalTrackPropagationCache.h"
 
 #include <TClonesArray.h>
 
@@ -61,6 +62,9 @@ Bool_t AliEmcalTrackPropagatorTask::Run()
   AliParticleContainer* tracks = GetParticleContainer(0);
 
   if (!tracks) return 0;
+
+  // the propagations are shared with the other tasks propagating the same tracks in this event
+  AliEmcalTrackPropagationCache *propagationCache = AliEmcalTrackPropagationCache::GetCache(InputEvent());
   
   tracks->ResetCurrentID();
   AliVTrack* track = 0;
@@ -68,7 +72,7 @@ Bool_t AliEmcalTrackPropagatorTask::Run()
     if (fOnlyIfNotSet && track->IsExtrapolatedToEMCAL()) continue;
     if (fOnlyIfEmcal && !track->IsEMCAL()) continue;
     
-    AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fDist);
+    propagationCache->ExtrapolateTrackToEMCalSurface(track, fDist);
   }
 
   return kTRUE;
@@ -18,6 +18,7 @@
 #include "AliEMCALGeometry.h"
 #include "AliParticleContainer.h"
 #include "AliClusterContainer.h"
+#include "AliEmcalClusterEtaPhiGrid.h"
 
 #include "AliHadCorrTask.h"
 
@@ -567,6 +568,11 @@ void AliHadCorrTask::DoMatchedTracksLoop(Int_t icluster,
   AliVCluster* cluster = clusters->GetCluster(icluster);
 
   if (!cluster) return;
+
+  // the cluster position is the same for all the matched tracks
+  Double_t clusEta = 0;
+  Double_t clusPhi = 0;
+  AliEmcalClusterEtaPhiGrid::GetClusterEtaPhi(cluster, clusEta, clusPhi);
   
   // loop over matched tracks
   Int_t Ntrks = cluster->GetNTracksMatched();
@@ -587,7 +593,7 @@ void AliHadCorrTask::DoMatchedTracksLoop(Int_t icluster,
 
     Double_t etadiff = 999;
     Double_t phidiff = 999;
-    GetEtaPhiDiff(track, cluster, phidiff, etadiff);
+    AliEmcalClusterEtaPhiGrid::GetEtaPhiDiff(track, clusEta, clusPhi, phidiff, etadiff);
     if (fCreateHisto) fHistMatchEtaPhiAllCl->Fill(etadiff, phidiff);
 
     // check if track also points to cluster
@@ -636,10 +642,7 @@ void AliHadCorrTask::DoMatchedTracksLoop(Int_t icluster,
 
       if (fCreateHisto) {
         if (fHadCorr > 1) {
-          Double_t dphi = 0;
-          Double_t deta = 0;
-          GetEtaPhiDiff(track, cluster, dphi, deta);
-          Double_t dR = TMath::Sqrt(dphi*dphi + deta*deta);
+          Double_t dR = TMath::Sqrt(phidiff*phidiff + etadiff*etadiff);
           Double_t energyclus = cluster->GetNonLinCorrEnergy();
           fHistMatchdRvsEP[fCentBin]->Fill(dR, energyclus / mom);
         }
@@ -767,10 +770,7 @@ Double_t AliHadCorrTask::ApplyHadCorrOneTrack(Int_t icluster, Double_t hadCorr)
     fHistMatchEtaPhiAll->Fill(dEtaMin, dPhiMin);
     
     if (mom > 0) {
-      Double_t etadiff = 0;
-      Double_t phidiff = 0;
-      GetEtaPhiDiff(track, cluster, phidiff, etadiff);
-      Double_t dRmin = TMath::Sqrt(etadiff*etadiff + phidiff*phidiff);
+      Double_t dRmin = TMath::Sqrt(dEtaMin*dEtaMin + dPhiMin*dPhiMin);
       fHistMatchEvsP[fCentBin]->Fill(energyclus, energyclus / mom);
       fHistEoPCent->Fill(fCent, energyclus / mom);
       fHistMatchdRvsEP[fCentBin]->Fill(dRmin, energyclus / mom);
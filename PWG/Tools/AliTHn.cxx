@@ -360,6 +360,43 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 //   AliCFContainer::Fill(var, istep, weight);
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillBin(const Int_t *binIdx, Int_t istep, Double_t sumw, Double_t sumw2)
+{
+  // adds several entries to the bin with the TAxis bin indexes <binIdx>
+  // <sumw> is the sum of their weights and <sumw2> the sum of their squared weights,
+  // so that the result is the same as filling the entries one by one with Fill
+  
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    // under/overflow not supported
+    if (binIdx[i] < 1 || binIdx[i] > GetAxis(i, 0)->GetNbins())
+      return;
+  }
+  
+  Long64_t bin = GetGlobalBinIndex(binIdx);
+  
+  if (!fValues[istep])
+  {
+    fValues[istep] = new TemplateArray(fNBins);
+    AliInfo(Form("Created values container for step %d", istep));
+  }
+
+  if (sumw2 != sumw)
+  {
+    // at least one of the entries has a weight != 1 (see Fill)
+    if (!fSumw2[istep])
+    {
+      fSumw2[istep] = new TemplateArray(*fValues[istep]);
+      AliInfo(Form("Created sumw2 container for step %d", istep));
+    }
+  }
+
+  fValues[istep]->GetArray()[bin] += sumw;
+  if (fSumw2[istep])
+    fSumw2[istep]->GetArray()[bin] += sumw2;
+}
+
 template <class TemplateArray, typename TemplateType>
 Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndex(const Int_t* binIdx)
 {
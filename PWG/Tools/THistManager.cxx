@@ -13,6 +13,7 @@
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
 #include <cfloat>
+#include <cstdio>
 #include <cstring>
 #include <iostream>   // for unit tests
 #include <sstream>
@@ -26,6 +27,7 @@
 #include <TH3.h>
 #include <THnSparse.h>
 #include <THashList.h>
+#include <TMap.h>
 #include <TMath.h>
 #include <TObjArray.h>
 #include <TObjString.h>
@@ -42,14 +44,16 @@ ClassImp(THistManager)
 THistManager::THistManager():
 		TNamed(),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fFillCache(NULL)
 {
 }
 
 THistManager::THistManager(const char *name):
 		TNamed(name, Form("Histogram container %s", name)),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fFillCache(NULL)
 {
 	fHistos = new THashList();
 	fHistos->SetName(Form("histos%s", name));
@@ -58,6 +62,7 @@ THistManager::THistManager(const char *name):
 
 THistManager::~THistManager(){
 	if(fHistos && fIsOwner) delete fHistos;
+	if(fFillCache) delete fFillCache;
 }
 
 THashList* THistManager::CreateHistoGroup(const char *groupname) {
@@ -354,7 +359,7 @@ THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, in
   return hsparse;
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, double xmin, double xmax, Option_t *opt) {
+TProfile *THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, double xmin, double xmax, Option_t *opt) {
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -362,9 +367,10 @@ void THistManager::CreateTProfile(const char* name, const char* title, int nbins
 		Fatal("THistManager::CreateTProfile", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname, title, nbinsX, xmin, xmax, opt);
   parent->Add(hist);
+  return hist;
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, const double* xbins, Option_t *opt) {
+TProfile *THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, const double* xbins, Option_t *opt) {
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -372,9 +378,10 @@ void THistManager::CreateTProfile(const char* name, const char* title, int nbins
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname, title, nbinsX, xbins, opt);
   parent->Add(hist);
+  return hist;
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, const TArrayD& xbins, Option_t *opt){
+TProfile *THistManager::CreateTProfile(const char* name, const char* title, const TArrayD& xbins, Option_t *opt){
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -382,16 +389,17 @@ void THistManager::CreateTProfile(const char* name, const char* title, const TAr
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname.Data(), title, xbins.GetSize()-1, xbins.GetArray(), opt);
   parent->Add(hist);
+  return hist;
 }
 
-void THistManager::CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt){
+TProfile *THistManager::CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt){
   TArrayD myxbins;
   try{
     xbins.CreateBinEdges(myxbins);
   } catch (std::exception &e){
     Fatal("THistManager::CreateProfile", "Exception raised: %s", e.what());
   }
-  CreateTProfile(name, title, myxbins, opt);
+  return CreateTProfile(name, title, myxbins, opt);
 }
 
 void THistManager::SetObject(TObject * const o, const char *group) {
@@ -409,220 +417,251 @@ void THistManager::SetObject(TObject * const o, const char *group) {
 }
 
 void THistManager::FillTH1(const char *name, double x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
+	TH1 *hist = dynamic_cast<TH1 *>(FindHistogram(name));
 	if(!hist){
-		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTH1", "Histogram %s not found", name);
 		return;
 	}
-	TString optionstring(opt);
-	if(optionstring.Contains("w")){
-	  // use bin width as weight
-	  Int_t bin = hist->GetXaxis()->FindBin(x);
-	  // check if not overflow or underflow bin
-	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
-	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
-	}
-	hist->Fill(x, weight);
+	FillTH1(hist, x, weight, opt);
 }
 
 void THistManager::FillTH1(const char *name, const char *label, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
-	TString optionstring(opt);
-	if(optionstring.Contains("w")){
-	  // use bin width as weight
-	  // get bin for label
-	  Int_t bin = hist->GetXaxis()->FindBin(label);
-	  // check if not overflow or underflow bin
-	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
-	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+	TH1 *hist = dynamic_cast<TH1 *>(FindHistogram(name));
+	if(!hist){
+		Fatal("THistManager::FillTH1", "Histogram %s not found", name);
+		return;
 	}
-  hist->Fill(label, weight);
+	FillTH1(hist, label, weight, opt);
 }
 
 void THistManager::FillTH2(const char *name, double x, double y, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
+	TH2 *hist = dynamic_cast<TH2 *>(FindHistogram(name));
 	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTH2", "Histogram %s not found", name);
 		return;
 	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	hist->Fill(x, y, myweight);
+	FillTH2(hist, x, y, weight, opt);
 }
 
 void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
+	TH2 *hist = dynamic_cast<TH2 *>(FindHistogram(name));
 	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTH2", "Histogram %s not found", name);
 		return;
 	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	hist->Fill(point[0], point[1], weight);
+	FillTH2(hist, point, weight, opt);
 }
 
 void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
-  TString optstring(opt);
-  Double_t myweight = optstring.Contains("w") ? 1. : weight;
-  if(optstring.Contains("wx")){
-    Int_t binx = hist->GetXaxis()->FindBin(labelY);
-    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-  }
-  if(optstring.Contains("wy")){
-    Int_t biny = hist->GetYaxis()->FindBin(labelX);
-    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-  }
-  hist->Fill(labelX, labelY, weight);
+	TH2 *hist = dynamic_cast<TH2 *>(FindHistogram(name));
+	if(!hist){
+		Fatal("THistManager::FillTH2", "Histogram %s not found", name);
+		return;
+	}
+	FillTH2(hist, labelX, labelY, weight, opt);
 }
 
 void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
+	TH3 *hist = dynamic_cast<TH3 *>(FindHistogram(name));
+	if(!hist){
+		Fatal("THistManager::FillTH3", "Histogram %s not found", name);
 		return;
 	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
+	FillTH3(hist, x, y, z, weight, opt);
+}
+
+void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
+	TH3 *hist = dynamic_cast<TH3 *>(FindHistogram(name));
 	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTH3", "Histogram %s not found", name);
 		return;
 	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(z);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
-	}
-	hist->Fill(x, y, z, weight);
+	FillTH3(hist, point, weight, opt);
 }
 
-void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
+void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
+	THnSparseD *hist = dynamic_cast<THnSparseD *>(FindHistogram(name));
+	if(!hist){
+		Fatal("THistManager::FillTHnSparse", "Histogram %s not found", name);
 		return;
 	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
+	FillTHnSparse(hist, x, weight, opt);
+}
+
+void THistManager::FillProfile(const char* name, double x, double y, double weight){
+	TProfile *hist = dynamic_cast<TProfile *>(FindHistogram(name));
 	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTProfile", "Histogram %s not found", name);
 		return;
 	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	FillProfile(hist, x, y, weight);
+}
+
+void THistManager::FillTH1(TH1 *hist, double x, double weight, Option_t *opt) {
+	if(HasOption(opt, "w")){
+	  // use bin width as weight
+	  Int_t bin = hist->GetXaxis()->FindBin(x);
+	  // check if not overflow or underflow bin
+	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
+	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+	}
+	hist->Fill(x, weight);
+}
+
+void THistManager::FillTH1(TH1 *hist, const char *label, double weight, Option_t *opt) {
+	if(HasOption(opt, "w")){
+	  // use bin width as weight
+	  // get bin for label
+	  Int_t bin = hist->GetXaxis()->FindBin(label);
+	  // check if not overflow or underflow bin
+	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
+	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+	}
+	hist->Fill(label, weight);
+}
+
+void THistManager::FillTH1(TH1 *hist, int n, const double *x, const double *weights, Option_t *opt) {
+	if(!HasOption(opt, "w")){
+	  hist->FillN(n, x, weights);
+	  return;
 	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	for(int i = 0; i < n; i++) FillTH1(hist, x[i], weights ? weights[i] : 1., opt);
+}
+
+void THistManager::FillTH2(TH2 *hist, double x, double y, double weight, Option_t *opt) {
+	Double_t myweight = weight;
+	if(HasOption(opt, "w")){
+	  myweight = 1.;
+	  if(HasOption(opt, "wx")){
+	    Int_t binx = hist->GetXaxis()->FindBin(x);
+	    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	  }
+	  if(HasOption(opt, "wy")){
+	    Int_t biny = hist->GetYaxis()->FindBin(y);
+	    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	  }
 	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(point[2]);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
+	hist->Fill(x, y, myweight);
+}
+
+void THistManager::FillTH2(TH2 *hist, double *point, double weight, Option_t *opt) {
+	Double_t myweight = weight;
+	if(HasOption(opt, "w")){
+	  myweight = 1.;
+	  if(HasOption(opt, "wx")){
+	    Int_t binx = hist->GetXaxis()->FindBin(point[0]);
+	    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	  }
+	  if(HasOption(opt, "wy")){
+	    Int_t biny = hist->GetYaxis()->FindBin(point[1]);
+	    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	  }
 	}
-	hist->Fill(point[0], point[1], point[2], weight);
+	hist->Fill(point[0], point[1], weight);
 }
 
-void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTHnSparse", "Parent group %s does not exist", dirname.Data());
-		return;
+void THistManager::FillTH2(TH2 *hist, const char *labelX, const char *labelY, double weight, Option_t *opt) {
+	Double_t myweight = weight;
+	if(HasOption(opt, "w")){
+	  myweight = 1.;
+	  if(HasOption(opt, "wx")){
+	    Int_t binx = hist->GetXaxis()->FindBin(labelY);
+	    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	  }
+	  if(HasOption(opt, "wy")){
+	    Int_t biny = hist->GetYaxis()->FindBin(labelX);
+	    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	  }
 	}
-	THnSparseD *hist = dynamic_cast<THnSparseD *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTHnSparse", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
+	hist->Fill(labelX, labelY, weight);
+}
+
+void THistManager::FillTH2(TH2 *hist, int n, const double *x, const double *y, const double *weights, Option_t *opt) {
+	if(!HasOption(opt, "w")){
+	  hist->FillN(n, x, y, weights);
+	  return;
+	}
+	for(int i = 0; i < n; i++) FillTH2(hist, x[i], y[i], weights ? weights[i] : 1., opt);
+}
+
+void THistManager::FillTH3(TH3 *hist, double x, double y, double z, double weight, Option_t *opt) {
+	Double_t myweight = weight;
+	if(HasOption(opt, "w")){
+	  myweight = 1.;
+	  if(HasOption(opt, "wx")){
+	    Int_t binx = hist->GetXaxis()->FindBin(x);
+	    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	  }
+	  if(HasOption(opt, "wy")){
+	    Int_t biny = hist->GetYaxis()->FindBin(y);
+	    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	  }
+	  if(HasOption(opt, "wz")){
+	    Int_t binz = hist->GetZaxis()->FindBin(z);
+	    if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
+	  }
+	}
+	hist->Fill(x, y, z, weight);
+}
+
+void THistManager::FillTH3(TH3 *hist, const double *point, double weight, Option_t *opt) {
+	Double_t myweight = weight;
+	if(HasOption(opt, "w")){
+	  myweight = 1.;
+	  if(HasOption(opt, "wx")){
+	    Int_t binx = hist->GetXaxis()->FindBin(point[0]);
+	    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	  }
+	  if(HasOption(opt, "wy")){
+	    Int_t biny = hist->GetYaxis()->FindBin(point[1]);
+	    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	  }
+	  if(HasOption(opt, "wz")){
+	    Int_t binz = hist->GetZaxis()->FindBin(point[2]);
+	    if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
+	  }
 	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
-	  std::stringstream weighthandler;
-	  weighthandler << "w" << iaxis;
-	  if(optstring.Contains(weighthandler.str().c_str())){
-	    Int_t bin = hist->GetAxis(iaxis)->FindBin(x[iaxis]);
-	    if(bin != 0 && bin != hist->GetAxis(iaxis)->GetNbins()) myweight *= hist->GetAxis(iaxis)->GetBinWidth(bin);
+	hist->Fill(point[0], point[1], point[2], weight);
+}
+
+void THistManager::FillTHnSparse(THnSparse *hist, const double *x, double weight, Option_t *opt) {
+	Double_t myweight = weight;
+	if(HasOption(opt, "w")){
+	  myweight = 1.;
+	  char weighthandler[16];
+	  for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
+	    snprintf(weighthandler, sizeof(weighthandler), "w%d", iaxis);
+	    if(HasOption(opt, weighthandler)){
+	      Int_t bin = hist->GetAxis(iaxis)->FindBin(x[iaxis]);
+	      if(bin != 0 && bin != hist->GetAxis(iaxis)->GetNbins()) myweight *= hist->GetAxis(iaxis)->GetBinWidth(bin);
+	    }
 	  }
 	}
 
 	hist->Fill(x, weight);
 }
 
-void THistManager::FillProfile(const char* name, double x, double y, double weight){
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent)
-		Fatal("THistManager::FillTProfile", "Parent group %s does not exist", dirname.Data());
-  TProfile *hist = dynamic_cast<TProfile *>(parent->FindObject(hname));
-  if(!hist)
-		Fatal("THistManager::FillTProfile", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-  hist->Fill(x, y, weight);
+void THistManager::FillProfile(TProfile *hist, double x, double y, double weight){
+	hist->Fill(x, y, weight);
+}
+
+TObject *THistManager::FindHistogram(const char *name) const {
+	if(fFillCache){
+		TObject *cached = fFillCache->GetValue(name);
+		if(cached) return cached;
+	}
+	TObject *hist = FindObject(name);
+	if(!hist) return NULL;
+	if(!fFillCache){
+		fFillCache = new TMap;
+		fFillCache->SetOwnerKeyValue(kTRUE, kFALSE);
+	}
+	fFillCache->Add(new TObjString(name), hist);
+	return hist;
+}
+
+bool THistManager::HasOption(Option_t *opt, const char *key) {
+	return opt && strstr(opt, key);
 }
 
 TObject *THistManager::FindObject(const char *name) const {
@@ -1030,6 +1069,49 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandles(){
+    THistManager testmgr("testmgr");
+
+    TH1 *hist1 = testmgr.CreateTH1("Group1/Test1", "Test handle 1D", 1, 0., 1.);
+    TH2 *hist2 = testmgr.CreateTH2("Group1/Test2", "Test handle 2D", 1, 0., 1., 1, 0., 1.);
+    TProfile *profile = testmgr.CreateTProfile("Group1/TestProfile", "Test handle Profile histogram", 1, 0., 1.);
+
+    double values[25];
+    for(int i = 0; i < 25; i++) values[i] = 0.5;
+    for(int i = 0; i < 50; i++){
+      testmgr.FillTH1("Group1/Test1", 0.5);
+      testmgr.FillTH2("Group1/Test2", 0.5, 0.5);
+    }
+    for(int i = 0; i < 25; i++){
+      testmgr.FillTH1(hist1, 0.5);
+      testmgr.FillTH2(hist2, 0.5, 0.5);
+    }
+    testmgr.FillTH1(hist1, 25, values);
+    testmgr.FillTH2(hist2, 25, values, values);
+    for(int i = 0; i < 100; i++) testmgr.FillProfile(profile, 0.5, 1.);
+
+    // Evaluate test
+    bool success(true);
+
+    if(TMath::Abs(hist1->GetBinContent(1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/Test1: Value mismatch: expected 100, found " << hist1->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(hist2->GetBinContent(1,1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/Test2: Value mismatch: expected 100, found " << hist2->GetBinContent(1,1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(profile->GetBinContent(1) - 1) > DBL_EPSILON){
+      std::cout << "Group1/TestProfile: Value mismatch: expected 1, found " << profile->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    if(testmgr.FindObject("Group1/Test1") != hist1){
+      std::cout << "Handle mismatch for Group1/Test1" << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1050,6 +1132,10 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handles" << std::endl;
+    testresult += testsuite.TestFillHandles();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1158,9 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandles(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandles();
+  }
 }
@@ -12,6 +12,7 @@ class TArrayD;
 class TAxis;
 class TBinning;
 class TList;
+class TMap;
 class TH1;
 class TH2;
 class TH3;
@@ -88,6 +89,18 @@ class TProfile;
  * }
  * ~~~
  *
+ * The histogram path is resolved once, at the first fill, and remembered
+ * for the following fills. In performance-critical loops (e.g. per track or
+ * per cluster) the histogram pointers returned by the Create methods can be
+ * used as handles in the Fill methods, avoiding the lookup completely. Arrays
+ * of values can be filled in one call:
+ *
+ * ~~~{.cxx}
+ * TH1 *hPt = mgr.CreateTH1("hPt", "pt-distribution", TLinearBinning(100, 0., 100.));
+ * ...
+ * mgr.FillTH1(hPt, ntracks, trackpts);
+ * ~~~
+ *
  * ## Optional automatic correction of the bin width
  *
  * Correction for the bin width can be automatically handled by the histogram
@@ -480,8 +493,9 @@ public:
 	 * @param[in] xmin min. value in x-direction
 	 * @param[in] xmax max. value in x-direction
 	 * @param[in] opt Further options
+	 * @return The newly created profile histogram
 	 */
-  void CreateTProfile(const char *name, const char *title, int nbinsX, double xmin, double xmax, Option_t *opt = "");
+  TProfile *CreateTProfile(const char *name, const char *title, int nbinsX, double xmin, double xmax, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -493,8 +507,9 @@ public:
    * @param[in] nbinsX Number of bins in x-direction
    * @param[in] xbins binning in x-direction
    * @param[in] opt Further options
+   * @return The newly created profile histogram
    */
-  void CreateTProfile(const char *name, const char *title, int nbinsX, const double *xbins, Option_t *opt = "");
+  TProfile *CreateTProfile(const char *name, const char *title, int nbinsX, const double *xbins, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -505,8 +520,9 @@ public:
    * @param[in] title Title of the profile histogram
    * @param[in] xbins binning in x-direction
    * @param[in] opt Further options
+   * @return The newly created profile histogram
    */
-  void CreateTProfile(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
+  TProfile *CreateTProfile(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -517,8 +533,9 @@ public:
    * @param[in] title Title of the profile histogram
    * @param[in] xbins User binning
    * @param[in] opt Further options
+   * @return The newly created profile histogram
    */
-  void CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt = "");
+  TProfile *CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt = "");
 
   /**
    * @brief Set a new group into the container into the parent group
@@ -634,6 +651,130 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+	/**
+	 * @brief Fill a 1D histogram using its handle.
+	 *
+	 * Same as the fill by name, without the lookup of the histogram.
+	 * @param[in] hist Histogram, as returned by CreateTH1
+	 * @param[in] x x-coordinate
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH1(TH1 *hist, double x, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a 1D histogram using its handle.
+	 *
+	 * Same as the fill by name, without the lookup of the histogram.
+	 * @param[in] hist Histogram, as returned by CreateTH1
+	 * @param[in] label Label of the bin to fill
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH1(TH1 *hist, const char *label, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a 1D histogram with an array of values.
+	 * @param[in] hist Histogram, as returned by CreateTH1
+	 * @param[in] n Number of entries
+	 * @param[in] x x-coordinates of the entries
+	 * @param[in] weights optional weights of the entries (default 1 for all entries)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH1(TH1 *hist, int n, const double *x, const double *weights = nullptr, Option_t *opt = "");
+
+	/**
+	 * @brief Fill a 2D histogram using its handle.
+	 *
+	 * Same as the fill by name, without the lookup of the histogram.
+	 * @param[in] hist Histogram, as returned by CreateTH2
+	 * @param[in] x x-coordinate
+	 * @param[in] y y-coordinate
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH2(TH2 *hist, double x, double y, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a 2D histogram using its handle.
+	 *
+	 * Same as the fill by name, without the lookup of the histogram.
+	 * @param[in] hist Histogram, as returned by CreateTH2
+	 * @param[in] labelX x-coordinate
+	 * @param[in] labelY y-coordinate
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH2(TH2 *hist, const char *labelX, const char *labelY, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a 2D histogram using its handle.
+	 *
+	 * Same as the fill by name, without the lookup of the histogram.
+	 * @param[in] hist Histogram, as returned by CreateTH2
+	 * @param[in] point coordinates of the data
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH2(TH2 *hist, double *point, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a 2D histogram with arrays of values.
+	 * @param[in] hist Histogram, as returned by CreateTH2
+	 * @param[in] n Number of entries
+	 * @param[in] x x-coordinates of the entries
+	 * @param[in] y y-coordinates of the entries
+	 * @param[in] weights optional weights of the entries (default 1 for all entries)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH2(TH2 *hist, int n, const double *x, const double *y, const double *weights = nullptr, Option_t *opt = "");
+
+	/**
+	 * @brief Fill a 3D histogram using its handle.
+	 *
+	 * Same as the fill by name, without the lookup of the histogram.
+	 * @param[in] hist Histogram, as returned by CreateTH3
+	 * @param[in] x x-coordinate
+	 * @param[in] y y-coordinate
+	 * @param[in] z z-coordinate
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH3(TH3 *hist, double x, double y, double z, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a 3D histogram using its handle.
+	 *
+	 * Same as the fill by name, without the lookup of the histogram.
+	 * @param[in] hist Histogram, as returned by CreateTH3
+	 * @param[in] point 3D-coordinate (x,y,z) of the point to be filled
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTH3(TH3 *hist, const double *point, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a nD histogram using its handle.
+	 *
+	 * Same as the fill by name, without the lookup of the histogram.
+	 * @param[in] hist Histogram, as returned by CreateTHnSparse
+	 * @param[in] x coordinates of the data
+	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] option Optional filling arguments
+	 */
+	void FillTHnSparse(THnSparse *hist, const double *x, double weight = 1., Option_t *opt = "");
+
+	/**
+	 * @brief Fill a profile histogram using its handle.
+	 *
+	 * Same as the fill by name, without the lookup of the histogram.
+	 * @param[in] hist Profile histogram, as returned by CreateTProfile
+	 * @param[in] x x-coordinate
+	 * @param[in] y y-coordinate
+	 * @param[in] weight optional weight of the entry (default 1)
+	 */
+	void FillProfile(TProfile *hist, double x, double y, double weight = 1.);
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -705,6 +846,24 @@ private:
 	 */
 	THashList *FindGroup(const char *dirname) const;
 
+	/**
+	 * @brief Find a histogram to be filled.
+	 *
+	 * The histogram is searched with FindObject the first time
+	 * and then kept in a lookup table for the next fills.
+	 * @param[in] name Name of the histogram, including the parent groups
+	 * @return pointer to the histogram (NULL if not found)
+	 */
+	TObject *FindHistogram(const char *name) const;
+
+	/**
+	 * @brief Check whether a fill option is set.
+	 * @param[in] opt Fill options
+	 * @param[in] key Option to look for
+	 * @return true if the option is contained in the fill options
+	 */
+	static bool HasOption(Option_t *opt, const char *key);
+
 	/**
 	 * @brief Extracting the basename from a given histogram path.
 	 * @param[in] path histogram path
@@ -721,9 +880,10 @@ private:
 
 	THashList *fHistos;                   ///< List of histograms
 	bool fIsOwner;                        ///< Set the ownership
+	mutable TMap *fFillCache;             //!<! Histograms already looked up in a Fill method, by name
 
   /// \cond CLASSIMP
-	ClassDef(THistManager, 1);  // Container for histograms
+	ClassDef(THistManager, 2);  // Container for histograms
   /// \endcond
 };
 
@@ -762,6 +922,7 @@ namespace TestTHistManager {
  * - Build histrogram in groups
  * - Simple fill
  * - Fill histograms in groups
+ * - Fill histograms using handles
  */
 class THistManagerTestSuite {
 public:
@@ -845,6 +1006,23 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether histograms are filled correctly using the
+   * handles returned by the Create methods
+   * Relies on: TestBuildSimpleHistograms, TestFillSimpleHistograms
+   *
+   * Fill a TH1 and a TH2 in a group
+   * - 50 times by name
+   * - 25 times with the handle
+   * - once with arrays of 25 values
+   * and a TProfile 100 times with the handle
+   *
+   * Test passed:
+   * - All Histograms have the expected value (100 for histograms, 1 for profile)
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandles();
 };
 
 /**
@@ -882,5 +1060,12 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms using handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillHandles();
+
 }
 #endif
@@ -39,6 +39,7 @@
 #include "AliMergeableCollection.h"
 #include "AliCounterCollection.h"
 #include "TList.h"
+#include "TMap.h"
 #include "TObjString.h"
 #include "TMath.h"
 #include "TObjArray.h"
@@ -69,11 +70,59 @@ fCutRegistry(0x0),
 fEvent(0x0),
 fMCEvent(0x0),
 fHistogramToDisable(0x0),
-fHasMC(kFALSE)
+fHasMC(kFALSE),
+fCurrentKey(-1),
+fCurrentEventSelection(0x0),
+fCurrentTriggerClassName(0x0),
+fCurrentCentrality(0x0),
+fHandles(0x0)
 {
  /// default ctor
 }
 
+//_____________________________________________________________________________
+AliAnalysisMuMuBase::~AliAnalysisMuMuBase()
+{
+  /// dtor
+  delete fHandles;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::AddHandle(Bool_t mc, const char* what, const char* histoname, TObject* o)
+{
+  /// Keep the histogram histoname (in the what sub-directory, if any) of the current combination,
+  /// so that it is not searched again in the collection.
+  /// Projections (histoname:px and the like) are made by the collection at each request, so they are not kept
+
+  if ( !o || fCurrentKey < 0 || !o->InheritsFrom(TH1::Class()) || strchr(histoname,':') ) return;
+
+  if ( !fHandles )
+  {
+    fHandles = new TObjArray;
+    fHandles->SetOwner(kTRUE);
+  }
+
+  Int_t index = 2*fCurrentKey + ( mc ? 1 : 0 );
+
+  TMap* whats = ( index < fHandles->GetSize() ) ? static_cast<TMap*>(fHandles->UncheckedAt(index)) : 0x0;
+  if ( !whats )
+  {
+    whats = new TMap;
+    whats->SetOwnerKeyValue(kTRUE,kTRUE);
+    fHandles->AddAtAndExpand(whats,index);
+  }
+
+  TMap* handles = static_cast<TMap*>(whats->GetValue(what));
+  if ( !handles )
+  {
+    handles = new TMap;
+    handles->SetOwnerKeyValue(kTRUE,kFALSE);
+    whats->Add(new TObjString(what),handles);
+  }
+
+  handles->Add(new TObjString(histoname),o);
+}
+
 //_____________________________________________________________________________
 TString AliAnalysisMuMuBase::BuildPath(const char* eventSelection, const char* triggerClassName,
                                        const char* centrality, const char* cut) const
@@ -206,6 +255,16 @@ AliAnalysisMuMuBase::CreateHistos(const TObjArray& paths,
   }
 }
 
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::ClearHandles()
+{
+  /// Forget the histograms already resolved (e.g. when the collection changes)
+
+  delete fHandles;
+  fHandles = 0x0;
+  SetCurrentCombination(-1);
+}
+
 //_____________________________________________________________________________
 void AliAnalysisMuMuBase::CreateSemaphoreHistogram(const char* eventSelection,
                                                    const char* triggerClassName,
@@ -420,6 +479,24 @@ Bool_t AliAnalysisMuMuBase::ExistSemaphoreHistogram(const char* eventSelection,
   return ( HistogramCollection()->Histo(Form("/%s/%s/%s/%s",eventSelection,triggerClassName,centrality,ClassName())) != 0x0 );
 }
 
+//_____________________________________________________________________________
+TObject* AliAnalysisMuMuBase::FindHandle(Bool_t mc, const char* what, const char* histoname) const
+{
+  /// Find the histogram histoname (in the what sub-directory, if any) of the current combination
+  /// among the ones already resolved. Returns 0x0 if it was not resolved yet
+
+  Int_t index = 2*fCurrentKey + ( mc ? 1 : 0 );
+
+  if ( !fHandles || index >= fHandles->GetSize() ) return 0x0;
+
+  TMap* whats = static_cast<TMap*>(fHandles->UncheckedAt(index));
+  if ( !whats ) return 0x0;
+
+  TMap* handles = static_cast<TMap*>(whats->GetValue(what));
+
+  return handles ? handles->GetValue(histoname) : 0x0;
+}
+
 //_____________________________________________________________________________
 Int_t AliAnalysisMuMuBase::GetNbins(Double_t xmin, Double_t xmax, Double_t xstep)
 {
@@ -450,7 +527,14 @@ TH1* AliAnalysisMuMuBase::Histo(const char* eventSelection,
                                 const char* histoname)
 {
   /// Get one histo back
-  return fHistogramCollection ? fHistogramCollection->Histo(Form("/%s/%s/%s",eventSelection,triggerClassName,cent),histoname) : 0x0;
+
+  Bool_t current = IsCurrentCombination(eventSelection,triggerClassName,cent);
+  TObject* o = current ? FindHandle(kFALSE,"",histoname) : 0x0;
+  if ( o ) return static_cast<TH1*>(o);
+
+  TH1* h = fHistogramCollection ? fHistogramCollection->Histo(Form("/%s/%s/%s",eventSelection,triggerClassName,cent),histoname) : 0x0;
+  if ( current ) AddHandle(kFALSE,"",histoname,h);
+  return h;
 }
 
 //_____________________________________________________________________________
@@ -462,7 +546,13 @@ TH1* AliAnalysisMuMuBase::Histo(const char* eventSelection,
 {
   /// Get one histo back
 
-  return fHistogramCollection ? fHistogramCollection->Histo(Form("/%s/%s/%s/%s",eventSelection,triggerClassName,cent,what),histoname) : 0x0;
+  Bool_t current = IsCurrentCombination(eventSelection,triggerClassName,cent);
+  TObject* o = current ? FindHandle(kFALSE,what,histoname) : 0x0;
+  if ( o ) return static_cast<TH1*>(o);
+
+  TH1* h = fHistogramCollection ? fHistogramCollection->Histo(Form("/%s/%s/%s/%s",eventSelection,triggerClassName,cent,what),histoname) : 0x0;
+  if ( current ) AddHandle(kFALSE,what,histoname,h);
+  return h;
 }
 
 //_____________________________________________________________________________
@@ -492,7 +582,13 @@ TProfile* AliAnalysisMuMuBase::Prof(const char* eventSelection,
 {
 	/// Get one histo profile back
 
-	return fHistogramCollection ? static_cast<TProfile*>(fHistogramCollection->GetObject(Form("/%s/%s/%s",eventSelection,triggerClassName,cent),histoname)) : 0x0;
+	Bool_t current = IsCurrentCombination(eventSelection,triggerClassName,cent);
+	TObject* o = current ? FindHandle(kFALSE,"",histoname) : 0x0;
+	if ( o ) return static_cast<TProfile*>(o);
+
+	o = fHistogramCollection ? fHistogramCollection->GetObject(Form("/%s/%s/%s",eventSelection,triggerClassName,cent),histoname) : 0x0;
+	if ( current ) AddHandle(kFALSE,"",histoname,o);
+	return static_cast<TProfile*>(o);
 }
 
 //_____________________________________________________________________________
@@ -504,7 +600,13 @@ TProfile* AliAnalysisMuMuBase::Prof(const char* eventSelection,
 {
 	/// Get one histo profile back
 
-	return fHistogramCollection ? static_cast<TProfile*>(fHistogramCollection->GetObject(Form("/%s/%s/%s/%s",eventSelection,triggerClassName,cent,what),histoname)) : 0x0;
+	Bool_t current = IsCurrentCombination(eventSelection,triggerClassName,cent);
+	TObject* o = current ? FindHandle(kFALSE,what,histoname) : 0x0;
+	if ( o ) return static_cast<TProfile*>(o);
+
+	o = fHistogramCollection ? fHistogramCollection->GetObject(Form("/%s/%s/%s/%s",eventSelection,triggerClassName,cent,what),histoname) : 0x0;
+	if ( current ) AddHandle(kFALSE,what,histoname,o);
+	return static_cast<TProfile*>(o);
 }
 
 //_____________________________________________________________________________
@@ -518,6 +620,8 @@ void AliAnalysisMuMuBase::Init(AliCounterCollection& cc,
   fHistogramCollection = &hc;
   fBinning             = &binning;
   fCutRegistry         = &registry;
+
+  ClearHandles();
 }
 
 //_____________________________________________________________________________
@@ -581,7 +685,14 @@ TH1* AliAnalysisMuMuBase::MCHisto(const char* eventSelection,
                                   const char* histoname)
 {
   /// Get one histo back
-  return fHistogramCollection ? fHistogramCollection->Histo(Form("/%s/%s/%s/%s",MCInputPrefix(),eventSelection,triggerClassName,cent),histoname) : 0x0;
+
+  Bool_t current = IsCurrentCombination(eventSelection,triggerClassName,cent);
+  TObject* o = current ? FindHandle(kTRUE,"",histoname) : 0x0;
+  if ( o ) return static_cast<TH1*>(o);
+
+  TH1* h = fHistogramCollection ? fHistogramCollection->Histo(Form("/%s/%s/%s/%s",MCInputPrefix(),eventSelection,triggerClassName,cent),histoname) : 0x0;
+  if ( current ) AddHandle(kTRUE,"",histoname,h);
+  return h;
 }
 
 //_____________________________________________________________________________
@@ -593,7 +704,13 @@ TH1* AliAnalysisMuMuBase::MCHisto(const char* eventSelection,
 {
   /// Get one histo back
 
-  return fHistogramCollection ? fHistogramCollection->Histo(Form("/%s/%s/%s/%s/%s",MCInputPrefix(),eventSelection,triggerClassName,cent,what),histoname) : 0x0;
+  Bool_t current = IsCurrentCombination(eventSelection,triggerClassName,cent);
+  TObject* o = current ? FindHandle(kTRUE,what,histoname) : 0x0;
+  if ( o ) return static_cast<TH1*>(o);
+
+  TH1* h = fHistogramCollection ? fHistogramCollection->Histo(Form("/%s/%s/%s/%s/%s",MCInputPrefix(),eventSelection,triggerClassName,cent,what),histoname) : 0x0;
+  if ( current ) AddHandle(kTRUE,what,histoname,h);
+  return h;
 }
 
 //_____________________________________________________________________________
@@ -623,7 +740,13 @@ TProfile* AliAnalysisMuMuBase::MCProf(const char* eventSelection,
 {
 	/// Get one histo profile back
 
-	return fHistogramCollection ? static_cast<TProfile*>(fHistogramCollection->GetObject(Form("/%s/%s/%s/%s",MCInputPrefix(),eventSelection,triggerClassName,cent),histoname)) : 0x0;
+	Bool_t current = IsCurrentCombination(eventSelection,triggerClassName,cent);
+	TObject* o = current ? FindHandle(kTRUE,"",histoname) : 0x0;
+	if ( o ) return static_cast<TProfile*>(o);
+
+	o = fHistogramCollection ? fHistogramCollection->GetObject(Form("/%s/%s/%s/%s",MCInputPrefix(),eventSelection,triggerClassName,cent),histoname) : 0x0;
+	if ( current ) AddHandle(kTRUE,"",histoname,o);
+	return static_cast<TProfile*>(o);
 }
 
 //_____________________________________________________________________________
@@ -635,7 +758,38 @@ TProfile* AliAnalysisMuMuBase::MCProf(const char* eventSelection,
 {
 	/// Get one histo profile back
 
-	return fHistogramCollection ? static_cast<TProfile*>(fHistogramCollection->GetObject(Form("/%s/%s/%s/%s/%s",MCInputPrefix(),eventSelection,triggerClassName,cent,what),histoname)) : 0x0;
+	Bool_t current = IsCurrentCombination(eventSelection,triggerClassName,cent);
+	TObject* o = current ? FindHandle(kTRUE,what,histoname) : 0x0;
+	if ( o ) return static_cast<TProfile*>(o);
+
+	o = fHistogramCollection ? fHistogramCollection->GetObject(Form("/%s/%s/%s/%s/%s",MCInputPrefix(),eventSelection,triggerClassName,cent,what),histoname) : 0x0;
+	if ( current ) AddHandle(kTRUE,what,histoname,o);
+	return static_cast<TProfile*>(o);
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::SetCurrentCombination(Int_t key, const char* eventSelection,
+                                                const char* triggerClassName, const char* centrality)
+{
+  /// Set the (eventSelection,triggerClassName,centrality) combination being filled,
+  /// identified by an integer key (unique for each combination), or -1 when no combination is being filled.
+  /// The 4 and 5 arguments Histo, MCHisto, Prof and MCProf methods called with the very same strings
+  /// search each histogram only once in the collection : the following requests use the resolved histogram.
+  /// The strings must stay valid until the next call to this method.
+
+  fCurrentKey = key;
+  fCurrentEventSelection = ( key >= 0 ) ? eventSelection : 0x0;
+  fCurrentTriggerClassName = ( key >= 0 ) ? triggerClassName : 0x0;
+  fCurrentCentrality = ( key >= 0 ) ? centrality : 0x0;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::SetHistogramCollection(AliMergeableCollection* h)
+{
+  /// Set the collection of histograms (and forget the histograms resolved in the previous one)
+
+  fHistogramCollection = h;
+  ClearHandles();
 }
 
 //_____________________________________________________________________________
@@ -23,13 +23,14 @@ class AliMCEvent;
 class TH1;
 class AliVEventHandler;
 class AliAnalysisMuMuCutRegistry;
+class TObjArray;
 
 class AliAnalysisMuMuBase : public TObject
 {
 public:
 
   AliAnalysisMuMuBase();
-  virtual ~AliAnalysisMuMuBase() {}
+  virtual ~AliAnalysisMuMuBase();
 
   /** Define the histograms needed for the path starting at eventSelection/triggerClassName/centrality.
    * This method has to ensure the histogram creation is performed only once !
@@ -101,7 +102,10 @@ public:
   Bool_t AlwaysFalse(const AliVParticle& /*particle*/, const AliVParticle& /*particle*/) const { return kFALSE; }
   void NameOfAlwaysFalse(TString& name) const { name = "NONE"; }
 
-  void SetHistogramCollection(AliMergeableCollection* h) { fHistogramCollection = h; }
+  void SetHistogramCollection(AliMergeableCollection* h);
+
+  void SetCurrentCombination(Int_t key, const char* eventSelection=0x0,
+                             const char* triggerClassName=0x0, const char* centrality=0x0);
 
 protected:
 
@@ -201,6 +205,15 @@ protected:
 
 private:
 
+  Bool_t IsCurrentCombination(const char* eventSelection, const char* triggerClassName, const char* cent) const
+  { return fCurrentKey >= 0 && eventSelection == fCurrentEventSelection && triggerClassName == fCurrentTriggerClassName && cent == fCurrentCentrality; }
+
+  TObject* FindHandle(Bool_t mc, const char* what, const char* histoname) const;
+
+  void AddHandle(Bool_t mc, const char* what, const char* histoname, TObject* o);
+
+  void ClearHandles();
+
   /// not implemented on purpose
   AliAnalysisMuMuBase& operator=(const AliAnalysisMuMuBase& rhs);
   /// not implemented on purpose
@@ -214,8 +227,13 @@ private:
   AliMCEvent* fMCEvent; //! current MC event
   TList* fHistogramToDisable; // list of regexp of histo name to disable
   Bool_t fHasMC; // whether or not we're dealing with MC data
+  Int_t fCurrentKey; //! key of the current (eventSelection,triggerClassName,centrality) combination
+  const char* fCurrentEventSelection; //! event selection of the current combination
+  const char* fCurrentTriggerClassName; //! trigger class of the current combination
+  const char* fCurrentCentrality; //! centrality of the current combination
+  TObjArray* fHandles; //! histograms already resolved, per combination key
 
-  ClassDef(AliAnalysisMuMuBase,1) // base class for a companion class to AliAnalysisMuMu
+  ClassDef(AliAnalysisMuMuBase,2) // base class for a companion class to AliAnalysisMuMu
 };
 
 #endif
@@ -90,7 +90,13 @@ fDisableHistoLoop(kFALSE),
 fLegacyCentrality(kFALSE),
 fPool(0x0),
 fMaxPoolSize(0),
-fMix(kFALSE)
+fMix(kFALSE),
+fCentralityBins(0x0),
+fCentralityEstimators(0x0),
+fCentralityNames(0x0),
+fCombinationKeys(0x0),
+fCentralityHistos(0x0),
+fNofCombinations(0)
 {
   /// Constructor with a predefined list of triggers to consider
   /// Note that we take ownership of cutRegister
@@ -134,6 +140,12 @@ AliAnalysisTaskMuMu::~AliAnalysisTaskMuMu()
   delete fCutRegistry;
 
   delete fSubAnalysisVector;
+
+  delete fCentralityBins;
+  delete fCentralityEstimators;
+  delete fCentralityNames;
+  delete fCombinationKeys;
+  delete fCentralityHistos;
 }
 
 //_____________________________________________________________________________
@@ -172,6 +184,101 @@ AliAnalysisMuMuCutRegistry* AliAnalysisTaskMuMu::CutRegistryMix() const
   return fCutRegistryMix;
 }
 
+//_____________________________________________________________________________
+TH1* AliAnalysisTaskMuMu::CentralityHisto(Int_t key, const char* eventSelection, const char* triggerClassName)
+{
+  /// Get the centrality histogram of a combination (searched in the collection only until it is found)
+
+  TH1* h = ( key < fCentralityHistos->GetSize() ) ? static_cast<TH1*>(fCentralityHistos->UncheckedAt(key)) : 0x0;
+
+  if ( !h )
+  {
+    h = fHistogramCollection->Histo(Form("/%s/%s/V0M/Centrality",eventSelection,triggerClassName));
+    if ( h ) fCentralityHistos->AddAtAndExpand(h,key);
+  }
+
+  return h;
+}
+
+//_____________________________________________________________________________
+const char* AliAnalysisTaskMuMu::CentralityName(Int_t iCentrality) const
+{
+  /// Name of a centrality range, as used in the histogram paths
+  return static_cast<TObjString*>(fCentralityNames->UncheckedAt(iCentrality))->String().Data();
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisTaskMuMu::CombinationKey(Int_t iEventSelection, const char* eventSelection,
+                                          const char* triggerClassName, Int_t iCentrality)
+{
+  /// Get the integer key of the combination eventSelection/triggerClassName/centrality range.
+  /// The first time a combination is met, the histograms of all the sub-analysis are defined for it
+
+  Int_t index = iEventSelection*fCentralityBins->GetEntriesFast() + iCentrality;
+
+  THashList* keys = ( index < fCombinationKeys->GetSize() ) ? static_cast<THashList*>(fCombinationKeys->UncheckedAt(index)) : 0x0;
+  if ( !keys )
+  {
+    keys = new THashList;
+    keys->SetOwner(kTRUE);
+    fCombinationKeys->AddAtAndExpand(keys,index);
+  }
+
+  TParameter<Int_t>* key = static_cast<TParameter<Int_t>*>(keys->FindObject(triggerClassName));
+  if ( key ) return key->GetVal();
+
+  if ( !IsHistogrammingDisabled() && !fDisableHistoLoop )
+  {
+    TIter nextAnalysis(fSubAnalysisVector);
+    AliAnalysisMuMuBase* analysis;
+
+    // Create proxy for the Histogram collections
+    while ( ( analysis = static_cast<AliAnalysisMuMuBase*>(nextAnalysis()) ) )
+    {
+      analysis->DefineHistogramCollection(eventSelection,triggerClassName,CentralityName(iCentrality),fMix);
+    }
+  }
+
+  key = new TParameter<Int_t>(triggerClassName,fNofCombinations++);
+  keys->Add(key);
+
+  return key->GetVal();
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskMuMu::CreateCentralityBins()
+{
+  /// Create (once) the centrality ranges used to fill the histograms and the pools,
+  /// together with the estimator and the name of each range
+
+  fCentralityBins = fBinning->CreateBinObjArray("centrality");
+  if ( !fCentralityBins ) fCentralityBins = new TObjArray;
+  fCentralityBins->SetOwner(kTRUE);
+
+  fCentralityEstimators = new TObjArray;
+  fCentralityEstimators->SetOwner(kTRUE);
+  fCentralityNames = new TObjArray;
+  fCentralityNames->SetOwner(kTRUE);
+
+  TIter next(fCentralityBins);
+  AliAnalysisMuMuBinning::Range* r;
+
+  while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(next()) ) ){
+
+    TString estimator = r->Quantity();
+    if(estimator.Contains("V0MPLUS05")) estimator ="V0Mplus05";
+    if(estimator.Contains("V0MMINUS05")) estimator ="V0Mminus05";
+    if ( estimator.CompareTo("pp",TString::kIgnoreCase) == 0 ) estimator = "";
+
+    fCentralityEstimators->Add(new TObjString(estimator));
+    fCentralityNames->Add(new TObjString(r->AsString()));
+  }
+
+  fCombinationKeys = new TObjArray;
+  fCombinationKeys->SetOwner(kTRUE);
+  fCentralityHistos = new TObjArray;
+}
+
 //_____________________________________________________________________________
 const char*
 AliAnalysisTaskMuMu::DefaultCentralityName() const
@@ -264,9 +371,8 @@ void AliAnalysisTaskMuMu::CreateCentralityPools( const char* poolName ) const
   /// Create pool according to binnging
 
   AliInfo( "Creating pools" );
-  TObjArray* centralities = fBinning->CreateBinObjArray("centrality");
-  if( !centralities )  return;
-  Int_t PoolSize = centralities->GetEntries();
+  if( !fCentralityBins )  return;
+  Int_t PoolSize = fCentralityBins->GetEntries();
 
   TObjArray* list = new TObjArray(PoolSize);
   list->SetOwner(kTRUE);
@@ -281,7 +387,7 @@ void AliAnalysisTaskMuMu::CreateCentralityPools( const char* poolName ) const
 }
 
 //_____________________________________________________________________________
-void AliAnalysisTaskMuMu::Fill(const char* eventSelection, const char* triggerClassName)
+void AliAnalysisTaskMuMu::Fill(const char* eventSelection, Int_t iEventSelection, const char* triggerClassName)
 {
   /// Fill one set of histograms (only called for events which pass the eventSelection cut) for a given trigger/event .
 
@@ -291,22 +397,18 @@ void AliAnalysisTaskMuMu::Fill(const char* eventSelection, const char* triggerCl
   // Fill counter collections (only for UserExec() )
   FillCounters(seventSelection.Data(), triggerClassName, "ALL", fCurrentRunNumber);
 
-  TObjArray* centralities = fBinning->CreateBinObjArray("centrality");
+  if ( !fCentralityBins ) CreateCentralityBins();
 
-  TIter next(centralities);
-  AliAnalysisMuMuBinning::Range* r;
+  for ( Int_t i = 0; i < fCentralityBins->GetEntriesFast(); ++i ){
 
-  next.Reset();
-  while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(next()) ) ){
+    AliAnalysisMuMuBinning::Range* r = static_cast<AliAnalysisMuMuBinning::Range*>(fCentralityBins->UncheckedAt(i));
+    const TString& estimator = static_cast<TObjString*>(fCentralityEstimators->UncheckedAt(i))->String();
 
     Float_t fcent     = -42.0;
-    TString estimator = r->Quantity();
-    if(estimator.Contains("V0MPLUS05")) estimator ="V0Mplus05";
-    if(estimator.Contains("V0MMINUS05")) estimator ="V0Mminus05";
     Bool_t isPP(kFALSE);
 
     // select centrality
-    if ( estimator.CompareTo("pp",TString::kIgnoreCase) == 0 ) isPP = kTRUE;
+    if ( estimator.IsNull() ) isPP = kTRUE;
     else {
       if  (fLegacyCentrality)fcent = CentralityFromCentrality(estimator.Data());
       else fcent                   = CentralityFromMultSelection(estimator.Data());
@@ -314,16 +416,16 @@ void AliAnalysisTaskMuMu::Fill(const char* eventSelection, const char* triggerCl
 
     // Fill histo
     if ( isPP || r->IsInRange(fcent) ){
-      if ( !isPP  && !r->IsInRange(fcent) ) continue;
 
-      FillHistos(eventSelection,triggerClassName,r->AsString(),fcent);
+      Int_t key = CombinationKey(iEventSelection,eventSelection,triggerClassName,i);
+
+      FillHistos(eventSelection,triggerClassName,CentralityName(i),fcent,key);
 
       // FIXME: this filling of global centrality histo is misplaced somehow...
-      TH1* hcent = fHistogramCollection->Histo(Form("/%s/%s/V0M/Centrality",eventSelection,triggerClassName));
+      TH1* hcent = CentralityHisto(key,eventSelection,triggerClassName);
       if (hcent) hcent->Fill(fcent);
     }
   }
-  delete centralities;
 }
 
 //_____________________________________________________________________________
@@ -334,12 +436,11 @@ void AliAnalysisTaskMuMu::FillPools(const char* eventSelection, const char* trig
   TString seventSelection(eventSelection);
   seventSelection.ToLower();
 
-  TObjArray* centralities = fBinning->CreateBinObjArray("centrality");
+  if ( !fCentralityBins ) CreateCentralityBins();
 
-  TIter next(centralities);
+  TIter next(fCentralityBins);
   AliAnalysisMuMuBinning::Range* r;
 
-  next.Reset();
   while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(next()) ) ){
 
     Float_t fcent     = -42.0;
@@ -360,16 +461,16 @@ void AliAnalysisTaskMuMu::FillPools(const char* eventSelection, const char* trig
       FillPoolsWithTracks(eventSelection,triggerClassName,fcent);
     }
   }
-  delete centralities;
 }
 
 //_____________________________________________________________________________
 void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
                                      const char* triggerClassName,
                                      const char* centrality,
-                                     Float_t cent)
+                                     Float_t cent,
+                                     Int_t key)
 {
-  /// Fill histograms
+  /// Fill histograms of the combination eventSelection/triggerClassName/centrality identified by key
 
   // Fill counter collections (only for UserExec() )
   FillCounters( eventSelection, triggerClassName, centrality, fCurrentRunNumber);
@@ -392,8 +493,8 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
     while ( ( analysis = static_cast<AliAnalysisMuMuBase*>(nextAnalysis()) ) )
     {
 
-      // Create proxy for the Histogram collections
-      analysis->DefineHistogramCollection(eventSelection,triggerClassName,centrality,fMix);
+      // Histograms of this combination were defined by CombinationKey(), and are resolved only once
+      analysis->SetCurrentCombination(key,eventSelection,triggerClassName,centrality);
 
       if ( MCEvent() != 0x0 )
       {
@@ -487,6 +588,8 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
           }
         }
       }
+
+      analysis->SetCurrentCombination(-1);
     }
   }
 }
@@ -600,13 +703,11 @@ TList*  AliAnalysisTaskMuMu::FindPool( Float_t cent, const char* poolName ) cons
   // define number of pools and boundary
   // in principle one could also use vertex range
 
-  if(!fPool->FindObject(poolName)) return 0x0;
+  if(!fPool->FindObject(poolName) || !fCentralityBins) return 0x0;
 
-  TObjArray* centralities = fBinning->CreateBinObjArray("centrality");
-  TIter next(centralities);
+  TIter next(fCentralityBins);
   AliAnalysisMuMuBinning::Range* r;
 
-  next.Reset();
   TList* o;
   Int_t iPool =0;
   while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(next()) ) )
@@ -922,8 +1023,11 @@ void AliAnalysisTaskMuMu::UserExec(Option_t* /*opt*/)
   while ( ( tname = static_cast<TObjString*>(next()) ) ){
     nextEventCutCombination.Reset();
 
+    Int_t iEventSelection(0);
+
     while ( ( cutCombination = static_cast<AliAnalysisMuMuCutCombination*>(nextEventCutCombination())) ){
-      if ( cutCombination->Pass(*fInputHandler) ) Fill(cutCombination->GetName(),tname->String().Data());
+      if ( cutCombination->Pass(*fInputHandler) ) Fill(cutCombination->GetName(),iEventSelection,tname->String().Data());
+      ++iEventSelection;
     }
   }
 
@@ -37,6 +37,7 @@ class AliMergeableCollection;
 class AliVParticle;
 class TList;
 class TObjArray;
+class TH1;
 class AliAnalysisMuMuBase;
 class AliAnalysisMuMuCutRegistry;
 class AliMultiInputEventHandler;
@@ -100,19 +101,27 @@ private:
                        Int_t nbinsx, Double_t xmin, Double_t xmax,
                        Int_t nbinsy=-1, Double_t ymin=0.0, Double_t ymax=0.0) const;
 
+  void CreateCentralityBins();
+
   void CreateCentralityPools(const char* poolName) const ;
 
+  const char* CentralityName(Int_t iCentrality) const;
+
+  TH1* CentralityHisto(Int_t key, const char* eventSelection, const char* triggerClassName);
+
+  Int_t CombinationKey(Int_t iEventSelection, const char* eventSelection, const char* triggerClassName, Int_t iCentrality);
+
   const char* DefaultCentralityName() const;
 
   AliVEvent* Event() const;
 
-  void FillHistos(const char* eventSelection, const char* triggerClassName, const char* centrality, Float_t cent);
+  void FillHistos(const char* eventSelection, const char* triggerClassName, const char* centrality, Float_t cent, Int_t key);
 
   void FillPoolsWithTracks(const char* eventSelection, const char* triggerClassName, Float_t cent);
 
   void FillCounters(const char* eventSelection, const char* triggerClassName, const char* centrality, Int_t currentRun);
 
-  void Fill(const char* eventSelection, const char* triggerClassName);
+  void Fill(const char* eventSelection, Int_t iEventSelection, const char* triggerClassName);
 
   void FillPools(const char* eventSelection, const char* triggerClassName);
 
@@ -174,7 +183,19 @@ private:
 
   Int_t fMaxPoolSize; // pool size
 
-  ClassDef(AliAnalysisTaskMuMu,31) // a class to analyse muon pairs (and single also ;-) )
+  TObjArray* fCentralityBins; //! centrality ranges (created once from the binning)
+
+  TObjArray* fCentralityEstimators; //! estimator of each centrality range (empty for pp)
+
+  TObjArray* fCentralityNames; //! name of each centrality range
+
+  TObjArray* fCombinationKeys; //! keys of the trigger classes already met, per event selection and centrality range
+
+  TObjArray* fCentralityHistos; //! centrality histogram of each combination key
+
+  Int_t fNofCombinations; //! number of (event selection, trigger class, centrality range) combinations already met
+
+  ClassDef(AliAnalysisTaskMuMu,32) // a class to analyse muon pairs (and single also ;-) )
 };
 
 #endif
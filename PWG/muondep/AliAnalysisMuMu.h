@@ -316,6 +316,10 @@ public:
     void SetParticleName(const char* particleName) { fParticleName = particleName; }
     void SetConfig(const AliAnalysisMuMuConfig& config);
 
+    /// Number of fits of a bin done at the same time (1 = one after the other)
+    void SetNofFitThreads(Int_t n) { fNofFitThreads = n; }
+    Int_t NofFitThreads() const { return fNofFitThreads; }
+
     static TFile* FileOpen(const char* file);
     static TString ExpandPathName(const char* file);
 
@@ -380,7 +384,9 @@ private:
 
     AliAnalysisMuMuConfig* fConfig; // configuration
 
-    ClassDef(AliAnalysisMuMu,12) // class to analysis results from AliAnalysisTaskMuMuXXX tasks
+    Int_t fNofFitThreads; // number of fits of a bin done at the same time
+
+    ClassDef(AliAnalysisMuMu,13) // class to analysis results from AliAnalysisTaskMuMuXXX tasks
 };
 
 #endif
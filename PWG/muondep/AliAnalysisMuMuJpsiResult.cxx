@@ -29,16 +29,25 @@ ClassImp(AliAnalysisMuMuJpsiResult)
 #include "TMath.h"
 #include "TMethodCall.h"
 #include "TObjArray.h"
+#include "TObjString.h"
 #include "TParameter.h"
+#include "TROOT.h"
+#include "RVersion.h"
 #include "AliAnalysisMuMuBinning.h"
 #include "AliLog.h"
 #include <map>
 #include <iostream>
+#include <vector>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,8,0)
+#include <atomic>
+#include <thread>
+#endif
 
 #include "Fit/Fitter.h"
 #include "Fit/BinData.h"
 #include "Fit/Chi2FCN.h"
 #include "Math/WrappedMultiTF1.h"
+#include "Math/MinimizerOptions.h"
 #include "HFitInterface.h"
 #include "TMinuit.h"
 #include "TCanvas.h"
@@ -105,7 +114,8 @@ fFitRejectRangeLow(TMath::Limits<Double_t>::Max()),
 fFitRejectRangeHigh(TMath::Limits<Double_t>::Max()),
 fRejectFitPoints(kFALSE),
 fParticle(""),
-fMinvRS("")
+fMinvRS(""),
+fSPsiPFactor(TMath::Limits<Double_t>::Max())
 {
 }
 
@@ -128,7 +138,8 @@ fFitRejectRangeLow(TMath::Limits<Double_t>::Max()),
 fFitRejectRangeHigh(TMath::Limits<Double_t>::Max()),
 fRejectFitPoints(kFALSE),
 fParticle(particle),
-fMinvRS("")
+fMinvRS(""),
+fSPsiPFactor(TMath::Limits<Double_t>::Max())
 {
   SetHisto(h);
 
@@ -207,7 +218,8 @@ fFitRejectRangeLow(TMath::Limits<Double_t>::Max()),
 fFitRejectRangeHigh(TMath::Limits<Double_t>::Max()),
 fRejectFitPoints(kFALSE),
 fParticle(particle),
-fMinvRS("")
+fMinvRS(""),
+fSPsiPFactor(TMath::Limits<Double_t>::Max())
 {
   SetHisto(h);
 }
@@ -229,7 +241,8 @@ fFitRejectRangeLow(rhs.fFitRejectRangeLow),
 fFitRejectRangeHigh(rhs.fFitRejectRangeHigh),
 fRejectFitPoints(rhs.fRejectFitPoints),
 fParticle(rhs.fParticle),
-fMinvRS(rhs.fMinvRS)
+fMinvRS(rhs.fMinvRS),
+fSPsiPFactor(rhs.fSPsiPFactor)
 {
   /// copy ctor
   /// Note that the mother is lost
@@ -269,6 +282,7 @@ AliAnalysisMuMuJpsiResult& AliAnalysisMuMuJpsiResult::operator=(const AliAnalysi
     fRejectFitPoints     = rhs.fRejectFitPoints;
     fParticle            = rhs.fParticle;
     fMinvRS              = rhs.fMinvRS;
+    fSPsiPFactor         = rhs.fSPsiPFactor;
 
   }
 
@@ -623,8 +637,9 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionBackgroundVWG(Double_t *x, Double
     return 0.;
   }
   else TF1::RejectPoint(kFALSE);
-  Double_t sigma = par[2]+par[3]*((x[0]-par[1])/par[1]);
-  return par[0]*TMath::Exp(-(x[0]-par[1])*(x[0]-par[1])/(2.*sigma*sigma));
+  Double_t dx = x[0]-par[1];
+  Double_t sigma = par[2]+par[3]*(dx/par[1]);
+  return par[0]*TMath::Exp(-dx*dx/(2.*sigma*sigma));
 }
 
 //____________________________________________________________________________
@@ -638,8 +653,10 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionBackgroundVWG2(Double_t *x, Doubl
     return 0.;
   }
   else TF1::RejectPoint(kFALSE);
-  Double_t sigma = par[2] + par[3]*((x[0]-par[1])/par[1]) + par[4]*((x[0]-par[1])/par[1])*((x[0]-par[1])/par[1]);
-  return par[0]*TMath::Exp(-(x[0]-par[1])*(x[0]-par[1])/(2.*sigma*sigma));
+  Double_t dx = x[0]-par[1];
+  Double_t u = dx/par[1];
+  Double_t sigma = par[2] + par[3]*u + par[4]*u*u;
+  return par[0]*TMath::Exp(-dx*dx/(2.*sigma*sigma));
 }
 
 //____________________________________________________________________________
@@ -709,7 +726,9 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionNA60New(Double_t *x,Double_t *par
   else if( t >= par[9] && t < par[10] ) sigmaRatio = 1;
   else if( t >= par[10] ) sigmaRatio = ( 1.0 + TMath::Power( par[6]*(t-par[10]), par[7]-par[8]*TMath::Sqrt(t - par[10]) ) );
 
-  return par[0]*TMath::Exp( -(1/2.)*TMath::Power(t/sigmaRatio,2.));
+  const Double_t u = t/sigmaRatio;
+
+  return par[0]*TMath::Exp( -(1/2.)*u*u);
 
 }
 
@@ -719,7 +738,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoNA60NewVWG(Double_t *x, D
   /// 2 NA60 (new) + pol2 x exp
   /// width of the second NA60 related to the first (free) one.
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[11] = {
     par[15],
@@ -743,7 +762,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoNA60NewVWG2(Double_t *x,
   /// 2 NA60 (new) + pol2 x exp
   /// width of the second NA60 related to the first (free) one.
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[11] = {
     par[16],
@@ -767,7 +786,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoNA60NewPol1Pol2(Double_t
   /// 2 NA60 (new) + pol2 x exp
   /// width of the second NA60 related to the first (free) one.
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[11] = {
     par[16],
@@ -791,7 +810,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoNA60NewPol2Pol3(Double_t
   /// 2 NA60 (new) + pol2 x exp
   /// width of the second NA60 related to the first (free) one.
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[11] = {
     par[18],
@@ -815,7 +834,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoNA60NewPol2Exp(Double_t *
   /// 2 NA60 (new) + pol2 x exp
   /// width of the second NA60 related to the first (free) one.
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[11] = {
     par[15],
@@ -840,7 +859,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoNA60NewPol4Exp(Double_t *
   /// 2 NA60 (new) + pol4 x exp
   /// width of the second NA60 related to the first (free) one.
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[11] = {
     par[17],
@@ -864,7 +883,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoCB2Lin(Double_t *x, Doubl
   /// 2 extended crystal balls + Pol1
   /// width of the second CB related to the first (free) one.
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[7] = {
     par[9],
@@ -884,7 +903,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoCB2Pol1Pol2(Double_t *x,
   /// 2 extended crystal balls + Pol1
   /// width of the second CB related to the first (free) one.
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[7] = {
     par[12],
@@ -904,7 +923,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoCB2Pol2Pol3(Double_t *x,
   /// 2 extended crystal balls + Pol1
   /// width of the second CB related to the first (free) one.
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[7] = {
     par[14],
@@ -924,7 +943,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoCB2Pol2Pol3V2(Double_t *x
   /// 2 extended crystal balls + Pol2/pol3
   /// width of the second CB related to the first (free) one.
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[7] = {
     par[13],
@@ -944,7 +963,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoCB2Pol2Exp(Double_t *x, D
   /// 2 extended crystal balls + pol2 x exp
   /// width of the second CB related to the first (free) one.
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[7] = {
     par[11],
@@ -982,7 +1001,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoCB2Pol4Exp(Double_t *x, D
   /// 2 extended crystal balls + pol4 x exp
   /// width of the second CB related to the first (free) one.
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[7] = {
     par[13],
@@ -1020,7 +1039,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoCB2VWG(Double_t *x, Doubl
   /// 2 extended crystal balls + VWG
   /// width of the second CB related to the first (free) one.
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[7] = {
     par[11],
@@ -1040,7 +1059,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoCB2VWG2(Double_t *x, Doub
   /// 2 extended crystal balls + VWG2
   /// width of the second CB related to the first (free) one.
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[7] = {
     par[12],
@@ -1060,7 +1079,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoCB2VWGINDEPTAILS(Double_t
   /// 2 extended crystal balls + pol2 x exp
   /// The tail parameters are independent but the sPsiP and mPsiP are fixed to the one of the JPsi
 
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[7] = {
     par[11],
@@ -1085,70 +1104,81 @@ Double_t AliAnalysisMuMuJpsiResult::hFunction(Double_t*x, Double_t* par)
 //------------------------------------------------------------------------------
 Double_t AliAnalysisMuMuJpsiResult::alphaCB2VWG(Double_t*x, Double_t* par)
 {
-  return FitFunctionSignalCrystalBallExtended(x, &par[4])/(FitFunctionSignalCrystalBallExtended(x, &par[4]) + FitFunctionBackgroundVWG(x,par));
+  Double_t signal = FitFunctionSignalCrystalBallExtended(x, &par[4]);
+  return signal/(signal + FitFunctionBackgroundVWG(x,par));
 }
 //------------------------------------------------------------------------------
 Double_t AliAnalysisMuMuJpsiResult::alphaCB2VWG2(Double_t*x, Double_t* par)
 {
-  return FitFunctionSignalCrystalBallExtended(x, &par[5])/(FitFunctionSignalCrystalBallExtended(x, &par[5]) + FitFunctionBackgroundVWG2(x,par));
+  Double_t signal = FitFunctionSignalCrystalBallExtended(x, &par[5]);
+  return signal/(signal + FitFunctionBackgroundVWG2(x,par));
 }
 //------------------------------------------------------------------------------
 Double_t AliAnalysisMuMuJpsiResult::alphaCB2POL1POL2(Double_t*x, Double_t* par)
 {
-  return FitFunctionSignalCrystalBallExtended(x, &par[5])/(FitFunctionSignalCrystalBallExtended(x, &par[5]) + FitFunctionBackgroundPol1Pol2(x,par));
+  Double_t signal = FitFunctionSignalCrystalBallExtended(x, &par[5]);
+  return signal/(signal + FitFunctionBackgroundPol1Pol2(x,par));
 }
 //------------------------------------------------------------------------------
 Double_t AliAnalysisMuMuJpsiResult::alphaCB2POL2POL3(Double_t*x, Double_t* par)
 {
-  return FitFunctionSignalCrystalBallExtended(x, &par[7])/(FitFunctionSignalCrystalBallExtended(x, &par[7]) + FitFunctionBackgroundPol2Pol3(x,par));
+  Double_t signal = FitFunctionSignalCrystalBallExtended(x, &par[7]);
+  return signal/(signal + FitFunctionBackgroundPol2Pol3(x,par));
 }
 //------------------------------------------------------------------------------
 Double_t AliAnalysisMuMuJpsiResult::alphaCB2POL2EXP(Double_t*x, Double_t* par)
 {
-  return FitFunctionSignalCrystalBallExtended(x, &par[4])/(FitFunctionSignalCrystalBallExtended(x, &par[4]) + FitFunctionBackgroundPol2Exp(x,par));
+  Double_t signal = FitFunctionSignalCrystalBallExtended(x, &par[4]);
+  return signal/(signal + FitFunctionBackgroundPol2Exp(x,par));
 }
 
 //------------------------------------------------------------------------------
 Double_t AliAnalysisMuMuJpsiResult::alphaNA60NEWVWG(Double_t*x, Double_t* par)
 {
-  return FitFunctionNA60New(x, &par[4])/(FitFunctionNA60New(x, &par[4]) + FitFunctionBackgroundVWG(x,par));
+  Double_t signal = FitFunctionNA60New(x, &par[4]);
+  return signal/(signal + FitFunctionBackgroundVWG(x,par));
 }
 
 //------------------------------------------------------------------------------
 Double_t AliAnalysisMuMuJpsiResult::alphaNA60NEWPOL1POL2(Double_t*x, Double_t* par)
 {
-  return FitFunctionNA60New(x, &par[5])/(FitFunctionNA60New(x, &par[5]) + FitFunctionBackgroundPol1Pol2(x,par));
+  Double_t signal = FitFunctionNA60New(x, &par[5]);
+  return signal/(signal + FitFunctionBackgroundPol1Pol2(x,par));
 }
 
 //------------------------------------------------------------------------------
 Double_t AliAnalysisMuMuJpsiResult::alphaNA60NEWPOL2EXP(Double_t*x, Double_t* par)
 {
-  return FitFunctionNA60New(x, &par[4])/(FitFunctionNA60New(x, &par[4]) + FitFunctionBackgroundPol2Exp(x,par));
+  Double_t signal = FitFunctionNA60New(x, &par[4]);
+  return signal/(signal + FitFunctionBackgroundPol2Exp(x,par));
 }
 //------------------------------------------------------------------------------
 Double_t AliAnalysisMuMuJpsiResult::alphaNA60NEWVWG2(Double_t*x, Double_t* par)
 {
-  return FitFunctionNA60New(x, &par[5])/(FitFunctionNA60New(x, &par[5]) + FitFunctionBackgroundVWG2(x,par));
+  Double_t signal = FitFunctionNA60New(x, &par[5]);
+  return signal/(signal + FitFunctionBackgroundVWG2(x,par));
 }
 
 //------------------------------------------------------------------------------
 Double_t AliAnalysisMuMuJpsiResult::alphaNA60NEWPOL2POL3(Double_t*x, Double_t* par)
 {
-  return FitFunctionNA60New(x, &par[7])/(FitFunctionNA60New(x, &par[7]) + FitFunctionBackgroundPol2Pol3(x,par));
+  Double_t signal = FitFunctionNA60New(x, &par[7]);
+  return signal/(signal + FitFunctionBackgroundPol2Pol3(x,par));
 }
 
 //------------------------------------------------------------------------------
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2Lin(Double_t* x, Double_t* par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi
-  return alphaCB2VWG(x,par)*par[12] + (1. - alphaCB2VWG(x,par))*FitFunctionBackgroundPol2(x,&par[13]);
+  Double_t alpha = alphaCB2VWG(x,par);
+  return alpha*par[12] + (1. - alpha)*FitFunctionBackgroundPol2(x,&par[13]);
 }
 
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2Lin(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[11] = {
     par[0],
@@ -1165,7 +1195,9 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2Lin(Double_t *x, Doubl
   };
 
 
-  return alphaCB2VWG(x,par)*par[12] + alphaCB2VWG(x,par2)*par[15] + (1. - alphaCB2VWG(x,par) - alphaCB2VWG(x,par2))*FitFunctionBackgroundPol2(x,&par[13]);
+  Double_t alpha1 = alphaCB2VWG(x,par);
+  Double_t alpha2 = alphaCB2VWG(x,par2);
+  return alpha1*par[12] + alpha2*par[15] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2(x,&par[13]);
 }
 
 
@@ -1174,21 +1206,24 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2VWGPOL2(Double_t* x, Do
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi
   AliDebug(2,Form("pol2 parameters in FitFunctionMeanPtSCB2VWGPOL2 : %f,%f,%f",par[13],par[14],par[15]));
-  return alphaCB2VWG(x,par)*par[12] + (1. - alphaCB2VWG(x,par))*FitFunctionBackgroundPol2(x,&par[13]);
+  Double_t alpha = alphaCB2VWG(x,par);
+  return alpha*par[12] + (1. - alpha)*FitFunctionBackgroundPol2(x,&par[13]);
 }
 //------------------------------------------------------------------------------
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2VWG2POL2(Double_t* x, Double_t* par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi
   AliDebug(2,Form("pol2 parameters in FitFunctionMeanPtSCB2VWG2POL2 : %f,%f,%f",par[14],par[15],par[16]));
-  return alphaCB2VWG2(x,par)*par[13] + (1. - alphaCB2VWG2(x,par))*FitFunctionBackgroundPol2(x,&par[14]);
+  Double_t alpha = alphaCB2VWG2(x,par);
+  return alpha*par[13] + (1. - alpha)*FitFunctionBackgroundPol2(x,&par[14]);
 }
 //------------------------------------------------------------------------------
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2VWG2POLEXP(Double_t* x, Double_t* par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi
   AliDebug(2,Form("pol2 parameters in FitFunctionMeanPtSCB2VWG2POL2 : %f,%f,%f",par[14],par[15],par[16]));
-  return alphaCB2VWG2(x,par)*par[13] + (1. - alphaCB2VWG2(x,par))*FitFunctionBackgroundPolExp(x,&par[14]);
+  Double_t alpha = alphaCB2VWG2(x,par);
+  return alpha*par[13] + (1. - alpha)*FitFunctionBackgroundPolExp(x,&par[14]);
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2VWG2POL2EXP(Double_t *x, Double_t *par)
@@ -1196,7 +1231,8 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2VWG2POL2EXP(Double_t *x
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi
   AliDebug(2,Form("pol2 parameters in FitFunctionMeanPtSCB2VWG2POL2EXP : %f,%f,%f,%f",par[14],par[15],par[16],par[17]));
 
-  return alphaCB2VWG2(x,par)*par[13] + (1. - alphaCB2VWG2(x,par))*FitFunctionBackgroundPol2Exp(x,&par[14]);
+  Double_t alpha = alphaCB2VWG2(x,par);
+  return alpha*par[13] + (1. - alpha)*FitFunctionBackgroundPol2Exp(x,&par[14]);
 }
 
 //____________________________________________________________________________
@@ -1205,7 +1241,8 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2VWG2POL4(Double_t *x, D
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi
   AliDebug(2,Form("pol2 parameters in FitFunctionMeanPtSCB2VWG2POL4 : %f,%f,%f,%f,%f",par[14],par[15],par[16],par[17],par[18]));
 
-  return alphaCB2VWG2(x,par)*par[13] + (1. - alphaCB2VWG2(x,par))*FitFunctionBackgroundPol4(x,&par[14]);
+  Double_t alpha = alphaCB2VWG2(x,par);
+  return alpha*par[13] + (1. - alpha)*FitFunctionBackgroundPol4(x,&par[14]);
 }
 
 //____________________________________________________________________________
@@ -1214,7 +1251,8 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2VWG2POL4Cheb(Double_t *
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi
   AliDebug(2,Form("pol2 parameters in FitFunctionMeanPtSCB2VWG2POL4Cheb : %f,%f,%f,%f,%f",par[14],par[15],par[16],par[17],par[18]));
 
-  return alphaCB2VWG2(x,par)*par[13] + (1. - alphaCB2VWG2(x,par))*FitFunctionBackgroundPol4Cheb(x,&par[14]);
+  Double_t alpha = alphaCB2VWG2(x,par);
+  return alpha*par[13] + (1. - alpha)*FitFunctionBackgroundPol4Cheb(x,&par[14]);
 }
 
 //____________________________________________________________________________
@@ -1223,7 +1261,8 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2POL2POL3POL2(Double_t *
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi
   AliDebug(2,Form("pol2 parameters in FitFunctionMeanPtSCB2POL2POL3POL2 : %f,%f,%f",par[16],par[17],par[18]));
 
-  return alphaCB2POL2POL3(x,par)*par[15] + (1. - alphaCB2POL2POL3(x,par))*FitFunctionBackgroundPol2(x,&par[16]);
+  Double_t alpha = alphaCB2POL2POL3(x,par);
+  return alpha*par[15] + (1. - alpha)*FitFunctionBackgroundPol2(x,&par[16]);
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2POL2POL3_POLEXP(Double_t *x, Double_t *par)
@@ -1231,7 +1270,8 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2POL2POL3_POLEXP(Double_
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi
   AliDebug(2,Form("pol2 parameters in FitFunctionMeanPtSCB2POL2POL3POL2 : %f,%f,%f",par[16],par[17],par[18]));
 
-  return alphaCB2POL2POL3(x,par)*par[15] + (1. - alphaCB2POL2POL3(x,par))*FitFunctionBackgroundPolExp(x,&par[16]);
+  Double_t alpha = alphaCB2POL2POL3(x,par);
+  return alpha*par[15] + (1. - alpha)*FitFunctionBackgroundPolExp(x,&par[16]);
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2POL2POL3POL2EXP(Double_t *x, Double_t *par)
@@ -1239,7 +1279,8 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2POL2POL3POL2EXP(Double_
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi
   AliDebug(2,Form("pol2exp parameters in FitFunctionMeanPtSCB2POL2POL3POL2EXP : %f,%f,%f,%f",par[16],par[17],par[18],par[19]));
 
-  return alphaCB2POL2POL3(x,par)*par[15] + (1. - alphaCB2POL2POL3(x,par))*FitFunctionBackgroundPol2Exp(x,&par[16]);
+  Double_t alpha = alphaCB2POL2POL3(x,par);
+  return alpha*par[15] + (1. - alpha)*FitFunctionBackgroundPol2Exp(x,&par[16]);
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2POL2POL3POL4(Double_t *x, Double_t *par)
@@ -1247,7 +1288,8 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2POL2POL3POL4(Double_t *
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi
   AliDebug(2,Form("pol4 parameters in FitFunctionMeanPtSCB2POL2POL3POL4 : %f,%f,%f,%f,%f",par[16],par[17],par[18],par[19],par[20]));
 
-  return alphaCB2POL2POL3(x,par)*par[15] + (1. - alphaCB2POL2POL3(x,par))*FitFunctionBackgroundPol4(x,&par[16]);
+  Double_t alpha = alphaCB2POL2POL3(x,par);
+  return alpha*par[15] + (1. - alpha)*FitFunctionBackgroundPol4(x,&par[16]);
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2POL2POL3POL4Cheb(Double_t *x, Double_t *par)
@@ -1255,13 +1297,14 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSCB2POL2POL3POL4Cheb(Double
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi
   AliDebug(2,Form("pol4 parameters in FitFunctionMeanPtSCB2POL2POL3POL4 : %f,%f,%f,%f,%f",par[16],par[17],par[18],par[19],par[20]));
 
-  return alphaCB2POL2POL3(x,par)*par[15] + (1. - alphaCB2POL2POL3(x,par))*FitFunctionBackgroundPol4Cheb(x,&par[16]);
+  Double_t alpha = alphaCB2POL2POL3(x,par);
+  return alpha*par[15] + (1. - alpha)*FitFunctionBackgroundPol4Cheb(x,&par[16]);
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2VWGPOL2(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[11] = {
     par[0],
@@ -1278,14 +1321,16 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2VWGPOL2(Double_t *x, D
   };
 
 
-  return alphaCB2VWG(x,par)*par[12] + alphaCB2VWG(x,par2)*par[16] + (1. - alphaCB2VWG(x,par) - alphaCB2VWG(x,par2))*FitFunctionBackgroundPol2(x,&par[13]);
+  Double_t alpha1 = alphaCB2VWG(x,par);
+  Double_t alpha2 = alphaCB2VWG(x,par2);
+  return alpha1*par[12] + alpha2*par[16] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2(x,&par[13]);
 }
 
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2POL1POL2POL2(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[12] = {
     par[0],
@@ -1303,14 +1348,16 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2POL1POL2POL2(Double_t
   };
 
 
-  return alphaCB2POL1POL2(x,par)*par[13] + alphaCB2POL1POL2(x,par2)*par[17] + (1. - alphaCB2POL1POL2(x,par) - alphaCB2POL1POL2(x,par2))*FitFunctionBackgroundPol2(x,&par[14]);
+  Double_t alpha1 = alphaCB2POL1POL2(x,par);
+  Double_t alpha2 = alphaCB2POL1POL2(x,par2);
+  return alpha1*par[13] + alpha2*par[17] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2(x,&par[14]);
 }
 
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2VWGPOL2EXP(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[11] = {
     par[0],
@@ -1327,14 +1374,16 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2VWGPOL2EXP(Double_t *x
   };
 
 
-  return alphaCB2VWG(x,par)*par[12] + alphaCB2VWG(x,par2)*par[17] + (1. - alphaCB2VWG(x,par) - alphaCB2VWG(x,par2))*FitFunctionBackgroundPol2Exp(x,&par[13]);
+  Double_t alpha1 = alphaCB2VWG(x,par);
+  Double_t alpha2 = alphaCB2VWG(x,par2);
+  return alpha1*par[12] + alpha2*par[17] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2Exp(x,&par[13]);
 }
 
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2POL1POL2POL2EXP(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[12] = {
     par[0],
@@ -1352,14 +1401,16 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2POL1POL2POL2EXP(Double
   };
 
 
-  return alphaCB2POL1POL2(x,par)*par[13] + alphaCB2POL1POL2(x,par2)*par[18] + (1. - alphaCB2POL1POL2(x,par) - alphaCB2POL1POL2(x,par2))*FitFunctionBackgroundPol2Exp(x,&par[14]);
+  Double_t alpha1 = alphaCB2POL1POL2(x,par);
+  Double_t alpha2 = alphaCB2POL1POL2(x,par2);
+  return alpha1*par[13] + alpha2*par[18] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2Exp(x,&par[14]);
 }
 
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2POL2EXPPOL2(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[11] = {
     par[0],
@@ -1376,7 +1427,9 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2POL2EXPPOL2(Double_t *
   };
 
 
-  return alphaCB2POL2EXP(x,par)*par[12] + alphaCB2POL2EXP(x,par2)*par[16] + (1. - alphaCB2POL2EXP(x,par) - alphaCB2POL2EXP(x,par2))*FitFunctionBackgroundPol2(x,&par[13]);
+  Double_t alpha1 = alphaCB2POL2EXP(x,par);
+  Double_t alpha2 = alphaCB2POL2EXP(x,par2);
+  return alpha1*par[12] + alpha2*par[16] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2(x,&par[13]);
 
 }
 
@@ -1384,7 +1437,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2POL2EXPPOL2(Double_t *
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2POL2EXPPOL2EXP(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[11] = {
     par[0],
@@ -1401,7 +1454,9 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2POL2EXPPOL2EXP(Double_
   };
 
 
-  return alphaCB2POL2EXP(x,par)*par[12] + alphaCB2POL2EXP(x,par2)*par[17] + (1. - alphaCB2POL2EXP(x,par) - alphaCB2POL2EXP(x,par2))*FitFunctionBackgroundPol2Exp(x,&par[13]);
+  Double_t alpha1 = alphaCB2POL2EXP(x,par);
+  Double_t alpha2 = alphaCB2POL2EXP(x,par2);
+  return alpha1*par[12] + alpha2*par[17] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2Exp(x,&par[13]);
 
 }
 
@@ -1409,7 +1464,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2POL2EXPPOL2EXP(Double_
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2NA60NEWVWGPOL2(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[15] = {
     par[0],
@@ -1429,76 +1484,88 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2NA60NEWVWGPOL2(Double_t *
     par[14],
   };
 
-  return alphaNA60NEWVWG(x,par)*par[16] + alphaNA60NEWVWG(x,par2)*par[20] + (1. - alphaNA60NEWVWG(x,par) - alphaNA60NEWVWG(x,par2))*FitFunctionBackgroundPol2(x,&par[17]);
+  Double_t alpha1 = alphaNA60NEWVWG(x,par);
+  Double_t alpha2 = alphaNA60NEWVWG(x,par2);
+  return alpha1*par[16] + alpha2*par[20] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2(x,&par[17]);
 
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSNA60NEWVWG2POLEXP(Double_t *x, Double_t *par)
 {
  AliDebug(2,Form("pol2 parameters in FitFunctionMeanPtSNA60NEWVWG2POLEXP : %f,%f,%f",par[18],par[19],par[20]));
-  return alphaNA60NEWVWG2(x,par)*par[17] + (1. - alphaNA60NEWVWG2(x,par))*FitFunctionBackgroundPolExp(x,&par[18]);
+  Double_t alpha = alphaNA60NEWVWG2(x,par);
+  return alpha*par[17] + (1. - alpha)*FitFunctionBackgroundPolExp(x,&par[18]);
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSNA60NEWVWG2POL2(Double_t *x, Double_t *par)
 {
  AliDebug(2,Form("pol2 parameters in FitFunctionMeanPtSNA60NEWVWG2POL2 : %f,%f,%f",par[18],par[19],par[20]));
-  return alphaNA60NEWVWG2(x,par)*par[17] + (1. - alphaNA60NEWVWG2(x,par))*FitFunctionBackgroundPol2(x,&par[18]);
+  Double_t alpha = alphaNA60NEWVWG2(x,par);
+  return alpha*par[17] + (1. - alpha)*FitFunctionBackgroundPol2(x,&par[18]);
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSNA60NEWVWG2POL2EXP(Double_t *x, Double_t *par)
 {
  AliDebug(2,Form("pol2exp parameters in FitFunctionMeanPtSNA60NEWVWG2POL2EXP : %f,%f,%f,%f",par[18],par[19],par[20],par[21]));
-  return alphaNA60NEWVWG2(x,par)*par[17] + (1. - alphaNA60NEWVWG2(x,par))*FitFunctionBackgroundPol2Exp(x,&par[18]);
+  Double_t alpha = alphaNA60NEWVWG2(x,par);
+  return alpha*par[17] + (1. - alpha)*FitFunctionBackgroundPol2Exp(x,&par[18]);
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSNA60NEWVWG2POL4(Double_t *x, Double_t *par)
 {
  AliDebug(2,Form("pol4 parameters in FitFunctionMeanPtSNA60NEWVWG2POL4 : %f,%f,%f,%f,%f",par[18],par[19],par[20],par[21],par[22]));
-  return alphaNA60NEWVWG2(x,par)*par[17] + (1. - alphaNA60NEWVWG2(x,par))*FitFunctionBackgroundPol4(x,&par[18]);
+  Double_t alpha = alphaNA60NEWVWG2(x,par);
+  return alpha*par[17] + (1. - alpha)*FitFunctionBackgroundPol4(x,&par[18]);
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSNA60NEWVWG2POL4Cheb(Double_t *x, Double_t *par)
 {
  AliDebug(2,Form("pol4 parameters in FitFunctionMeanPtSNA60NEWVWG2POL4 : %f,%f,%f,%f,%f",par[18],par[19],par[20],par[21],par[22]));
-  return alphaNA60NEWVWG2(x,par)*par[17] + (1. - alphaNA60NEWVWG2(x,par))*FitFunctionBackgroundPol4Cheb(x,&par[18]);
+  Double_t alpha = alphaNA60NEWVWG2(x,par);
+  return alpha*par[17] + (1. - alpha)*FitFunctionBackgroundPol4Cheb(x,&par[18]);
 }
 
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSNA60NEWPOL2POL3_POLEXP(Double_t *x, Double_t *par)
 {
  AliDebug(2,Form("pol2 parameters in FitFunctionMeanPtSNA60NEWPOL2POL3_POLEXP : %f,%f,%f",par[20],par[21],par[22]));
-  return alphaNA60NEWPOL2POL3(x,par)*par[19] + (1. - alphaNA60NEWPOL2POL3(x,par))*FitFunctionBackgroundPolExp(x,&par[20]);
+  Double_t alpha = alphaNA60NEWPOL2POL3(x,par);
+  return alpha*par[19] + (1. - alpha)*FitFunctionBackgroundPolExp(x,&par[20]);
 }
 
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSNA60NEWPOL2POL3POL2(Double_t *x, Double_t *par)
 {
  AliDebug(2,Form("pol2 parameters in FitFunctionMeanPtSNA60NEWPOL2POL3POL2 : %f,%f,%f",par[20],par[21],par[22]));
-  return alphaNA60NEWPOL2POL3(x,par)*par[19] + (1. - alphaNA60NEWPOL2POL3(x,par))*FitFunctionBackgroundPol2(x,&par[20]);
+  Double_t alpha = alphaNA60NEWPOL2POL3(x,par);
+  return alpha*par[19] + (1. - alpha)*FitFunctionBackgroundPol2(x,&par[20]);
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSNA60NEWPOL2POL3POL2EXP(Double_t *x, Double_t *par)
 {
  AliDebug(2,Form("pol2exp parameters in FitFunctionMeanPtSNA60NEWPOL2POL3POL2EXP : %f,%f,%f,%f",par[20],par[21],par[22],par[23]));
-  return alphaNA60NEWPOL2POL3(x,par)*par[19] + (1. - alphaNA60NEWPOL2POL3(x,par))*FitFunctionBackgroundPol2Exp(x,&par[20]);
+  Double_t alpha = alphaNA60NEWPOL2POL3(x,par);
+  return alpha*par[19] + (1. - alpha)*FitFunctionBackgroundPol2Exp(x,&par[20]);
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSNA60NEWPOL2POL3POL4(Double_t *x, Double_t *par)
 {
  AliDebug(2,Form("pol4 parameters in FitFunctionMeanPtSNA60NEWPOL2POL3POL4 : %f,%f,%f,%f,%f",par[20],par[21],par[22],par[23],par[24]));
-  return alphaNA60NEWPOL2POL3(x,par)*par[19] + (1. - alphaNA60NEWPOL2POL3(x,par))*FitFunctionBackgroundPol4(x,&par[20]);
+  Double_t alpha = alphaNA60NEWPOL2POL3(x,par);
+  return alpha*par[19] + (1. - alpha)*FitFunctionBackgroundPol4(x,&par[20]);
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtSNA60NEWPOL2POL3POL4Cheb(Double_t *x, Double_t *par)
 {
  AliDebug(2,Form("pol4 parameters in FitFunctionMeanPtSNA60NEWPOL2POL3POL4 : %f,%f,%f,%f,%f",par[20],par[21],par[22],par[23],par[24]));
-  return alphaNA60NEWPOL2POL3(x,par)*par[19] + (1. - alphaNA60NEWPOL2POL3(x,par))*FitFunctionBackgroundPol4Cheb(x,&par[20]);
+  Double_t alpha = alphaNA60NEWPOL2POL3(x,par);
+  return alpha*par[19] + (1. - alpha)*FitFunctionBackgroundPol4Cheb(x,&par[20]);
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2NA60NEWVWGPOL2EXP(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[15] = {
     par[0],
@@ -1519,14 +1586,16 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2NA60NEWVWGPOL2EXP(Double_
   };
 
 
-  return alphaNA60NEWVWG(x,par)*par[16] + alphaNA60NEWVWG(x,par2)*par[21] + (1. - alphaNA60NEWVWG(x,par) - alphaNA60NEWVWG(x,par2))*FitFunctionBackgroundPol2Exp(x,&par[17]);
+  Double_t alpha1 = alphaNA60NEWVWG(x,par);
+  Double_t alpha2 = alphaNA60NEWVWG(x,par2);
+  return alpha1*par[16] + alpha2*par[21] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2Exp(x,&par[17]);
 
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2NA60NEWPOL1POL2POL2(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[16] = {
     par[0],//a
@@ -1547,14 +1616,16 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2NA60NEWPOL1POL2POL2(Doubl
     par[15],
   };
 
-  return alphaNA60NEWPOL1POL2(x,par)*par[17] + alphaNA60NEWPOL1POL2(x,par2)*par[21] + (1. - alphaNA60NEWPOL1POL2(x,par) - alphaNA60NEWPOL1POL2(x,par2))*FitFunctionBackgroundPol2(x,&par[18]);
+  Double_t alpha1 = alphaNA60NEWPOL1POL2(x,par);
+  Double_t alpha2 = alphaNA60NEWPOL1POL2(x,par2);
+  return alpha1*par[17] + alpha2*par[21] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2(x,&par[18]);
 
 }
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2NA60NEWPOL1POL2POL2EXP(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[16] = {
     par[0],
@@ -1576,7 +1647,9 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2NA60NEWPOL1POL2POL2EXP(Do
   };
 
 
-  return alphaNA60NEWPOL1POL2(x,par)*par[17] + alphaNA60NEWPOL1POL2(x,par2)*par[22] + (1. - alphaNA60NEWPOL1POL2(x,par) - alphaNA60NEWPOL1POL2(x,par2))*FitFunctionBackgroundPol2Exp(x,&par[18]);
+  Double_t alpha1 = alphaNA60NEWPOL1POL2(x,par);
+  Double_t alpha2 = alphaNA60NEWPOL1POL2(x,par2);
+  return alpha1*par[17] + alpha2*par[22] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2Exp(x,&par[18]);
 
 }
 
@@ -1584,7 +1657,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2NA60NEWPOL1POL2POL2EXP(Do
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2NA60NEWPOL2EXPPOL2(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[15] = {
     par[0],
@@ -1604,7 +1677,9 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2NA60NEWPOL2EXPPOL2(Double
     par[14],
   };
 
-  return alphaNA60NEWPOL2EXP(x,par)*par[16] + alphaNA60NEWPOL2EXP(x,par2)*par[20] + (1. - alphaNA60NEWPOL2EXP(x,par) - alphaNA60NEWPOL2EXP(x,par2))*FitFunctionBackgroundPol2(x,&par[17]);
+  Double_t alpha1 = alphaNA60NEWPOL2EXP(x,par);
+  Double_t alpha2 = alphaNA60NEWPOL2EXP(x,par2);
+  return alpha1*par[16] + alpha2*par[20] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2(x,&par[17]);
 
 }
 
@@ -1612,7 +1687,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2NA60NEWPOL2EXPPOL2(Double
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2NA60NEWPOL2EXPPOL2EXP(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[15] = {
     par[0],
@@ -1632,7 +1707,9 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2NA60NEWPOL2EXPPOL2EXP(Dou
     par[14],
   };
 
-  return alphaNA60NEWPOL2EXP(x,par)*par[16] + alphaNA60NEWPOL2EXP(x,par2)*par[21] + (1. - alphaNA60NEWPOL2EXP(x,par) - alphaNA60NEWPOL2EXP(x,par2))*FitFunctionBackgroundPol2Exp(x,&par[17]);
+  Double_t alpha1 = alphaNA60NEWPOL2EXP(x,par);
+  Double_t alpha2 = alphaNA60NEWPOL2EXP(x,par2);
+  return alpha1*par[16] + alpha2*par[21] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2Exp(x,&par[17]);
 
 }
 
@@ -1654,7 +1731,7 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtHFunction(Double_t *x, Doub
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2VWGPOL3(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[11] = {
     par[0],
@@ -1671,14 +1748,16 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2VWGPOL3(Double_t *x, D
   };
 
 
-  return alphaCB2VWG(x,par)*par[12] + alphaCB2VWG(x,par2)*par[17] + (1. - alphaCB2VWG(x,par) - alphaCB2VWG(x,par2))*FitFunctionBackgroundPol2(x,&par[13]);
+  Double_t alpha1 = alphaCB2VWG(x,par);
+  Double_t alpha2 = alphaCB2VWG(x,par2);
+  return alpha1*par[12] + alpha2*par[17] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2(x,&par[13]);
 }
 
 //____________________________________________________________________________
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2VWGPOL4(Double_t *x, Double_t *par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[11] = {
     par[0],
@@ -1695,14 +1774,16 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2VWGPOL4(Double_t *x, D
   };
 
 
-  return alphaCB2VWG(x,par)*par[12] + alphaCB2VWG(x,par2)*par[18] + (1. - alphaCB2VWG(x,par) - alphaCB2VWG(x,par2))*FitFunctionBackgroundPol4(x,&par[13]);
+  Double_t alpha1 = alphaCB2VWG(x,par);
+  Double_t alpha2 = alphaCB2VWG(x,par2);
+  return alpha1*par[12] + alpha2*par[18] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol4(x,&par[13]);
 }
 
 //------------------------------------------------------------------------------
 Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2VWGPOL2INDEPTAILS(Double_t* x, Double_t* par)
 {
   // Fit function for Jpsi(Psip) mean pt with alphaJpsi and alphaPsiP with independent tails
-  Double_t SPsiPFactor = GetValue(kKeySPsiP);
+  Double_t SPsiPFactor = GetSPsiPFactor();
 
   Double_t par2[11] = {
     par[0],
@@ -1718,7 +1799,9 @@ Double_t AliAnalysisMuMuJpsiResult::FitFunctionMeanPtS2CB2VWGPOL2INDEPTAILS(Doub
     par[15]
   };
 
-  return alphaCB2VWG(x,par)*par[16] + alphaCB2VWG(x,par2)*par[20] + (1. - alphaCB2VWG(x,par) - alphaCB2VWG(x,par2))*FitFunctionBackgroundPol2(x,&par[17]);
+  Double_t alpha1 = alphaCB2VWG(x,par);
+  Double_t alpha2 = alphaCB2VWG(x,par2);
+  return alpha1*par[16] + alpha2*par[20] + (1. - alpha1 - alpha2)*FitFunctionBackgroundPol2(x,&par[17]);
 }
 
 //_____________________________________________________________________________
@@ -12509,7 +12592,107 @@ Bool_t AliAnalysisMuMuJpsiResult::AddFit(const char* fitType)
 {
   // Add a fit to this result
 
-  if ( !fHisto ) return kFALSE;
+  TMethodCall callEnv;
+
+  AliAnalysisMuMuJpsiResult* r = PrepareFit(fitType,callEnv);
+
+  if ( !r ) return kFALSE;
+
+  callEnv.Execute(r);// here fit Method ("fit<SOMETHING>") is called and the fit is proceed.
+
+  return AdoptFit(r);
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuJpsiResult::AddFits(const TObjArray& fitTypes, Int_t nThreads)
+{
+  /// Add a fit to this result for each fit type (TObjString) of fitTypes,
+  /// running up to nThreads of them at the same time.
+  ///
+  /// Each fit is done by its own subresult, with its own clone of the histogram
+  /// and its own TF1s, so the fits do not share anything. The subresults are
+  /// then adopted in the order of fitTypes, exactly as AddFit would do.
+  ///
+  /// TMinuit, the default minimizer, works with a global instance (gMinuit) and cannot
+  /// be used by several threads, so the concurrent fits are done with Minuit2. With
+  /// nThreads <= 1, or outside batch mode (some fit methods draw), the fits are done
+  /// one after the other with AddFit and the default minimizer.
+  ///
+  /// Returns the number of fits added.
+
+  Int_t nFits = fitTypes.GetEntriesFast();
+  Int_t added(0);
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,8,0)
+  if ( nThreads > 1 && nFits > 1 && gROOT->IsBatch() )
+  {
+    ROOT::EnableThreadSafety();
+
+    // the subresults and their fit method are prepared beforehand, so the threads only fit
+    std::vector<AliAnalysisMuMuJpsiResult*> results(nFits,static_cast<AliAnalysisMuMuJpsiResult*>(0x0));
+    std::vector<TMethodCall> calls(nFits);
+
+    for ( Int_t i = 0; i < nFits; ++i )
+    {
+      TObjString* fitType = static_cast<TObjString*>(fitTypes.UncheckedAt(i));
+      results[i] = PrepareFit(fitType->String().Data(),calls[i]);
+    }
+
+    TString minimizer(ROOT::Math::MinimizerOptions::DefaultMinimizerType());
+    TString algorithm(ROOT::Math::MinimizerOptions::DefaultMinimizerAlgo());
+    ROOT::Math::MinimizerOptions::SetDefaultMinimizer("Minuit2");
+
+    // the TF1s of the different fits have the same names, keep them out of the global list
+    Bool_t addToGlobalList = TF1::DefaultAddToGlobalList(kFALSE);
+    Bool_t addDirectory = TH1::AddDirectoryStatus();
+    TH1::AddDirectory(kFALSE);
+
+    std::atomic<Int_t> next(0);
+    std::vector<std::thread> workers;
+
+    for ( Int_t t = 0; t < TMath::Min(nThreads,nFits); ++t )
+    {
+      workers.push_back(std::thread([&]()
+      {
+        Int_t i;
+        while ( ( i = next++ ) < nFits )
+        {
+          if ( results[i] ) calls[i].Execute(results[i]);
+        }
+      }));
+    }
+
+    for ( size_t t = 0; t < workers.size(); ++t ) workers[t].join();
+
+    TH1::AddDirectory(addDirectory);
+    TF1::DefaultAddToGlobalList(addToGlobalList);
+    ROOT::Math::MinimizerOptions::SetDefaultMinimizer(minimizer.Data(),algorithm.Data());
+
+    for ( Int_t i = 0; i < nFits; ++i )
+    {
+      if ( results[i] ) added += ( AdoptFit(results[i]) == kTRUE );
+    }
+
+    return added;
+  }
+#endif
+
+  for ( Int_t i = 0; i < nFits; ++i )
+  {
+    TObjString* fitType = static_cast<TObjString*>(fitTypes.UncheckedAt(i));
+    added += ( AddFit(fitType->String().Data()) == kTRUE );
+  }
+
+  return added;
+}
+
+//_____________________________________________________________________________
+AliAnalysisMuMuJpsiResult* AliAnalysisMuMuJpsiResult::PrepareFit(const char* fitType, TMethodCall& callEnv) const
+{
+  /// Create the subresult for the fit fitType, and initialize callEnv with its fit method.
+  /// Returns 0x0 if the fit cannot be done.
+
+  if ( !fHisto ) return 0x0;
 
   TH1* histo = static_cast<TH1*>(fHisto->Clone(fitType));
 
@@ -12518,11 +12701,9 @@ Bool_t AliAnalysisMuMuJpsiResult::AddFit(const char* fitType)
   if ( !r->IsValid() )
   {
     delete r;
-    return kFALSE;
+    return 0x0;
   }
 
-  TMethodCall callEnv;
-
   TString fittingMethod(r->GetFitFunctionMethodName().Data());
 
   std::cout << "+Using fitting method " << fittingMethod.Data() << "..." << std::endl;
@@ -12530,17 +12711,21 @@ Bool_t AliAnalysisMuMuJpsiResult::AddFit(const char* fitType)
 
   callEnv.InitWithPrototype(IsA(),fittingMethod.Data(),"");
 
-  if (callEnv.IsValid())
-  {
-    callEnv.Execute(r);// here fit Method ("fit<SOMETHING>") is called and the fit is proceed.
-  }
-  else
+  if (!callEnv.IsValid())
   {
     AliError(Form("Could not get the method %s",fittingMethod.Data()));
     delete r;
-    return kFALSE;
+    return 0x0;
   }
 
+  return r;
+}
+
+//_____________________________________________________________________________
+Bool_t AliAnalysisMuMuJpsiResult::AdoptFit(AliAnalysisMuMuJpsiResult* r)
+{
+  /// Adopt the subresult of a fit done by its fit method, or delete it if the fit failed
+
   if ( r->IsValid() )
   {
     StdoutToAliDebug(1,r->Print(););
@@ -12566,6 +12751,15 @@ Bool_t AliAnalysisMuMuJpsiResult::AddFit(const char* fitType)
   return (r!=0x0);
 }
 
+//_____________________________________________________________________________
+Double_t AliAnalysisMuMuJpsiResult::GetSPsiPFactor() const
+{
+  /// Factor to fix the psi' sigma to sigmaJPsi*factor.
+  /// Kept aside when decoding the fit type, as the fit functions need it for each point
+
+  return IsValidValue(fSPsiPFactor) ? fSPsiPFactor : GetValue(kKeySPsiP);
+}
+
 //_____________________________________________________________________________
 void AliAnalysisMuMuJpsiResult::DecodeFitType(const char* fitType)
 {
@@ -12689,6 +12883,7 @@ void AliAnalysisMuMuJpsiResult::DecodeFitType(const char* fitType)
     fFitFunction = fitFunction;
 
     Set(kKeySPsiP,paramSPsiP,0.0);
+    fSPsiPFactor = paramSPsiP;
     Set(kKeyRebin,rebin,0.0);
     Set(kFitRangeLow,fitMinvMin,0.0);
     Set(kFitRangeHigh,fitMinvMax,0.0);
@@ -13631,10 +13826,20 @@ Bool_t AliAnalysisMuMuJpsiResult::CheckFitStatus(TFitResultPtr &fitResult)
     isok =kFALSE;
     AliDebug(1,Form("Fit rejected because of covariant matrix : %d",fitResult->CovMatrixStatus()));
   }
-  TString minuitStatus = gMinuit->fCstatu;
-  if(!minuitStatus.Contains("SUCCESSFUL") && !minuitStatus.Contains("OK") && !minuitStatus.Contains("PROBLEMS")){
-    isok =kFALSE;
-    AliDebug(1,"Minuit status is not ok !");
+  // gMinuit only knows about the fits done with TMinuit (and not the concurrent ones, see AddFits)
+  TString minimizer(fitResult->MinimizerType());
+  if ( minimizer.BeginsWith("Minuit2") || !gMinuit ){
+    if ( !fitResult->IsValid() ){
+      isok =kFALSE;
+      AliDebug(1,"Minimizer status is not ok !");
+    }
+  }
+  else {
+    TString minuitStatus = gMinuit->fCstatu;
+    if(!minuitStatus.Contains("SUCCESSFUL") && !minuitStatus.Contains("OK") && !minuitStatus.Contains("PROBLEMS")){
+      isok =kFALSE;
+      AliDebug(1,"Minuit status is not ok !");
+    }
   }
   return isok;
 }
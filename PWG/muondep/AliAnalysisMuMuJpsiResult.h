@@ -39,6 +39,8 @@ class THashList;
 class TF1;
 class TMap;
 class TFitResultPtr;
+class TMethodCall;
+class TObjArray;
 
 class AliAnalysisMuMuJpsiResult : public AliAnalysisMuMuResult
 {
@@ -80,6 +82,8 @@ public:
 
   Bool_t AddFit(const char* fitType);
 
+  Int_t AddFits(const TObjArray& fitTypes, Int_t nThreads=1);
+
   /** All the fit functions should have a prototype starting like :
 
    AliAnalysisMuMuJpsiResult* FitXXX();
@@ -207,8 +211,14 @@ private:
 
   void DecodeFitType(const char* fitType);
 
+  AliAnalysisMuMuJpsiResult* PrepareFit(const char* fitType, TMethodCall& callEnv) const;
+
+  Bool_t AdoptFit(AliAnalysisMuMuJpsiResult* r);
+
   void PrintParticle(const char* particle, const char* opt) const;
 
+  Double_t GetSPsiPFactor() const;
+
   Double_t FitFunctionBackgroundLin(Double_t *x, Double_t *par);
 
   Double_t FitFunctionBackgroundPol1Pol2(Double_t *x, Double_t *par);
@@ -396,7 +406,9 @@ private:
   TString fParticle;
   TString fMinvRS; // minv spectra range and sigmaPsiP factor for the mpt fits
 
-  ClassDef(AliAnalysisMuMuJpsiResult,8) // a class to hold invariant mass analysis results (counts, yields, AccxEff, R_AB, etc...)
+  Double_t fSPsiPFactor; //! factor to fix the psi' sigma, as decoded from the fit type
+
+  ClassDef(AliAnalysisMuMuJpsiResult,9) // a class to hold invariant mass analysis results (counts, yields, AccxEff, R_AB, etc...)
 };
 
 #endif
@@ -18,6 +18,7 @@
 #include "TF1.h"
 #include "TH2D.h"
 #include "TH3D.h"
+#include <vector>
 class TH1;
 class TH1F;
 class TH2F;
@@ -31,6 +32,22 @@ class AliVEvent;
 class TCanvas;
 // class TParameter<double>;
 
+/// @class AliCorrelation3pAssociated
+/// Associated particles in separate arrays of pt, phi, eta and efficiency weight,
+/// filled once per particle list and read by the triplet loops of FillTriplets
+class AliCorrelation3pAssociated {
+ public:
+  AliCorrelation3pAssociated() : fPt(), fPhi(), fEta(), fWeight() {}
+  /// fill the arrays from a list of particles
+  void Set(const std::vector<AliVParticle*>& particles);
+  int GetSize() const {return fPt.size();}
+
+  std::vector<Double_t> fPt;     // transverse momentum
+  std::vector<Double_t> fPhi;    // azimuthal angle
+  std::vector<Double_t> fEta;    // pseudorapidity
+  std::vector<Double_t> fWeight; // efficiency weight, 1 if not an AliFilteredTrack
+};
+
 class AliCorrelation3p : public TNamed {
  public:
   /// default constructor
@@ -54,6 +71,8 @@ class AliCorrelation3p : public TNamed {
   int Fill( AliVParticle* trigger		, AliVParticle* p1				, const double weight=1.0);
   int Filla( AliVParticle* p1			, AliVParticle* p2				, const double weight=1.0);
   int FillTrigger( AliVParticle*ptrigger);
+  /// fill the correlations of one trigger with all pairs of associated particles
+  int FillTriplets( AliVParticle* trigger, const double weight, const AliCorrelation3pAssociated& assoc1, const AliCorrelation3pAssociated& assoc2, bool sameset, bool fillassoc, bool twop=true);
   int MakeResultsFile(const char* scalingmethod, bool recreate=false, bool fakecor=false);
   /// overloaded from TObject: cleanup
   virtual void Clear(Option_t * option ="");
@@ -38,6 +38,14 @@
 
 const double gkPii =  TMath::Pi();
 
+static Double_t WrapDeltaPhi(Double_t DeltaPhi)
+{
+  // azimuthal difference in the range of the correlation histograms
+  if (DeltaPhi<-0.5*gkPii) DeltaPhi += 2*gkPii;
+  if (DeltaPhi>1.5*gkPii)  DeltaPhi -= 2*gkPii;
+  return DeltaPhi;
+}
+
 ClassImp(AliCorrelation3p_noQA)
 
 AliCorrelation3p_noQA::AliCorrelation3p_noQA(const char* name,TArrayD MBinEdges, TArrayD ZBinEdges)
@@ -322,6 +330,79 @@ int AliCorrelation3p_noQA::FillTrigger(AliVParticle* ptrigger)
   return 1;
 }
 
+int AliCorrelation3p_noQA::FillTriplets(AliVParticle* ptrigger, const double weight, const AliCorrelation3pAssociated& assoc1, const AliCorrelation3pAssociated& assoc2, bool sameset, bool fillassoc, bool twop)
+{
+  /// Fill the correlations of one trigger with all pairs of associated particles,
+  /// equivalent to Fill(trigger,p1,p2), Filla(p1,p2) and Fill(trigger,p1) for each pair.
+  /// If sameset, assoc2 is assoc1 and each pair p1<p2 is used in both orders (3p and a-a).
+  /// Filla is only done if fillassoc, Fill(trigger,p1) only if twop.
+  if (!ptrigger) return -EINVAL;
+  const Double_t trigPt  = ptrigger->Pt();
+  const Double_t trigPhi = ptrigger->Phi();
+  const Double_t trigEta = ptrigger->Eta();
+  // the histograms of this event, resolved once
+  const Int_t n3p = GetNumberHist(khPhiPhiDEta,fMBin,fVzBin);
+  const Int_t n2p = GetNumberHist(khPhiEta,fMBin,fVzBin);
+  const Int_t naa = GetNumberHist(khPhiEtaa,fMBin,fVzBin);
+  TH3F* h3p = (n3p>=0?dynamic_cast<TH3F*>(fHistograms->At(n3p)):NULL);
+  TH2D* h2p = (n2p>=0?dynamic_cast<TH2D*>(fHistograms->At(n2p)):NULL);
+  TH2D* haa = (naa>=0?dynamic_cast<TH2D*>(fHistograms->At(naa)):NULL);
+
+  // phi difference to the trigger and trigger cuts of each associated, once per trigger
+  const int nassoc1 = assoc1.GetSize();
+  const int nassoc2 = (sameset?nassoc1:assoc2.GetSize());
+  std::vector<Double_t> deltaPhi1(nassoc1), deltaPhi2;
+  std::vector<char> accept1(nassoc1), accept2;
+  for (int i=0;i<nassoc1;i++) {
+    deltaPhi1[i] = WrapDeltaPhi(trigPhi - assoc1.fPhi[i]);
+    accept1[i] = !(trigPt<=assoc1.fPt[i]||TMath::Abs(assoc1.fEta[i]-trigEta)<1.0E-10);//trigger pt and duplicate cuts of Fill(trigger,p1,p2)
+  }
+  if (!sameset) {
+    deltaPhi2.resize(nassoc2);
+    accept2.resize(nassoc2);
+    for (int j=0;j<nassoc2;j++) {
+      deltaPhi2[j] = WrapDeltaPhi(trigPhi - assoc2.fPhi[j]);
+      accept2[j] = !(trigPt<=assoc2.fPt[j]||TMath::Abs(assoc2.fEta[j]-trigEta)<1.0E-10);
+    }
+  }
+  const AliCorrelation3pAssociated& a2 = (sameset?assoc1:assoc2);
+  const std::vector<Double_t>& dphi2 = (sameset?deltaPhi1:deltaPhi2);
+  const std::vector<char>& acc2 = (sameset?accept1:accept2);
+
+  for (int i=0;i<nassoc1;i++) {
+    for (int j=(sameset?i+1:0);j<nassoc2;j++) {
+      const Double_t w = weight*assoc1.fWeight[i]*a2.fWeight[j];
+      if (accept1[i]&&acc2[j]) {
+	Double_t DeltaEta12 = assoc1.fEta[i]-a2.fEta[j];
+	if (!(TMath::Abs(deltaPhi1[i]-dphi2[j])<1.0E-10&&TMath::Abs(DeltaEta12)<1.0E-10)) {//Track duplicate, reject.
+	  if (h3p) h3p->Fill(DeltaEta12,deltaPhi1[i],dphi2[j],w);
+	  else HistFill(n3p,DeltaEta12,deltaPhi1[i],dphi2[j],w);
+	  if (sameset) {
+	    if (h3p) h3p->Fill(-DeltaEta12,dphi2[j],deltaPhi1[i],w);
+	    else HistFill(n3p,-DeltaEta12,dphi2[j],deltaPhi1[i],w);
+	  }
+	}
+      }
+      if (fillassoc) {
+	const Double_t wa = assoc1.fWeight[i]*a2.fWeight[j];
+	Double_t DeltaPhi = WrapDeltaPhi(assoc1.fPhi[i] - a2.fPhi[j]);
+	Double_t DeltaEta = assoc1.fEta[i] - a2.fEta[j];
+	if (haa) haa->Fill(DeltaEta,DeltaPhi,wa);
+	else HistFill(naa,DeltaEta,DeltaPhi,wa);
+	DeltaPhi = WrapDeltaPhi(a2.fPhi[j] - assoc1.fPhi[i]);
+	if (haa) haa->Fill(-DeltaEta,DeltaPhi,wa);
+	else HistFill(naa,-DeltaEta,DeltaPhi,wa);
+      }
+    }
+    if (twop && trigPt>assoc1.fPt[i]) {
+      const Double_t DeltaEta = trigEta - assoc1.fEta[i];
+      if (h2p) h2p->Fill(DeltaEta,deltaPhi1[i],weight*assoc1.fWeight[i]);
+      else HistFill(n2p,DeltaEta,deltaPhi1[i],weight*assoc1.fWeight[i]);
+    }
+  }
+  return 0;
+}
+
 void AliCorrelation3p_noQA::Clear(Option_t * /*option*/)
 {
   /// overloaded from TObject: cleanup
@@ -18,6 +18,7 @@
 #include "TF1.h"
 #include "TH2D.h"
 #include "TH3D.h"
+#include "AliCorrelation3p.h"
 class TH1;
 class TH1F;
 class TH2F;
@@ -54,6 +55,8 @@ class AliCorrelation3p_noQA : public TNamed {
   int Fill( AliVParticle* trigger		, AliVParticle* p1				, const double weight=1.0);
   int Filla( AliVParticle* p1			, AliVParticle* p2				, const double weight=1.0);
   int FillTrigger( AliVParticle*ptrigger);
+  /// fill the correlations of one trigger with all pairs of associated particles
+  int FillTriplets( AliVParticle* trigger, const double weight, const AliCorrelation3pAssociated& assoc1, const AliCorrelation3pAssociated& assoc2, bool sameset, bool fillassoc, bool twop=true);
   int MakeResultsFile(const char* scalingmethod, bool recreate=false, bool all=false);
   /// overloaded from TObject: cleanup
   virtual void Clear(Option_t * option ="");
@@ -26,6 +26,7 @@
 #include <cerrno>
 #include <AliAODMCParticle.h>
 #include "AliCFPI0.h"
+#include "AliCorrelation3p.h"
 #include <TVectorT.h>
 #include <AliMCEventHandler.h>
 #include <AliAnalysisManager.h>
@@ -52,6 +53,8 @@ class AliThreeParticleCorrelator : public TNamed {
     , fAssociated()
     , fAssociatedmixed1()
     , fAssociatedmixed2()
+    , fAssociatedArrays1()
+    , fAssociatedArrays2()
     , fEventPoolMgr(NULL)
     , fVz(0)
     , fMultiplicity(0)
@@ -76,6 +79,8 @@ class AliThreeParticleCorrelator : public TNamed {
     , fAssociated(other.fAssociated)
     , fAssociatedmixed1(other.fAssociatedmixed1)
     , fAssociatedmixed2(other.fAssociatedmixed2)
+    , fAssociatedArrays1()
+    , fAssociatedArrays2()
     , fEventPoolMgr(other.fEventPoolMgr)
     , fVz(other.fVz)
     , fMultiplicity(other.fMultiplicity)
@@ -252,30 +257,16 @@ class AliThreeParticleCorrelator : public TNamed {
     /// Fill correlation objects of different properties 
     Double_t NAssociated = associated.size();
     Double_t weightt = 1.0;
-    Double_t weighta1 = 1.0;
-    Double_t weighta2 = 1.0;
     if(NAssociated==0) return 0;//No associated means we need not fill anything.
     if (activeTriggers.size()==0) return 0;//No Triggers means we need not fill anything
+    //pt, phi, eta and weights of the associated are read once, not for every triplet
+    fAssociatedArrays1.Set(associated);
     for (typename std::vector<AliVParticle*>::const_iterator trigger=activeTriggers.begin(), e=activeTriggers.end(); trigger!=e; ++trigger) {
       AnalysisObject->FillTrigger(*trigger);//Fill histogram for number of triggers.
       weightt = 1.0;
       if(dynamic_cast<AliFilteredTrack*>(*trigger))weightt = dynamic_cast<AliFilteredTrack*>(*trigger)->GetEff();
-      for (typename std::vector<AliVParticle*>::const_iterator assoc=associated.begin(), eassoc=associated.end(); assoc!=eassoc; ++assoc) {
-	weighta1 = 1.0;
-	if(dynamic_cast<AliFilteredTrack*>(*assoc))weighta1 = dynamic_cast<AliFilteredTrack*>(*assoc)->GetEff();
-	for (typename std::vector<AliVParticle*>::const_iterator assoc2=assoc+1, eassoc2 = associated.end(); assoc2 !=eassoc2;++assoc2){
-	  weighta2 = 1.0;
-	  if(dynamic_cast<AliFilteredTrack*>(*assoc2))weighta2 = dynamic_cast<AliFilteredTrack*>(*assoc2)->GetEff();
-	  AnalysisObject->Fill(*trigger,*assoc,*assoc2,weightt*weighta1*weighta2);//Fill histogram for number of triggers.
-	  AnalysisObject->Fill(*trigger,*assoc2,*assoc,weightt*weighta1*weighta2);//Fill histogram for number of triggers.
-	  if(trigger==activeTriggers.begin()){
-	    //once per event fill the a-a 2p correlation histogram symmitrized
-	    AnalysisObject->Filla(*assoc,*assoc2,weighta1*weighta2);
-	    AnalysisObject->Filla(*assoc2,*assoc,weighta1*weighta2);
-	  }
-	}//loop over second associated
-	AnalysisObject->Fill(*trigger,*assoc,weightt*weighta1);//Fill histogram for number of triggers.	        
-      } // loop over first associated
+      //all pairs of associated in both orders, once per event the a-a 2p correlation symmetrized
+      AnalysisObject->FillTriplets(*trigger,weightt,fAssociatedArrays1,fAssociatedArrays1,true,trigger==activeTriggers.begin());
     } // loop over triggers
     return 0;
   }
@@ -285,31 +276,17 @@ class AliThreeParticleCorrelator : public TNamed {
     Double_t NAssociated1 = associated.size();
     Double_t NAssociated2 = associatedmixed.size();
     Double_t weightt = 1.0;
-    Double_t weighta1 = 1.0;
-    Double_t weighta2 = 1.0;
     if(NAssociated1==0||NAssociated2==0) return 0;//No associated means we need not fill anything.
     if (activeTriggers.size()==0) return 0;//no triggers means nothing to be correlated
+    //pt, phi, eta and weights of the associated are read once, not for every triplet
+    fAssociatedArrays1.Set(associated);
+    fAssociatedArrays2.Set(associatedmixed);
     for (typename std::vector<AliVParticle*>::const_iterator trigger=activeTriggers.begin(), e=activeTriggers.end(); trigger!=e; ++trigger) {
       AnalysisObject->FillTrigger(*trigger);//Fill histogram for number of triggers.
       weightt = 1.0;
       if(dynamic_cast<AliFilteredTrack*>(*trigger))weightt = dynamic_cast<AliFilteredTrack*>(*trigger)->GetEff();
-      for (typename std::vector<AliVParticle*>::const_iterator assoc=associated.begin(), eassoc=associated.end(); assoc!=eassoc; ++assoc) {
-	weighta1 = 1.0;
-	if(dynamic_cast<AliFilteredTrack*>(*assoc))weighta1 = dynamic_cast<AliFilteredTrack*>(*assoc)->GetEff();
-	for (typename std::vector<AliVParticle*>::const_iterator assoc2=associatedmixed.begin(), eassoc2 = associatedmixed.end(); assoc2 !=eassoc2;++assoc2){
-	  weighta2 = 1.0;
-	  if(dynamic_cast<AliFilteredTrack*>(*assoc2))weighta2 = dynamic_cast<AliFilteredTrack*>(*assoc2)->GetEff();
-	  AnalysisObject->Fill(*trigger,*assoc,*assoc2,weightt*weighta1*weighta2);//Fill histogram for number of triggers.
-	  if(trigger==activeTriggers.begin()){
-	    //once per event fill the a-a 2p correlation histogram
-	    AnalysisObject->Filla(*assoc,*assoc2,weighta1*weighta2);
-	    AnalysisObject->Filla(*assoc2,*assoc,weighta1*weighta2);
-	  }
-	}//loop over second associated
-	if (twop){
-	  AnalysisObject->Fill(*trigger,*assoc,weightt*weighta1);//Fill histogram for number of triggers.  
-	  }
-	} // loop over first associated
+      //all pairs of associated, once per event the a-a 2p correlation
+      AnalysisObject->FillTriplets(*trigger,weightt,fAssociatedArrays1,fAssociatedArrays2,false,trigger==activeTriggers.begin(),twop);
     } // loop over triggers
     return 0;
   }
@@ -410,13 +387,15 @@ class AliThreeParticleCorrelator : public TNamed {
   std::vector<AliVParticle*> fAssociated;//!vector to contain the associated particles.
   std::vector<AliVParticle*> fAssociatedmixed1; //! buffer for Associated
   std::vector<AliVParticle*> fAssociatedmixed2; //! buffer for Associated
+  AliCorrelation3pAssociated fAssociatedArrays1; //! kinematics of the first associated list in ProcessEvent
+  AliCorrelation3pAssociated fAssociatedArrays2; //! kinematics of the second associated list in ProcessEvent
   AliEventPoolManager* fEventPoolMgr; //! event pool manager, external pointer
   Double_t fVz;//Vertex in z
   Double_t fMultiplicity;//Multiplicity in %
   TRandom3 * fRandom;//!to be able to pick mixed event tracks.
   Double_t fMaxMixedPerEvent;//limit on the size of each event in the pool
   bool     fLeading;//if true only the leading pT trigger is kept.
- ClassDef(AliThreeParticleCorrelator, 4)
+ ClassDef(AliThreeParticleCorrelator, 5)
 };
 
 #endif
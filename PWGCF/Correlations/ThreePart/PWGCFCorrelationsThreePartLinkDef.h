@@ -9,6 +9,7 @@
 #pragma link C++ class AliFilteredEvent+;
 #pragma link C++ class AliFilteredEventInputHandler+;
 #pragma link C++ class AliCorrelation3p_noQA+;
+#pragma link C++ class AliCorrelation3pAssociated+;
 #pragma link C++ class AliCorrelation3p+;
 #pragma link C++ class AliThreeParticleCorrelator<AliCorrelation3p_noQA>+;
 #pragma link C++ class AliThreeParticleCorrelator<AliCorrelation3p>+;
@@ -33,6 +33,9 @@
 #include <TString.h>
 #include <TSpline.h>
 #include <TRandom3.h>
+#include <TVirtualFFT.h>
+
+#include <algorithm>
 
 #include "AliVParticle.h"
 #include "AliMCParticle.h"
@@ -48,6 +51,174 @@ using std::cerr;
 
 ClassImp(AliBalancePsi)
 
+namespace {
+  // particle as used by AliBalancePsi::CalculateBalanceBinned
+  struct BinnedParticle {
+    Int_t    fIndex;      // index in the particle array
+    Float_t  fEta;        // eta
+    Float_t  fPhi;        // phi
+    Float_t  fPt;         // pT
+    Short_t  fCharge;     // charge
+    Double_t fCorrection; // weight
+    Double_t fClass;      // event class value (only for triggers)
+    Int_t    fGroup;      // pT group
+    Int_t    fKey;        // (event class,) pT group and charge
+    Int_t    fCellEta;    // eta cell
+    Int_t    fCellPhi;    // phi cell
+
+    static bool CompareGroup(const BinnedParticle &a, const BinnedParticle &b) { return a.fGroup < b.fGroup; }
+    static bool CompareCell(const BinnedParticle &a, const BinnedParticle &b) {
+      if (a.fKey != b.fKey) return a.fKey < b.fKey;
+      if (a.fCellEta != b.fCellEta) return a.fCellEta < b.fCellEta;
+      return a.fCellPhi < b.fCellPhi;
+    }
+  };
+
+  // occupied cell: sum of the weights (and of the squared weights) of its particles
+  struct BinnedCell {
+    Int_t    fKey;        // (event class,) pT group and charge
+    Int_t    fEta;        // eta cell
+    Int_t    fPhi;        // phi cell
+    Double_t fW;          // sum of weights
+    Double_t fW2;         // sum of squared weights
+    Bool_t   fUnit;       // all the weights are 1
+
+    static void MakeCells(vector<BinnedParticle> &particles, vector<BinnedCell> &cells) {
+      // sorts the particles by (key, cell) and merges the ones in the same cell
+      std::sort(particles.begin(), particles.end(), BinnedParticle::CompareCell);
+      cells.clear();
+      for (UInt_t i = 0; i < particles.size(); i++) {
+        const BinnedParticle &p = particles[i];
+        if (cells.empty() || cells.back().fKey != p.fKey || cells.back().fEta != p.fCellEta || cells.back().fPhi != p.fCellPhi) {
+          BinnedCell cell = {p.fKey, p.fCellEta, p.fCellPhi, 0., 0., kTRUE};
+          cells.push_back(cell);
+        }
+        cells.back().fW  += p.fCorrection;
+        cells.back().fW2 += p.fCorrection*p.fCorrection;
+        if (p.fCorrection != 1.) cells.back().fUnit = kFALSE;
+      }
+    }
+  };
+
+  // phi spectra (FFT) of the occupied eta rows of a block of cells with the same key
+  struct BinnedRows {
+    vector<Int_t>    fEta;         // eta cell of the rows
+    vector<Double_t> fReW;         // FFT of the sum of weights, nRows x (nPhi/2+1)
+    vector<Double_t> fImW;
+    vector<Double_t> fReW2;        // FFT of the sum of squared weights (only without unit weights)
+    vector<Double_t> fImW2;
+    Double_t         fSumW;        // total weight
+    Bool_t           fUnitWeights; // all the weights are 1
+    Bool_t           fDone;        // spectra made
+
+    BinnedRows() : fEta(), fReW(), fImW(), fReW2(), fImW2(), fSumW(0.), fUnitWeights(kTRUE), fDone(kFALSE) {}
+
+    static Int_t CountRows(const vector<BinnedCell> &cells, UInt_t start, UInt_t end) {
+      // cells are sorted by eta cell inside a block
+      Int_t nRows = 0;
+      for (UInt_t i = start; i < end; i++)
+        if (i == start || cells[i].fEta != cells[i-1].fEta) nRows++;
+      return nRows;
+    }
+
+    void Make(const vector<BinnedCell> &cells, UInt_t start, UInt_t end, Int_t nPhi, TVirtualFFT *fft) {
+      const Int_t nH = nPhi/2 + 1;
+      vector<Double_t> row(nPhi), row2(nPhi), re(nH), im(nH);
+      fSumW = 0.;
+      fUnitWeights = kTRUE;
+      for (UInt_t i = start; i < end; i++) {
+        fSumW += cells[i].fW;
+        if (!cells[i].fUnit) fUnitWeights = kFALSE;
+      }
+      UInt_t i = start;
+      while (i < end) {
+        const Int_t eta = cells[i].fEta;
+        std::fill(row.begin(), row.end(), 0.);
+        std::fill(row2.begin(), row2.end(), 0.);
+        for (; i < end && cells[i].fEta == eta; i++) {
+          row[cells[i].fPhi]  = cells[i].fW;
+          row2[cells[i].fPhi] = cells[i].fW2;
+        }
+        fEta.push_back(eta);
+        fft->SetPoints(&row[0]);
+        fft->Transform();
+        fft->GetPointsComplex(&re[0], &im[0]);
+        fReW.insert(fReW.end(), re.begin(), re.end());
+        fImW.insert(fImW.end(), im.begin(), im.end());
+        if (fUnitWeights) continue;
+        fft->SetPoints(&row2[0]);
+        fft->Transform();
+        fft->GetPointsComplex(&re[0], &im[0]);
+        fReW2.insert(fReW2.end(), re.begin(), re.end());
+        fImW2.insert(fImW2.end(), im.begin(), im.end());
+      }
+      fDone = kTRUE;
+    }
+  };
+
+  // cross-correlation of two blocks of cells in (eta cell difference, phi cell difference)
+  struct BinnedSpectrumSum {
+    vector<Double_t> fReW, fImW, fReW2, fImW2;  // summed spectra per eta cell difference
+    vector<Double_t> fW, fW2;                    // correlations, nEtaDiff x nPhi
+    vector<Bool_t>   fUsed;                      // eta cell difference with pairs
+    Double_t         fTolerance;                 // |correlation| below which a cell is empty
+
+    void Correlate(const BinnedRows &trig, const BinnedRows &assoc, Int_t nDeltaEtaCells, Int_t nPhi, TVirtualFFT *fftBackward) {
+      // sum over the pairs of eta rows of FFT(trigger row) x conj(FFT(associated row)),
+      // so that the inverse FFT gives, for each phi cell difference k,
+      // the sum over the cell pairs with phi(trigger) - phi(associated) = k
+      const Int_t nEtaDiff = 2*nDeltaEtaCells + 1;
+      const Int_t nH = nPhi/2 + 1;
+      const Bool_t unitWeights = trig.fUnitWeights && assoc.fUnitWeights;
+      fReW.assign(nEtaDiff*nH, 0.);
+      fImW.assign(nEtaDiff*nH, 0.);
+      if (!unitWeights) {
+        fReW2.assign(nEtaDiff*nH, 0.);
+        fImW2.assign(nEtaDiff*nH, 0.);
+      }
+      fUsed.assign(nEtaDiff, kFALSE);
+      for (UInt_t iTrig = 0; iTrig < trig.fEta.size(); iTrig++) {
+        for (UInt_t iAssoc = 0; iAssoc < assoc.fEta.size(); iAssoc++) {
+          const Int_t iEta = trig.fEta[iTrig] - assoc.fEta[iAssoc] + nDeltaEtaCells;
+          if (iEta < 0 || iEta >= nEtaDiff) continue;
+          fUsed[iEta] = kTRUE;
+          AddProduct(&trig.fReW[iTrig*nH], &trig.fImW[iTrig*nH], &assoc.fReW[iAssoc*nH], &assoc.fImW[iAssoc*nH], &fReW[iEta*nH], &fImW[iEta*nH], nH);
+          if (unitWeights) continue;
+          AddProduct(&trig.fReW2[iTrig*nH], &trig.fImW2[iTrig*nH], &assoc.fReW2[iAssoc*nH], &assoc.fImW2[iAssoc*nH], &fReW2[iEta*nH], &fImW2[iEta*nH], nH);
+        }
+      }
+      fW.assign(nEtaDiff*nPhi, 0.);
+      if (!unitWeights) fW2.assign(nEtaDiff*nPhi, 0.);
+      // with unit weights the correlations are pair counts: rounding them is exact
+      fTolerance = unitWeights ? 0.5 : 1e-9*trig.fSumW*assoc.fSumW;
+      for (Int_t iEta = 0; iEta < nEtaDiff; iEta++) {
+        if (!fUsed[iEta]) continue;
+        Inverse(&fReW[iEta*nH], &fImW[iEta*nH], &fW[iEta*nPhi], nPhi, fftBackward, unitWeights);
+        if (unitWeights) continue;
+        Inverse(&fReW2[iEta*nH], &fImW2[iEta*nH], &fW2[iEta*nPhi], nPhi, fftBackward, kFALSE);
+      }
+    }
+
+    static void AddProduct(const Double_t *re1, const Double_t *im1, const Double_t *re2, const Double_t *im2,
+                           Double_t *re, Double_t *im, Int_t n) {
+      for (Int_t i = 0; i < n; i++) {
+        re[i] += re1[i]*re2[i] + im1[i]*im2[i];
+        im[i] += im1[i]*re2[i] - re1[i]*im2[i];
+      }
+    }
+
+    static void Inverse(const Double_t *re, const Double_t *im, Double_t *out, Int_t nPhi, TVirtualFFT *fftBackward, Bool_t round) {
+      fftBackward->SetPointsComplex(re, im);
+      fftBackward->Transform();
+      fftBackward->GetPoints(out);
+      for (Int_t i = 0; i < nPhi; i++) {
+        out[i] /= nPhi;  // the backward transform is not normalized
+        if (round) out[i] = TMath::Nint(out[i]);
+      }
+    }
+  };
+}
+
 //____________________________________________________________________//
 AliBalancePsi::AliBalancePsi() :
   TObject(), 
@@ -92,7 +263,22 @@ AliBalancePsi::AliBalancePsi() :
   fVertexBinning(kFALSE),
   fCustomBinning(""),
   fBinningString(""),
-  fEventClass("EventPlane"){
+  fEventClass("EventPlane"),
+  fUseBinnedPairs(kFALSE),
+  fBinnedSubBins(4),
+  fBinnedStatus(0),
+  fBinnedCellEta(0.),
+  fBinnedCellPhi(0.),
+  fBinnedNCellsPhi(0),
+  fBinnedNDeltaEtaCells(0),
+  fBinnedLookup(),
+  fBinnedPtEdges(),
+  fBinnedPtTrigBin(),
+  fBinnedPtAssocBin(),
+  fBinnedSumW(),
+  fBinnedSumW2(),
+  fBinnedFFTForward(0),
+  fBinnedFFTBackward(0){
   // Default constructor
 }
 
@@ -138,7 +324,22 @@ AliBalancePsi::AliBalancePsi(const AliBalancePsi& balance):
   fVertexBinning(balance.fVertexBinning),
   fCustomBinning(balance.fCustomBinning),
   fBinningString(balance.fBinningString),
-  fEventClass("EventPlane"){
+  fEventClass("EventPlane"),
+  fUseBinnedPairs(balance.fUseBinnedPairs),
+  fBinnedSubBins(balance.fBinnedSubBins),
+  fBinnedStatus(0),
+  fBinnedCellEta(0.),
+  fBinnedCellPhi(0.),
+  fBinnedNCellsPhi(0),
+  fBinnedNDeltaEtaCells(0),
+  fBinnedLookup(),
+  fBinnedPtEdges(),
+  fBinnedPtTrigBin(),
+  fBinnedPtAssocBin(),
+  fBinnedSumW(),
+  fBinnedSumW2(),
+  fBinnedFFTForward(0),
+  fBinnedFFTBackward(0){
   //copy constructor
 }
 
@@ -167,7 +368,9 @@ AliBalancePsi::~AliBalancePsi() {
   delete fHistResonancesLambda;
   delete fHistQbefore;
   delete fHistQafter;
-    
+
+  delete fBinnedFFTForward;
+  delete fBinnedFFTBackward;
 }
 
 //____________________________________________________________________//
@@ -437,6 +640,16 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
     AliWarning("particles TObjArray is NULL pointer --> return");
     return;
   }
+
+  // event class (otherwise the psi bin of the trigger particle)
+  Bool_t useMultOrCent = (fEventClass=="Multiplicity" || fEventClass == "Centrality");
+
+  // pair weights factorize if there is no pair cut: fill from binned single particle distributions
+  if(fUseBinnedPairs && !fResonancesCut && !fHBTCut && !fConversionCut && !fQCut &&
+     !(fSameLabelMCCut && !particlesMixed) && InitBinnedPairs()) {
+    CalculateBalanceBinned(gReactionPlane,particles,particlesMixed,useMultOrCent,kMultorCent,vertexZ);
+    return;
+  }
   
   // define end of particle loops
   Int_t iMax = particles->GetEntriesFast();
@@ -490,26 +703,8 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
     if (fSameLabelMCCut) firstLabel = firstParticle->GetLabel();
     
     // Event plane (determine psi bin)
-    Double_t gPsiMinusPhi    =   0.;
-    Double_t gPsiMinusPhiBin = -10.;
-    gPsiMinusPhi   = TMath::Abs(firstPhi - gReactionPlane);
-    //in-plane
-    if((gPsiMinusPhi <= 7.5*TMath::DegToRad())||
-       ((172.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 187.5*TMath::DegToRad())))
-      gPsiMinusPhiBin = 0.0;
-    //intermediate
-    else if(((37.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 52.5*TMath::DegToRad()))||
-	    ((127.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 142.5*TMath::DegToRad()))||
-	    ((217.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 232.5*TMath::DegToRad()))||
-	    ((307.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 322.5*TMath::DegToRad())))
-      gPsiMinusPhiBin = 1.0;
-    //out of plane
-    else if(((82.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 97.5*TMath::DegToRad()))||
-	    ((262.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 277.5*TMath::DegToRad())))
-      gPsiMinusPhiBin = 2.0;
-    //everything else
-    else 
-      gPsiMinusPhiBin = 3.0;
+    Double_t gPsiMinusPhi    = TMath::Abs(firstPhi - gReactionPlane);
+    Double_t gPsiMinusPhiBin = GetPsiMinusPhiBin(gPsiMinusPhi);
     
     fHistPsiMinusPhi->Fill(gPsiMinusPhiBin,gPsiMinusPhi);
 
@@ -517,7 +712,7 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
     
     trackVariablesSingle[0]    =  gPsiMinusPhiBin;
     trackVariablesSingle[1]    =  firstPt;
-      if(fEventClass=="Multiplicity" || fEventClass == "Centrality" ) trackVariablesSingle[0] = kMultorCent;
+    if(useMultOrCent) trackVariablesSingle[0] = kMultorCent;
     trackVariablesSingle[2]    =  vertexZ;
 
     
@@ -734,6 +929,397 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
   }//end of 1st particle loop
 }  
 
+//____________________________________________________________________//
+Double_t AliBalancePsi::GetPsiMinusPhiBin(Double_t gPsiMinusPhi) const {
+  // Returns the event plane bin of a particle from |phi - Psi|
+  //in-plane
+  if((gPsiMinusPhi <= 7.5*TMath::DegToRad())||
+     ((172.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 187.5*TMath::DegToRad())))
+    return 0.0;
+  //intermediate
+  else if(((37.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 52.5*TMath::DegToRad()))||
+	  ((127.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 142.5*TMath::DegToRad()))||
+	  ((217.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 232.5*TMath::DegToRad()))||
+	  ((307.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 322.5*TMath::DegToRad())))
+    return 1.0;
+  //out of plane
+  else if(((82.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 97.5*TMath::DegToRad()))||
+	  ((262.5*TMath::DegToRad() <= gPsiMinusPhi)&&(gPsiMinusPhi <= 277.5*TMath::DegToRad())))
+    return 2.0;
+  //everything else
+  return 3.0;
+}
+
+//____________________________________________________________________//
+Bool_t AliBalancePsi::InitBinnedPairs() {
+  // Prepares the single particle cells and the lookup table used by CalculateBalanceBinned.
+  // The cells have 1/fBinnedSubBins of the Delta eta (Delta phi) bin width of the pair histograms,
+  // which therefore need an equidistant binning (and Delta phi has to cover 2pi).
+  // Returns kFALSE if the binning does not allow it (then the pair loop is used).
+  if(fBinnedStatus != 0) return (fBinnedStatus > 0);
+  fBinnedStatus = -1;
+
+  TAxis *axisDeltaEta = fHistPN->GetAxis(1,0);
+  TAxis *axisDeltaPhi = fHistPN->GetAxis(2,0);
+  const Int_t nDeltaEta = axisDeltaEta->GetNbins();
+  const Int_t nDeltaPhi = axisDeltaPhi->GetNbins();
+  const Double_t widthDeltaEta = (axisDeltaEta->GetXmax() - axisDeltaEta->GetXmin())/nDeltaEta;
+  const Double_t widthDeltaPhi = (axisDeltaPhi->GetXmax() - axisDeltaPhi->GetXmin())/nDeltaPhi;
+  for(Int_t iBin = 1; iBin <= nDeltaEta; iBin++) {
+    if(TMath::Abs(axisDeltaEta->GetBinWidth(iBin) - widthDeltaEta) > 1e-3*widthDeltaEta) {
+      AliWarning("Delta eta binning is not equidistant --> binned pairs not used");
+      return kFALSE;
+    }
+  }
+  for(Int_t iBin = 1; iBin <= nDeltaPhi; iBin++) {
+    if(TMath::Abs(axisDeltaPhi->GetBinWidth(iBin) - widthDeltaPhi) > 1e-3*widthDeltaPhi) {
+      AliWarning("Delta phi binning is not equidistant --> binned pairs not used");
+      return kFALSE;
+    }
+  }
+  if(TMath::Abs(nDeltaPhi*widthDeltaPhi - TMath::TwoPi()) > 1e-3) {
+    AliWarning("Delta phi binning does not cover 2pi --> binned pairs not used");
+    return kFALSE;
+  }
+
+  fBinnedCellEta   = widthDeltaEta/fBinnedSubBins;
+  fBinnedNCellsPhi = nDeltaPhi*fBinnedSubBins;
+  fBinnedCellPhi   = TMath::TwoPi()/fBinnedNCellsPhi;
+  fBinnedNDeltaEtaCells = (Int_t)TMath::Ceil(TMath::Max(TMath::Abs(axisDeltaEta->GetXmin()),TMath::Abs(axisDeltaEta->GetXmax()))/fBinnedCellEta) + 1;
+
+  // The cells of the trigger particles are shifted by half a cell with respect to the ones
+  // of the associated particles, so that the difference of the cell centres, (k - 1/2) cells,
+  // never falls on a bin edge of the pair histograms.
+  const Int_t nEtaDiff = 2*fBinnedNDeltaEtaCells + 1;
+  fBinnedLookup.Set(nEtaDiff*fBinnedNCellsPhi);
+  for(Int_t iEta = 0; iEta < nEtaDiff; iEta++) {
+    Double_t deltaEta = (iEta - fBinnedNDeltaEtaCells - 0.5)*fBinnedCellEta;
+    Int_t binEta = axisDeltaEta->FindBin(deltaEta);
+    for(Int_t iPhi = 0; iPhi < fBinnedNCellsPhi; iPhi++) {
+      Double_t deltaPhi = (iPhi - 0.5)*fBinnedCellPhi;
+      if(deltaPhi >= 1.5*TMath::Pi()) deltaPhi -= TMath::TwoPi();  // delta phi between -pi/2 and 3pi/2
+      if(deltaPhi < -0.5*TMath::Pi()) deltaPhi += TMath::TwoPi();
+      Int_t binPhi = axisDeltaPhi->FindBin(deltaPhi);
+      if(binEta < 1 || binEta > nDeltaEta || binPhi < 1 || binPhi > nDeltaPhi)
+	fBinnedLookup[iEta*fBinnedNCellsPhi + iPhi] = -1;
+      else
+	fBinnedLookup[iEta*fBinnedNCellsPhi + iPhi] = (binEta - 1)*nDeltaPhi + (binPhi - 1);
+    }
+  }
+  fBinnedSumW.Set(nDeltaEta*nDeltaPhi);
+  fBinnedSumW2.Set(nDeltaEta*nDeltaPhi);
+  fBinnedSumW.Reset();
+  fBinnedSumW2.Reset();
+
+  // pT groups: the intervals of the union of the pT trigger and pT associated bin edges.
+  // Particles of different groups are ordered in pT, so that the momentum ordering
+  // can be applied to whole groups.
+  TAxis *axisPtTrig  = fHistPN->GetAxis(3,0);
+  TAxis *axisPtAssoc = fHistPN->GetAxis(4,0);
+  vector<Double_t> edges;
+  for(Int_t iBin = 1; iBin <= axisPtTrig->GetNbins()+1; iBin++) edges.push_back(axisPtTrig->GetBinLowEdge(iBin));
+  for(Int_t iBin = 1; iBin <= axisPtAssoc->GetNbins()+1; iBin++) edges.push_back(axisPtAssoc->GetBinLowEdge(iBin));
+  std::sort(edges.begin(),edges.end());
+  fBinnedPtEdges.Set(0);
+  for(UInt_t iEdge = 0; iEdge < edges.size(); iEdge++) {
+    Int_t nEdges = fBinnedPtEdges.GetSize();
+    if(nEdges > 0 && edges[iEdge] - fBinnedPtEdges[nEdges-1] < 1e-9) continue;
+    fBinnedPtEdges.Set(nEdges+1);
+    fBinnedPtEdges[nEdges] = edges[iEdge];
+  }
+  const Int_t nGroups = fBinnedPtEdges.GetSize() - 1;
+  fBinnedPtTrigBin.Set(nGroups);
+  fBinnedPtAssocBin.Set(nGroups);
+  for(Int_t iGroup = 0; iGroup < nGroups; iGroup++) {
+    Double_t ptCentre = 0.5*(fBinnedPtEdges[iGroup] + fBinnedPtEdges[iGroup+1]);
+    fBinnedPtTrigBin[iGroup]  = axisPtTrig->FindBin(ptCentre);
+    fBinnedPtAssocBin[iGroup] = axisPtAssoc->FindBin(ptCentre);
+  }
+
+  // phi FFTs for the dense cell correlation (only if the FFT plugin of ROOT is available)
+  delete fBinnedFFTForward;
+  delete fBinnedFFTBackward;
+  fBinnedFFTForward  = TVirtualFFT::FFT(1,&fBinnedNCellsPhi,"R2C ES K");
+  fBinnedFFTBackward = TVirtualFFT::FFT(1,&fBinnedNCellsPhi,"C2R ES K");
+  if(!fBinnedFFTForward || !fBinnedFFTBackward)
+    AliWarning("No FFT available --> binned pairs use the sparse cell correlation only");
+
+  AliInfo(Form("Binned pairs: %d x %d single particle cells per Delta eta x Delta phi bin, %d pT groups",fBinnedSubBins,fBinnedSubBins,nGroups));
+  fBinnedStatus = 1;
+  return kTRUE;
+}
+
+//____________________________________________________________________//
+void AliBalancePsi::CalculateBalanceBinned(Double_t gReactionPlane,
+					   TObjArray *particles, 
+					   TObjArray *particlesMixed,
+					   Bool_t useMultOrCent,
+					   Double_t kMultorCent,
+					   Double_t vertexZ) {
+  // Fills the same histograms as the pair loop of CalculateBalance when the pair weights
+  // factorize (no pair cut). The trigger and associated particles are binned per event in
+  // (event class, pT group, charge, eta cell, phi cell) and the pair histograms are filled
+  // from the cross-correlation of the occupied cells, summing w1*w2 (and w1^2*w2^2 for the
+  // errors) per (Delta eta, Delta phi) bin: one AliTHn fill per bin instead of one per pair.
+  // NOTE: this is an approximation. Delta eta and Delta phi are taken from the difference of
+  // the cells, so the true pair values are smeared by up to one cell (1/fBinnedSubBins of the
+  // pair bin width, triangular distribution): pairs closer than one cell to a bin edge can be
+  // filled in the neighbouring bin. No cell size makes this exact, since two particles in fixed
+  // cells can always fall in two different (Delta eta, Delta phi) bins. The integrals and sumw2
+  // are exact, and so are the self-pairs, which are removed. With momentum ordering, the pairs
+  // of particles in the same pT group are still done with the explicit pair loop.
+  // The occupied cells of each (trigger key, associated key) are correlated pair by pair at low
+  // occupancy, and with an FFT in phi per pair of eta rows when that is cheaper (central events).
+  const Int_t iMax = particles->GetEntriesFast();
+  TObjArray* particlesSecond = (particlesMixed) ? particlesMixed : particles;
+  const Int_t jMax = particlesSecond->GetEntriesFast();
+
+  TAxis *axisClass  = fHistPN->GetAxis(0,0);
+  TAxis *axisVertex = fHistPN->GetAxis(5,0);
+  const Int_t nClass  = axisClass->GetNbins();
+  const Int_t nGroups = fBinnedPtEdges.GetSize() - 1;
+  const Int_t nDeltaPhi = fHistPN->GetAxis(2,0)->GetNbins();
+  const Int_t binVertex = axisVertex->FindBin(vertexZ);
+  const Bool_t fillPairs = (binVertex >= 1 && binVertex <= axisVertex->GetNbins() && nGroups > 0);
+
+  Double_t trackVariablesSingle[kTrackVariablesSingle];
+  Double_t trackVariablesPair[kTrackVariablesPair];
+
+  // triggers: single particle histograms and cells
+  vector<BinnedParticle> trig;
+  trig.reserve(iMax);
+  for (Int_t i = 0; i < iMax; i++) {
+    AliBFBasicParticle* firstParticle = (AliBFBasicParticle*) particles->At(i);
+    BinnedParticle p;
+    p.fIndex      = i;
+    p.fEta        = firstParticle->Eta();
+    p.fPhi        = firstParticle->Phi();
+    p.fPt         = firstParticle->Pt();
+    p.fCharge     = (Short_t) firstParticle->Charge();
+    p.fCorrection = firstParticle->Correction();
+
+    Double_t gPsiMinusPhi    = TMath::Abs(p.fPhi - gReactionPlane);
+    Double_t gPsiMinusPhiBin = GetPsiMinusPhiBin(gPsiMinusPhi);
+    fHistPsiMinusPhi->Fill(gPsiMinusPhiBin,gPsiMinusPhi);
+
+    trackVariablesSingle[0]    =  (useMultOrCent) ? kMultorCent : gPsiMinusPhiBin;
+    trackVariablesSingle[1]    =  p.fPt;
+    trackVariablesSingle[2]    =  vertexZ;
+    if(p.fCharge > 0)      fHistP->Fill(trackVariablesSingle,0,p.fCorrection);
+    else if(p.fCharge < 0) fHistN->Fill(trackVariablesSingle,0,p.fCorrection);
+
+    if(!fillPairs || p.fCharge == 0) continue;
+    p.fClass = trackVariablesSingle[0];
+    Int_t binClass = axisClass->FindBin(p.fClass);
+    p.fGroup = TMath::BinarySearch(nGroups+1,fBinnedPtEdges.GetArray(),(Double_t)p.fPt);
+    if(binClass < 1 || binClass > nClass || p.fGroup < 0 || p.fGroup >= nGroups) continue;
+    if(fBinnedPtTrigBin[p.fGroup] < 1 || fBinnedPtTrigBin[p.fGroup] > fHistPN->GetAxis(3,0)->GetNbins()) continue;
+    p.fKey     = ((binClass - 1)*nGroups + p.fGroup)*2 + (p.fCharge > 0 ? 1 : 0);
+    p.fCellEta = (Int_t)TMath::Floor(p.fEta/fBinnedCellEta + 0.5);
+    p.fCellPhi = ((Int_t)TMath::Floor(p.fPhi/fBinnedCellPhi + 0.5) % fBinnedNCellsPhi + fBinnedNCellsPhi) % fBinnedNCellsPhi;
+    trig.push_back(p);
+  }
+  if(!fillPairs) return;
+
+  // associated particles
+  vector<BinnedParticle> assoc;
+  assoc.reserve(jMax);
+  for (Int_t j = 0; j < jMax; j++) {
+    AliBFBasicParticle* secondParticle = (AliBFBasicParticle*) particlesSecond->At(j);
+    BinnedParticle p;
+    p.fIndex      = j;
+    p.fEta        = secondParticle->Eta();
+    p.fPhi        = secondParticle->Phi();
+    p.fPt         = secondParticle->Pt();
+    p.fCharge     = (Short_t) secondParticle->Charge();
+    p.fCorrection = secondParticle->Correction();
+    p.fClass      = 0.;
+    if(p.fCharge == 0) continue;
+    p.fGroup = TMath::BinarySearch(nGroups+1,fBinnedPtEdges.GetArray(),(Double_t)p.fPt);
+    if(p.fGroup < 0 || p.fGroup >= nGroups) continue;
+    if(fBinnedPtAssocBin[p.fGroup] < 1 || fBinnedPtAssocBin[p.fGroup] > fHistPN->GetAxis(4,0)->GetNbins()) continue;
+    p.fKey     = p.fGroup*2 + (p.fCharge > 0 ? 1 : 0);
+    p.fCellEta = (Int_t)TMath::Floor(p.fEta/fBinnedCellEta);
+    p.fCellPhi = ((Int_t)TMath::Floor(p.fPhi/fBinnedCellPhi) % fBinnedNCellsPhi + fBinnedNCellsPhi) % fBinnedNCellsPhi;
+    assoc.push_back(p);
+  }
+  if(trig.empty() || assoc.empty()) return;
+
+  // with momentum ordering, pairs inside the same pT group are not ordered by the groups: pair loop
+  if(fMomentumOrdering) {
+    std::sort(trig.begin(),trig.end(),BinnedParticle::CompareGroup);
+    std::sort(assoc.begin(),assoc.end(),BinnedParticle::CompareGroup);
+    UInt_t jStart = 0;
+    for(UInt_t i = 0; i < trig.size(); i++) {
+      const BinnedParticle &first = trig[i];
+      while(jStart < assoc.size() && assoc[jStart].fGroup < first.fGroup) jStart++;
+      for(UInt_t j = jStart; j < assoc.size() && assoc[j].fGroup == first.fGroup; j++) {
+	const BinnedParticle &second = assoc[j];
+	if(!particlesMixed && first.fIndex == second.fIndex) continue;
+	if(first.fPt < second.fPt) continue;
+	
+	trackVariablesPair[0]    =  first.fClass;
+	trackVariablesPair[1]    =  first.fEta - second.fEta;  // delta eta
+	trackVariablesPair[2]    =  first.fPhi - second.fPhi;  // delta phi
+	if (trackVariablesPair[2] > TMath::Pi()) // delta phi between -pi and pi 
+	  trackVariablesPair[2] -= 2.*TMath::Pi();
+	if (trackVariablesPair[2] <  - TMath::Pi()) 
+	  trackVariablesPair[2] += 2.*TMath::Pi();
+	if (trackVariablesPair[2] <  - TMath::Pi()/2.) 
+	  trackVariablesPair[2] += 2.*TMath::Pi();
+	trackVariablesPair[3]    =  first.fPt;      // pt trigger
+	trackVariablesPair[4]    =  second.fPt;     // pt
+	trackVariablesPair[5]    =  vertexZ;        // z of the primary vertex
+
+	Double_t weight = first.fCorrection*second.fCorrection;
+	if( first.fCharge > 0 && second.fCharge < 0)       fHistPN->Fill(trackVariablesPair,0,weight);
+	else if( first.fCharge < 0 && second.fCharge > 0)  fHistNP->Fill(trackVariablesPair,0,weight);
+	else if( first.fCharge > 0 && second.fCharge > 0)  fHistPP->Fill(trackVariablesPair,0,weight);
+	else                                               fHistNN->Fill(trackVariablesPair,0,weight);
+      }
+    }
+  }
+
+  // merge the particles in the same cell
+  vector<BinnedCell> trigCells, assocCells;
+  BinnedCell::MakeCells(trig,trigCells);
+  BinnedCell::MakeCells(assoc,assocCells);
+
+  // cross-correlation of the cells for each (trigger group, associated group)
+  const Int_t nEtaDiff = 2*fBinnedNDeltaEtaCells + 1;
+  Double_t *sumW  = fBinnedSumW.GetArray();
+  Double_t *sumW2 = fBinnedSumW2.GetArray();
+  vector<Int_t> touched;
+  Int_t binIdx[kTrackVariablesPair];
+  binIdx[5] = binVertex;
+
+  // blocks of cells with the same key
+  vector<UInt_t> trigBlocks, assocBlocks;
+  for(UInt_t i = 0; i < trigCells.size(); i++)
+    if(i == 0 || trigCells[i].fKey != trigCells[i-1].fKey) trigBlocks.push_back(i);
+  trigBlocks.push_back(trigCells.size());
+  for(UInt_t i = 0; i < assocCells.size(); i++)
+    if(i == 0 || assocCells[i].fKey != assocCells[i-1].fKey) assocBlocks.push_back(i);
+  assocBlocks.push_back(assocCells.size());
+
+  // phi spectra of the eta rows of the blocks, made when a block pair is correlated with the FFT
+  vector<BinnedRows> trigRows(trigBlocks.size()-1), assocRows(assocBlocks.size()-1);
+  BinnedSpectrumSum spectrumSum;
+
+  for(UInt_t iTrigBlock = 0; iTrigBlock + 1 < trigBlocks.size(); iTrigBlock++) {
+    const UInt_t iTrigStart = trigBlocks[iTrigBlock], iTrigEnd = trigBlocks[iTrigBlock+1];
+    const Int_t keyTrig = trigCells[iTrigStart].fKey;
+    const Int_t chargeTrig = keyTrig % 2;
+    const Int_t groupTrig  = (keyTrig/2) % nGroups;
+    binIdx[0] = keyTrig/(2*nGroups) + 1;
+    binIdx[3] = fBinnedPtTrigBin[groupTrig];
+
+    for(UInt_t iAssocBlock = 0; iAssocBlock + 1 < assocBlocks.size(); iAssocBlock++) {
+      const UInt_t iAssocStart = assocBlocks[iAssocBlock], iAssocEnd = assocBlocks[iAssocBlock+1];
+      const Int_t keyAssoc = assocCells[iAssocStart].fKey;
+      const Int_t chargeAssoc = keyAssoc % 2;
+      const Int_t groupAssoc  = keyAssoc/2;
+      if(fMomentumOrdering && groupTrig <= groupAssoc) continue;
+
+      // dense correlation (FFT in phi, loop over the pairs of eta rows) when the number
+      // of occupied cell pairs exceeds its cost, i.e. at high occupancy
+      Bool_t dense = kFALSE;
+      if(fBinnedFFTForward && fBinnedFFTBackward) {
+	BinnedRows &rowsTrig  = trigRows[iTrigBlock];
+	BinnedRows &rowsAssoc = assocRows[iAssocBlock];
+	Double_t costSparse = (Double_t)(iTrigEnd - iTrigStart)*(iAssocEnd - iAssocStart);
+	Double_t costDense  = (Double_t)BinnedRows::CountRows(trigCells,iTrigStart,iTrigEnd)*BinnedRows::CountRows(assocCells,iAssocStart,iAssocEnd)*(fBinnedNCellsPhi/2 + 1)
+	  + (Double_t)nEtaDiff*fBinnedNCellsPhi*TMath::Log2((Double_t)fBinnedNCellsPhi);
+	dense = (costSparse > 2.*costDense);
+	if(dense) {
+	  if(!rowsTrig.fDone)  rowsTrig.Make(trigCells,iTrigStart,iTrigEnd,fBinnedNCellsPhi,fBinnedFFTForward);
+	  if(!rowsAssoc.fDone) rowsAssoc.Make(assocCells,iAssocStart,iAssocEnd,fBinnedNCellsPhi,fBinnedFFTForward);
+	  spectrumSum.Correlate(rowsTrig,rowsAssoc,fBinnedNDeltaEtaCells,fBinnedNCellsPhi,fBinnedFFTBackward);
+	  const Bool_t unitWeights = rowsTrig.fUnitWeights && rowsAssoc.fUnitWeights;
+	  for(Int_t iEta = 0; iEta < nEtaDiff; iEta++) {
+	    if(!spectrumSum.fUsed[iEta]) continue;
+	    const Double_t *w  = &spectrumSum.fW[iEta*fBinnedNCellsPhi];
+	    const Double_t *w2 = unitWeights ? w : &spectrumSum.fW2[iEta*fBinnedNCellsPhi];
+	    for(Int_t iPhi = 0; iPhi < fBinnedNCellsPhi; iPhi++) {
+	      // the FFT leaves rounding errors of the order of 1e-12 of the total weight in the empty cells
+	      if(TMath::Abs(w[iPhi]) < spectrumSum.fTolerance) continue;
+	      Int_t bin = fBinnedLookup[iEta*fBinnedNCellsPhi + iPhi];
+	      if(bin < 0) continue;
+	      if(sumW[bin] == 0. && sumW2[bin] == 0.) touched.push_back(bin);
+	      sumW[bin]  += w[iPhi];
+	      sumW2[bin] += w2[iPhi];
+	    }
+	  }
+	}
+      }
+
+      if(!dense) {
+	for(UInt_t it = iTrigStart; it < iTrigEnd; it++) {
+	  const BinnedCell &cellTrig = trigCells[it];
+	  for(UInt_t ia = iAssocStart; ia < iAssocEnd; ia++) {
+	    const BinnedCell &cellAssoc = assocCells[ia];
+	    Int_t iEta = cellTrig.fEta - cellAssoc.fEta + fBinnedNDeltaEtaCells;
+	    if(iEta < 0 || iEta >= nEtaDiff) continue;
+	    Int_t iPhi = cellTrig.fPhi - cellAssoc.fPhi;
+	    if(iPhi < 0) iPhi += fBinnedNCellsPhi;
+	    Int_t bin = fBinnedLookup[iEta*fBinnedNCellsPhi + iPhi];
+	    if(bin < 0) continue;
+	    if(sumW[bin] == 0. && sumW2[bin] == 0.) touched.push_back(bin);
+	    sumW[bin]  += cellTrig.fW*cellAssoc.fW;
+	    sumW2[bin] += cellTrig.fW2*cellAssoc.fW2;
+	  }
+	}
+      }
+
+      AliTHn *hist = 0;
+      if(chargeTrig == 1 && chargeAssoc == 0)      hist = fHistPN;
+      else if(chargeTrig == 0 && chargeAssoc == 1) hist = fHistNP;
+      else if(chargeTrig == 1)                     hist = fHistPP;
+      else                                         hist = fHistNN;
+      binIdx[4] = fBinnedPtAssocBin[groupAssoc];
+      for(UInt_t iBin = 0; iBin < touched.size(); iBin++) {
+	Int_t bin = touched[iBin];
+	if(sumW[bin] == 0. && sumW2[bin] == 0.) continue;
+	binIdx[1] = bin/nDeltaPhi + 1;
+	binIdx[2] = bin%nDeltaPhi + 1;
+	hist->FillBin(binIdx,0,sumW[bin],sumW2[bin]);
+	sumW[bin]  = 0.;
+	sumW2[bin] = 0.;
+      }
+      touched.clear();
+    }
+  }
+
+  // remove the self-pairs (same event, and only without momentum ordering,
+  // otherwise they are in the pair loop above)
+  if(!particlesMixed && !fMomentumOrdering) {
+    vector<Int_t> assocCellEta(jMax,0), assocCellPhi(jMax,0);
+    vector<Bool_t> isAssoc(jMax,kFALSE);
+    for(UInt_t j = 0; j < assoc.size(); j++) {
+      isAssoc[assoc[j].fIndex]      = kTRUE;
+      assocCellEta[assoc[j].fIndex] = assoc[j].fCellEta;
+      assocCellPhi[assoc[j].fIndex] = assoc[j].fCellPhi;
+    }
+    for(UInt_t i = 0; i < trig.size(); i++) {
+      const BinnedParticle &p = trig[i];
+      if(!isAssoc[p.fIndex]) continue;
+      Int_t iEta = p.fCellEta - assocCellEta[p.fIndex] + fBinnedNDeltaEtaCells;
+      Int_t iPhi = p.fCellPhi - assocCellPhi[p.fIndex];
+      if(iPhi < 0) iPhi += fBinnedNCellsPhi;
+      Int_t bin = fBinnedLookup[iEta*fBinnedNCellsPhi + iPhi];
+      if(bin < 0) continue;
+      binIdx[0] = axisClass->FindBin(p.fClass);
+      binIdx[1] = bin/nDeltaPhi + 1;
+      binIdx[2] = bin%nDeltaPhi + 1;
+      binIdx[3] = fBinnedPtTrigBin[p.fGroup];
+      binIdx[4] = fBinnedPtAssocBin[p.fGroup];
+      Double_t w2 = p.fCorrection*p.fCorrection;
+      AliTHn *hist = (p.fCharge > 0) ? fHistPP : fHistNN;
+      hist->FillBin(binIdx,0,-w2,-w2*w2);
+    }
+  }
+}
+
 //____________________________________________________________________//
 TH1D *AliBalancePsi::GetBalanceFunctionHistogram(Int_t iVariableSingle,
 						 Int_t iVariablePair,
@@ -16,6 +16,8 @@
 #include <TObject.h>
 #include "TString.h"
 #include "TH2D.h"
+#include "TArrayI.h"
+#include "TArrayD.h"
 
 #include "AliTHn.h"
 
@@ -28,6 +30,7 @@ using std::vector;
 class TH1D;
 class TH2D;
 class TH3D;
+class TVirtualFFT;
 
 const Int_t kTrackVariablesSingle = 3;       // track variables in histogram (event class, pTtrig, vertexZ)
 const Int_t kTrackVariablesPair   = 6;       // track variables in histogram (event class, dEta, dPhi, pTtrig, ptAssociated, vertexZ)
@@ -234,6 +237,10 @@ class AliBalancePsi : public TObject {
     fConversionCut = kTRUE; fInvMassCutConversion = setInvMassCutConversion; }
   void UseMomentumDifferenceCut(Double_t gDeltaPtCutMin) {
     fQCut = kTRUE; fDeltaPtMin = gDeltaPtCutMin;}
+  // fill the pair histograms from binned single particle distributions (see CalculateBalanceBinned)
+  // approximate: Delta eta and Delta phi are smeared by up to 1/nSubBins of the bin width
+  void UseBinnedPairs(Bool_t useBinnedPairs = kTRUE, Int_t nSubBins = 4) {
+    fUseBinnedPairs = useBinnedPairs; fBinnedSubBins = (nSubBins > 0) ? nSubBins : 1; fBinnedStatus = 0;}
 
   // related to customized binning of output AliTHn
   Bool_t    IsUseVertexBinning() { return fVertexBinning; }
@@ -242,6 +249,14 @@ class AliBalancePsi : public TObject {
 
  private:
   Float_t   GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign); 
+  Double_t  GetPsiMinusPhiBin(Double_t gPsiMinusPhi) const;
+  Bool_t    InitBinnedPairs();
+  void      CalculateBalanceBinned(Double_t gReactionPlane,
+				   TObjArray* particles,
+				   TObjArray* particlesMixed,
+				   Bool_t useMultOrCent,
+				   Double_t kMultorCent,
+				   Double_t vertexZ);
 
   Bool_t fShuffle; //shuffled balance function object
   TString fAnalysisLevel; //ESD, AOD or MC
@@ -294,9 +309,25 @@ class AliBalancePsi : public TObject {
 
   TString fEventClass;
 
+  Bool_t fUseBinnedPairs;//fill the pairs from binned single particle distributions when no pair cut is used
+  Int_t fBinnedSubBins;//number of single particle cells per Delta eta (Delta phi) bin for the binned pairs
+  Int_t fBinnedStatus;//! 0: not initialized, 1: binned pairs usable, -1: not usable with this binning
+  Double_t fBinnedCellEta;//! single particle cell size in eta
+  Double_t fBinnedCellPhi;//! single particle cell size in phi
+  Int_t fBinnedNCellsPhi;//! number of single particle cells in phi
+  Int_t fBinnedNDeltaEtaCells;//! maximum |eta cell difference| in the lookup table
+  TArrayI fBinnedLookup;//! (eta cell difference, phi cell difference) -> (Delta eta, Delta phi) bin
+  TArrayD fBinnedPtEdges;//! union of the pT trigger and pT associated bin edges
+  TArrayI fBinnedPtTrigBin;//! pT trigger bin of each pT group
+  TArrayI fBinnedPtAssocBin;//! pT associated bin of each pT group
+  TArrayD fBinnedSumW;//! per event sum of weights in the (Delta eta, Delta phi) bins
+  TArrayD fBinnedSumW2;//! per event sum of squared weights in the (Delta eta, Delta phi) bins
+  TVirtualFFT *fBinnedFFTForward;//! phi FFT of the cell rows (dense cell correlation)
+  TVirtualFFT *fBinnedFFTBackward;//! inverse phi FFT of the cell row correlations
+
   AliBalancePsi & operator=(const AliBalancePsi & ) {return *this;}
 
-  ClassDef(AliBalancePsi, 3)
+  ClassDef(AliBalancePsi, 5)
 };
 
 #endif
@@ -17,6 +17,7 @@
 #pragma link C++ class AliDielectronQnEPcorrection+;
 #pragma link C++ class AliDielectronEvtVsTrkHist+;
 #pragma link C++ class AliDielectronVarManager+;
+#pragma link C++ class AliDielectronVarCache+;
 #pragma link C++ class AliAnalysisTaskDielectronFilter+;
 #pragma link C++ class AliAnalysisTaskMultiDielectron+;
 #pragma link C++ class AliAnalysisTaskRandomRejection+;
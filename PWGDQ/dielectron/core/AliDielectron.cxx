@@ -63,6 +63,7 @@ The names are available via the function PairClassName(Int_t i)
 #include "AliDielectronCF.h"
 #include "AliDielectronMC.h"
 #include "AliDielectronVarManager.h"
+#include "AliDielectronVarCache.h"
 #include "AliDielectronTrackRotator.h"
 #include "AliDielectronDebugTree.h"
 #include "AliDielectronSignalMC.h"
@@ -160,6 +161,8 @@ AliDielectron::AliDielectron() :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fUseVarCache(kTRUE),
+  fVarCache(0x0),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -237,6 +240,8 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fUseVarCache(kTRUE),
+  fVarCache(0x0),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -276,6 +281,7 @@ AliDielectron::~AliDielectron()
   if (fSignalsMC) delete fSignalsMC;
   if (fCfManagerPair) delete fCfManagerPair;
   if (fHistoArray) delete fHistoArray;
+  if (fVarCache) delete fVarCache;
 }
 
 //________________________________________________________________
@@ -542,6 +548,9 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
   if (fHistoArray && fHistoArray->IsEventArray())
     fHistoArray->Fill(0,const_cast<Double_t *>(AliDielectronVarManager::GetData()),0x0,0x0);
 
+  // the tracks of this event must not be found in the cache of the next one
+  ResetVarCache();
+
   // clear arrays
   if (!fDontClearArrays) ClearArrays();
 
@@ -701,6 +710,7 @@ void AliDielectron::FillHistogramsTracks(TObjArray **tracks)
   TString  className,className2;
   Double_t values[AliDielectronVarManager::kNMaxValues];
   AliDielectronVarManager::SetFillMap(fUsedVars);
+  ResetVarCache();
 
   //Fill track information, separately for the track array candidates
   for (Int_t i=0; i<2; ++i){
@@ -708,7 +718,7 @@ void AliDielectron::FillHistogramsTracks(TObjArray **tracks)
     if (!fHistos->GetHistogramList()->FindObject(className.Data())) continue;
     Int_t ntracks=tracks[i]->GetEntriesFast();
     for (Int_t itrack=0; itrack<ntracks; ++itrack){
-      AliDielectronVarManager::Fill(tracks[i]->UncheckedAt(itrack), values);
+      FillValues(tracks[i]->UncheckedAt(itrack), values);
       fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
     }
   }
@@ -743,6 +753,7 @@ void AliDielectron::FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly)
   TString  className,className2;
   Double_t values[AliDielectronVarManager::kNMaxValues]={0.};
   AliDielectronVarManager::SetFillMap(fUsedVars);
+  ResetVarCache();
 
   //Fill event information
   if (ev){
@@ -761,7 +772,7 @@ void AliDielectron::FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly)
       if (!trkClass && !mergedtrkClass) continue;
       Int_t ntracks=fTracks[i].GetEntriesFast();
       for (Int_t itrack=0; itrack<ntracks; ++itrack){
-        AliDielectronVarManager::Fill(fTracks[i].UncheckedAt(itrack), values);
+        FillValues(fTracks[i].UncheckedAt(itrack), values);
         if(trkClass)
           fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
         if(mergedtrkClass && i<2)
@@ -793,12 +804,12 @@ void AliDielectron::FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly)
         AliVParticle *d1=pair->GetFirstDaughterP();
         AliVParticle *d2=pair->GetSecondDaughterP();
         if (!arrLegs.FindObject(d1)){
-          AliDielectronVarManager::Fill(d1, values);
+          FillValues(d1, values);
           fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
           arrLegs.Add(d1);
         }
         if (!arrLegs.FindObject(d2)){
-          AliDielectronVarManager::Fill(d2, values);
+          FillValues(d2, values);
           fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
           arrLegs.Add(d2);
         }
@@ -844,15 +855,41 @@ void AliDielectron::FillHistogramsPair(AliDielectronPair *pair,Bool_t fromPreFil
 
   if (legClass){
     AliVParticle *d1=pair->GetFirstDaughterP();
-    AliDielectronVarManager::Fill(d1, values);
+    FillValues(d1, values);
     fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
 
     AliVParticle *d2=pair->GetSecondDaughterP();
-    AliDielectronVarManager::Fill(d2, values);
+    FillValues(d2, values);
     fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
   }
 }
 
+//________________________________________________________________
+void AliDielectron::FillValues(const TObject *particle, Double_t * const values)
+{
+  //
+  // Fill the values of a track or pair for histogramming
+  // The values of the tracks are taken from the cache, if already computed
+  // since the last ResetVarCache()
+  //
+  if (!fUseVarCache) {
+    AliDielectronVarManager::Fill(particle, values);
+    return;
+  }
+  if (!fVarCache) fVarCache=new AliDielectronVarCache;
+  fVarCache->Fill(particle, values);
+}
+
+//________________________________________________________________
+void AliDielectron::ResetVarCache()
+{
+  //
+  // Forget the cached track values. To be called whenever the tracks may be
+  // deleted or the event information changes
+  //
+  if (fVarCache) fVarCache->Reset();
+}
+
 //________________________________________________________________
 void AliDielectron::FillTrackArrays(AliVEvent * const ev, Int_t eventNr)
 {
@@ -1192,6 +1229,7 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
   Bool_t prefilterAllSigns = prefilterN == 1 ? fPreFilterAllSigns1 : fPreFilterAllSigns2;
   Bool_t prefilterPhotons = prefilterN == 1 ? fPreFilterPhotons1 : fPreFilterPhotons2;
   Bool_t prefilterOnlyOnePair = prefilterN == 1 ? fPreFilterOnlyOnePair1 : fPreFilterOnlyOnePair2;
+  ResetVarCache();
 
   Int_t ntrack1=arrTracks1.GetEntriesFast();
   Int_t ntrack2=arrTracks2.GetEntriesFast();
@@ -1479,6 +1517,7 @@ void AliDielectron::FillPairArrayTR()
   // select pairs and fill pair candidate arrays
   //
   UInt_t selectedMask=(1<<fPairFilter.GetCuts()->GetEntries())-1;
+  ResetVarCache();
 
   while ( fTrackRotator->NextCombination() ){
     if(fTrackRotator->SameTracks() ) continue;
@@ -2141,6 +2180,7 @@ void AliDielectron::FillHistogramsFromPairArray(Bool_t pairInfoOnly/*=kFALSE*/)
   TString  className,className2;
   Double_t values[AliDielectronVarManager::kNMaxValues]={0.};
   AliDielectronVarManager::SetFillMap(fUsedVars);
+  ResetVarCache();
   AliDielectronVarManager::SetLegEffMap(fLegEffMap);
   AliDielectronVarManager::SetPairEffMap(fPairEffMap);
 
@@ -2200,12 +2240,12 @@ void AliDielectron::FillHistogramsFromPairArray(Bool_t pairInfoOnly/*=kFALSE*/)
         AliVParticle *d1=pair->GetFirstDaughterP();
         AliVParticle *d2=pair->GetSecondDaughterP();
         if (!arrLegs.FindObject(d1)){
-          AliDielectronVarManager::Fill(d1, values);
+          FillValues(d1, values);
           fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
           arrLegs.Add(d1);
         }
         if (!arrLegs.FindObject(d2)){
-          AliDielectronVarManager::Fill(d2, values);
+          FillValues(d2, values);
           fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
           arrLegs.Add(d2);
         }
@@ -39,6 +39,7 @@ class AliDielectronTrackRotator;
 class AliDielectronPair;
 class AliDielectronSignalMC;
 class AliDielectronMixingHandler;
+class AliDielectronVarCache;
 
 //________________________________________________________________
 class AliDielectron : public TNamed {
@@ -147,6 +148,8 @@ public:
   void SetStoreRotatedPairs(Bool_t storeTR) {fStoreRotatedPairs = storeTR;}
   void SetDontClearArrays(Bool_t dontClearArrays=kTRUE) { fDontClearArrays=dontClearArrays; }
   Bool_t DontClearArrays() const { return fDontClearArrays; }
+  void SetUseVarCache(Bool_t useCache=kTRUE) { fUseVarCache=useCache; }
+  Bool_t GetUseVarCache() const { return fUseVarCache; }
 
   void AddSignalMC(AliDielectronSignalMC* signal);
 
@@ -273,6 +276,8 @@ private:
   Bool_t fDontClearArrays;      //Don't clear the arrays at the end of the Process function, needed for external use of pair and tracks
   Bool_t fEventProcess;         //Process event (or pair array)
   Bool_t fUseGammaTracks;       // use function SetGammaTracks for MCtruth photons
+  Bool_t fUseVarCache;          // compute the values of a track only once per event (legs, rotated pairs, track classes)
+  AliDielectronVarCache *fVarCache; //! per-event cache of the track values
 
   void FillTrackArrays(AliVEvent * const ev, Int_t eventNr=0);
   void EventPlanePreFilter(Int_t arr1, Int_t arr2, TObjArray arrTracks1, TObjArray arrTracks2, const AliVEvent *ev);
@@ -309,10 +314,13 @@ private:
 
   void  FillDebugTree();
 
+  void  FillValues(const TObject *particle, Double_t * const values);
+  void  ResetVarCache();
+
   AliDielectron(const AliDielectron &c);
   AliDielectron &operator=(const AliDielectron &c);
 
-  ClassDef(AliDielectron,17);
+  ClassDef(AliDielectron,18);
 };
 
 inline void AliDielectron::InitPairCandidateArrays()
@@ -0,0 +1,108 @@
+/*************************************************************************
+* Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+///////////////////////////////////////////////////////////////////////////
+//   Per-particle cache of the values filled by AliDielectronVarManager  //
+//                                                                       //
+//   Only the single particle variables are stored. The event variables  //
+//   are always taken from the current event data of the var manager,   //
+//   and kRndm is drawn again for each fill, as in a fill without cache. //
+///////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include <TBits.h>
+#include <TRandom.h>
+
+#include "AliDielectronPair.h"
+#include "AliDielectronVarManager.h"
+#include "AliDielectronVarCache.h"
+
+ClassImp(AliDielectronVarCache)
+
+AliDielectronVarCache::AliDielectronVarCache() :
+  TObject(),
+  fIndex(),
+  fValues(),
+  fNCached(0),
+  fNHits(0),
+  fFillMap(0x0)
+{
+  //
+  // Default Constructor
+  //
+}
+
+//______________________________________________
+AliDielectronVarCache::~AliDielectronVarCache()
+{
+  //
+  // Default Destructor
+  //
+}
+
+//______________________________________________
+void AliDielectronVarCache::Reset()
+{
+  //
+  // forget all the cached particles (the memory is kept for the next event)
+  //
+  fIndex.Delete();
+  fNCached=0;
+}
+
+//______________________________________________
+void AliDielectronVarCache::Fill(const TObject *particle, Double_t * const values)
+{
+  //
+  // Fill the values of particle, computing them only the first time
+  // the particle is seen since the last Reset()
+  //
+  const Int_t nParticleValues=AliDielectronVarManager::kParticleMax;
+
+  if (particle->IsA()==AliDielectronPair::Class()){
+    AliDielectronVarManager::Fill(particle, values);
+    return;
+  }
+
+  const TBits *fillMap=AliDielectronVarManager::GetFillMap();
+  if (fillMap!=fFillMap){
+    Reset();
+    fFillMap=fillMap;
+  }
+
+  const Long64_t key=(Long64_t)(ULong_t)particle;
+  Long64_t slot=fIndex.GetValue(key);
+  if (slot>0){
+    const Double_t *cached=fValues.GetArray()+(slot-1)*AliDielectronVarManager::kPairMax;
+    memcpy(values, cached, nParticleValues*sizeof(Double_t));
+    // track variables which are stored in the pair range
+    values[AliDielectronVarManager::kLogDCAXY]=cached[AliDielectronVarManager::kLogDCAXY];
+    values[AliDielectronVarManager::kLogDCAZ] =cached[AliDielectronVarManager::kLogDCAZ];
+    values[AliDielectronVarManager::kRndm]    =gRandom->Rndm();
+    const Double_t *data=AliDielectronVarManager::GetData();
+    for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i) values[i]=data[i];
+    ++fNHits;
+    return;
+  }
+
+  AliDielectronVarManager::Fill(particle, values);
+
+  if ((fNCached+1)*AliDielectronVarManager::kPairMax>fValues.GetSize())
+    fValues.Set(2*(fNCached+1)*AliDielectronVarManager::kPairMax);
+  memcpy(fValues.GetArray()+fNCached*AliDielectronVarManager::kPairMax, values, AliDielectronVarManager::kPairMax*sizeof(Double_t));
+  ++fNCached;
+  fIndex.Add(key, fNCached);
+}
@@ -0,0 +1,56 @@
+#ifndef ALIDIELECTRONVARCACHE_H
+#define ALIDIELECTRONVARCACHE_H
+
+/* Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//#############################################################
+//#                                                           #
+//#         Class AliDielectronVarCache                       #
+//#       Per-particle cache of the values filled by          #
+//#           AliDielectronVarManager                         #
+//#                                                           #
+//#  The same track is filled many times per event: once per  #
+//#  histogram class, as leg of every pair it belongs to and  #
+//#  for every rotated pair. The cache keeps the values of    #
+//#  each track filled since the last Reset(), so that they   #
+//#  are computed only once. Pairs are never cached.          #
+//#                                                           #
+//#  The cache is only valid as long as the particles are not #
+//#  deleted and the event does not change: the owner has to  #
+//#  call Reset() accordingly. It is also reset automatically #
+//#  when the fill map of the var manager changes.            #
+//#                                                           #
+//#############################################################
+
+#include <TObject.h>
+#include <TArrayD.h>
+#include <TExMap.h>
+
+class TBits;
+
+class AliDielectronVarCache : public TObject {
+public:
+  AliDielectronVarCache();
+  virtual ~AliDielectronVarCache();
+
+  void Fill(const TObject *particle, Double_t * const values);
+  void Reset();
+
+  Int_t GetNCached() const { return fNCached; }
+  Long64_t GetNHits() const { return fNHits; }
+
+private:
+  AliDielectronVarCache(const AliDielectronVarCache &c);
+  AliDielectronVarCache &operator=(const AliDielectronVarCache &c);
+
+  TExMap       fIndex;      //! particle pointer -> 1 + position of its values in fValues
+  TArrayD      fValues;     //! values of the cached particles
+  Int_t        fNCached;    //! number of cached particles
+  Long64_t     fNHits;      //! number of fills served from the cache
+  const TBits *fFillMap;    //! fill map used for the cached values
+
+  ClassDef(AliDielectronVarCache,1)         // Per-particle cache of AliDielectronVarManager values
+};
+
+#endif
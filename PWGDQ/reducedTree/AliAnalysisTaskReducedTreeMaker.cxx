@@ -100,6 +100,7 @@ AliAnalysisTaskReducedTreeMaker::AliAnalysisTaskReducedTreeMaker() :
   fRejectPileup(kFALSE),
   fTreeWritingOption(kBaseEventsWithBaseTracks),
   fWriteTree(kTRUE),
+  fTreeSplitLevel(99),
   fMinSelectedTracks(0),
   fMinSelectedBaseTracks(0),
   fScaleDownEvents(0.0),
@@ -173,6 +174,7 @@ AliAnalysisTaskReducedTreeMaker::AliAnalysisTaskReducedTreeMaker(const char *nam
   fRejectPileup(kFALSE),
   fTreeWritingOption(kBaseEventsWithBaseTracks),
   fWriteTree(writeTree),
+  fTreeSplitLevel(99),
   fMinSelectedTracks(0),
   fMinSelectedBaseTracks(0),
   fScaleDownEvents(0.0),
@@ -336,7 +338,7 @@ void AliAnalysisTaskReducedTreeMaker::UserCreateOutputObjects()
   };
 
 	if(fWriteTree) {
-    fTree->Branch("Event",&fReducedEvent,16000,99);
+    fTree->Branch("Event",&fReducedEvent,16000,fTreeSplitLevel);
 
 		// if user set active branches
 		TObjArray* aractive=fActiveBranches.Tokenize(";");
@@ -91,6 +91,10 @@ public:
   // Suppress writing the tree to disk
   void SetWriteTree(Bool_t option=kTRUE)  {fWriteTree = option;}
   Bool_t WriteTree() const {return fWriteTree;}
+  // Split level of the event branch; with the default (99) every data member of the event and of the tracks
+  //   is written in its own branch, which allows the readers to skip the unused ones (see AliReducedEventInputHandler::SetPruneUnusedBranches())
+  void SetTreeSplitLevel(Int_t level=99)  {fTreeSplitLevel = level;}
+  Int_t GetTreeSplitLevel() const {return fTreeSplitLevel;}
   
   // Toggle on/off information branches
   void SetFillTrackInfo(Bool_t flag=kTRUE)        {fFillTrackInfo = flag;}
@@ -140,6 +144,7 @@ public:
   
   Int_t     fTreeWritingOption;                 // one of the options described by ETreeWritingOptions
   Bool_t    fWriteTree;                         // if kFALSE don't write the tree, use task only to produce on the fly reduced events
+  Int_t     fTreeSplitLevel;                    // split level of the event branch (default 99, fully split)
   Int_t     fMinSelectedTracks;                 // minimum number of selected full tracks (in AliReducedBaseEvent::fTracks) for the event to be written (defaults to 0)
   Int_t     fMinSelectedBaseTracks;             // minimum number of selected base tracks (in AliReducedBaseEvent::fTracks2) for the event to be written (defaults to 0)
   Double_t  fScaleDownEvents;                   // allow writing events which do not fulfill the minimum number of tracks criteria with scale down factor (default is zero)
@@ -225,6 +230,6 @@ public:
   AliAnalysisTaskReducedTreeMaker(const AliAnalysisTaskReducedTreeMaker &c);
   AliAnalysisTaskReducedTreeMaker& operator= (const AliAnalysisTaskReducedTreeMaker &c);
 
-  ClassDef(AliAnalysisTaskReducedTreeMaker, 12); //Analysis Task for creating a reduced event information tree
+  ClassDef(AliAnalysisTaskReducedTreeMaker, 13); //Analysis Task for creating a reduced event information tree
 };
 #endif
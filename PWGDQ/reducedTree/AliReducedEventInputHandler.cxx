@@ -5,9 +5,14 @@
 
 #include <TTree.h>
 #include <TFile.h>
+#include <TObjArray.h>
 #include "AliReducedEventInputHandler.h"
 #include "AliReducedBaseEvent.h"
 #include "AliReducedEventInfo.h"
+#include "AliReducedVarManager.h"
+#include "AliAnalysisManager.h"
+#include "AliAnalysisTaskReducedEventProcessor.h"
+#include "AliLog.h"
 
 ClassImp(AliReducedEventInputHandler)
 
@@ -15,6 +20,7 @@ ClassImp(AliReducedEventInputHandler)
 AliReducedEventInputHandler::AliReducedEventInputHandler() :
     AliInputEventHandler(),
     fEventInputOption(kReducedBaseEvent),
+    fPruneUnusedBranches(kFALSE),
     fReducedEvent(0)
 {
   // Default constructor
@@ -24,6 +30,7 @@ AliReducedEventInputHandler::AliReducedEventInputHandler() :
 AliReducedEventInputHandler::AliReducedEventInputHandler(const char* name, const char* title):
   AliInputEventHandler(name, title),
   fEventInputOption(kReducedBaseEvent),
+  fPruneUnusedBranches(kFALSE),
   fReducedEvent(0)
  {
     // Constructor
@@ -45,6 +52,7 @@ Bool_t AliReducedEventInputHandler::Init(TTree* tree, Option_t* opt)
 
     SwitchOffBranches();
     SwitchOnBranches();
+    if(fPruneUnusedBranches) PruneUnusedBranches();
     
     // Get pointer to the event
     if (!fReducedEvent) {
@@ -62,6 +70,48 @@ Bool_t AliReducedEventInputHandler::Init(TTree* tree, Option_t* opt)
     return kTRUE;
 }
 
+//______________________________________________________________________________
+void AliReducedEventInputHandler::PruneUnusedBranches()
+{
+    // Switch off the track data members which are not needed by any of the variables
+    // requested in AliReducedVarManager (histograms, cuts, mixing), so that their baskets are not
+    // read and decompressed. Only effective for trees written with a split event branch.
+    // Pruning is refused if a task writes filtered trees, since the events would be written with the
+    // switched off members zeroed.
+    if(HasTreeWritingTask()) {
+       AliWarning("A task writing filtered reduced trees is attached, the unused branches are NOT switched off");
+       return;
+    }
+    if(!AliReducedVarManager::HasUsedVars()) {
+       AliWarning("No variables are flagged as used in AliReducedVarManager, all the branches are kept active");
+       return;
+    }
+    TObjArray* branches = AliReducedVarManager::GetUnusedTrackBranches().Tokenize(";");
+    UInt_t found = 0;
+    Int_t nOff = 0;
+    for(Int_t i=0; i<branches->GetEntries(); ++i) {
+       found = 0;
+       fTree->SetBranchStatus(branches->At(i)->GetName(), 0, &found);   // passing found silences the missing branch errors
+       if(found) ++nOff;
+    }
+    AliInfo(Form("Switched off %d unused track branch groups", nOff));
+    delete branches;
+}
+
+//______________________________________________________________________________
+Bool_t AliReducedEventInputHandler::HasTreeWritingTask() const
+{
+    // Check whether one of the tasks of the analysis manager writes the reduced events into an output tree
+    AliAnalysisManager* mgr = AliAnalysisManager::GetAnalysisManager();
+    if(!mgr || !mgr->GetTasks()) return kFALSE;
+    TIter next(mgr->GetTasks());
+    TObject* task = 0;
+    while((task = next())) {
+       AliAnalysisTaskReducedEventProcessor* processor = dynamic_cast<AliAnalysisTaskReducedEventProcessor*>(task);
+       if(processor && processor->GetWriteFilteredTree()) return kTRUE;
+    }
+    return kFALSE;
+}
 
 //______________________________________________________________________________
 Bool_t AliReducedEventInputHandler::BeginEvent(Long64_t entry)
@@ -33,16 +33,24 @@ class AliReducedEventInputHandler : public AliInputEventHandler {
              
                  void                                SetInputEventType(Int_t type) {fEventInputOption = type;} ;
                  Int_t                               GetInputEventType() const {return fEventInputOption;};
+                 // read only the track branches needed by the variables used in AliReducedVarManager (requires a split tree)
+                 // NOTE: ignored if a task writes filtered trees, which need all the members of the events
+                 void                                SetPruneUnusedBranches(Bool_t option=kTRUE) {fPruneUnusedBranches = option;}
+                 Bool_t                              GetPruneUnusedBranches() const {return fPruneUnusedBranches;}
                  
  private:
     AliReducedEventInputHandler(const AliReducedEventInputHandler& handler);             
     AliReducedEventInputHandler& operator=(const AliReducedEventInputHandler& handler);      
     
+    void   PruneUnusedBranches();
+    Bool_t HasTreeWritingTask() const;
+    
     Int_t  fEventInputOption;                          // one of the options listed in EReducedEventInputType
+    Bool_t fPruneUnusedBranches;                       // switch off the track branches not needed by the used variables
     AliReducedBaseEvent* fReducedEvent;   //! Pointer to the event
     //AliReducedEventInfo* fReducedEvent;   //! Pointer to the event
     
-    ClassDef(AliReducedEventInputHandler, 2);
+    ClassDef(AliReducedEventInputHandler, 3);
 };
 
 #endif
@@ -27,6 +27,7 @@ using std::ifstream;
 #include <TProfile2D.h>
 #include <TFile.h>
 #include <THashList.h>
+#include <TObjArray.h>
 
 #include "AliReducedBaseEvent.h"
 #include "AliReducedEventInfo.h"
@@ -346,6 +347,71 @@ void AliReducedVarManager::SetVariableDependencies() {
   }
 }
 
+//__________________________________________________________________
+Bool_t AliReducedVarManager::HasUsedVars() {
+  //
+  // Check whether any variable was requested
+  //
+  for(Int_t i=0; i<kNVars; ++i)
+    if(fgUsedVars[i]) return kTRUE;
+  return kFALSE;
+}
+
+//__________________________________________________________________
+TString AliReducedVarManager::GetUnusedTrackBranches() {
+  //
+  // Build the list of track data members which are not needed for any of the used variables.
+  // The detector blocks listed below are accessed only via the variables filled in FillTrackInfo() and
+  // FillPairInfo(), so their branches can be switched off when reading a split reduced tree.
+  // The MC truth block is not included since it is also accessed directly by the analysis tasks.
+  // The returned list is ";" separated, one entry for each of the two track arrays (fTracks and fTracks2).
+  //
+  const Int_t kNBlocks = 6;
+  const Char_t* blockBranches[kNBlocks] = {
+    "fITSsignal;fITSnSig*",                 // ITS pid
+    "fTOF*",                                // TOF
+    "fTRDntracklets*;fTRDpid*",             // TRD offline
+    "fTRDGTU*",                             // TRD online tracks
+    "fCaloClusterId",                       // EMCAL matching
+    "fHelix*"                               // helix parameters
+  };
+  const Int_t blockVars[kNBlocks][2] = {    // [first, last] variable depending on each block
+    {kITSsignal, kITSnSig+3},
+    {kTOFbeta, kTOFnSig+3},
+    {kTRDntracklets, kTRDpidProbabilitiesLQ2D+1},
+    {kTRDGTUtracklets, kTRDGTUPID},
+    {kEMCALmatchedEnergy, kEMCALdispersion},
+    {kDMA, kDMA}
+  };
+  
+  TString blocks = "";
+  for(Int_t ib=0; ib<kNBlocks; ++ib) {
+    Bool_t used = kFALSE;
+    for(Int_t iv=blockVars[ib][0]; iv<=blockVars[ib][1]; ++iv)
+      if(fgUsedVars[iv]) {used = kTRUE; break;}
+    if(used) continue;
+    if(!blocks.IsNull()) blocks += ";";
+    blocks += blockBranches[ib];
+  }
+  // the track parameters and covariance matrix are needed only for the KF pair vertexing
+  if(!fgUsedVars[kPseudoProperDecayTime] && !fgUsedVars[kPairLxy]) {
+    if(!blocks.IsNull()) blocks += ";";
+    blocks += "fTrackParam*;fCovMatrix*";
+  }
+  
+  TString branches = "";
+  TObjArray* arr = blocks.Tokenize(";");
+  const Char_t* trackArrays[2] = {"fTracks", "fTracks2"};
+  for(Int_t ia=0; ia<2; ++ia) {
+    for(Int_t i=0; i<arr->GetEntries(); ++i) {
+      if(!branches.IsNull()) branches += ";";
+      branches += Form("%s.%s", trackArrays[ia], arr->At(i)->GetName());
+    }
+  }
+  delete arr;
+  return branches;
+}
+
 //__________________________________________________________________
 void AliReducedVarManager::FillEventInfo(Float_t* values) {
   //
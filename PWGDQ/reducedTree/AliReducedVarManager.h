@@ -634,6 +634,8 @@ class AliReducedVarManager : public TObject {
     SetVariableDependencies();
   }
   static Bool_t GetUsedVar(Variables var) {return fgUsedVars[var];}
+  static Bool_t HasUsedVars();
+  static TString GetUnusedTrackBranches();     // ";" separated list of track branches which are not needed by any of the used variables
   
   static void FillEventInfo(Float_t* values);
   static void FillEventInfo(AliReducedBaseEvent* event, Float_t* values, AliReducedEventPlaneInfo* eventPlane=0x0);
@@ -749,7 +751,7 @@ class AliReducedVarManager : public TObject {
   AliReducedVarManager(AliReducedVarManager const&);
   AliReducedVarManager& operator=(AliReducedVarManager const&);  
   
-  ClassDef(AliReducedVarManager, 6);
+  ClassDef(AliReducedVarManager, 7);
 };
 
 #endif
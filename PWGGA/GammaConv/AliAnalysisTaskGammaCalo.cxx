@@ -80,6 +80,9 @@ AliAnalysisTaskGammaCalo::AliAnalysisTaskGammaCalo(): AliAnalysisTaskSE(),
   fClusterTreeList(NULL),
   fOutputContainer(NULL),
   fClusterCandidates(NULL),
+  fPairCandidates(NULL),
+  fPairCandidatesPhotons(),
+  fBGCandidatePool(NULL),
   fEventCutArray(NULL),
   fEventCuts(NULL),
   fClusterCutArray(NULL),
@@ -420,6 +423,9 @@ AliAnalysisTaskGammaCalo::AliAnalysisTaskGammaCalo(const char *name):
   fClusterTreeList(NULL),
   fOutputContainer(0),
   fClusterCandidates(NULL),
+  fPairCandidates(NULL),
+  fPairCandidatesPhotons(),
+  fBGCandidatePool(NULL),
   fEventCutArray(NULL),
   fEventCuts(NULL),
   fClusterCutArray(NULL),
@@ -748,6 +754,14 @@ AliAnalysisTaskGammaCalo::~AliAnalysisTaskGammaCalo()
     delete fClusterCandidates;
     fClusterCandidates = 0x0;
   }
+  if(fPairCandidates){
+    delete fPairCandidates;
+    fPairCandidates = 0x0;
+  }
+  if(fBGCandidatePool){
+    delete fBGCandidatePool;
+    fBGCandidatePool = 0x0;
+  }
   if(fBGHandler){
     delete[] fBGHandler;
     fBGHandler = 0x0;
@@ -1096,6 +1110,10 @@ void AliAnalysisTaskGammaCalo::UserCreateOutputObjects(){
   fClusterCandidates  = new TList();
   fClusterCandidates->SetOwner(kTRUE);
 
+  // Storage for the meson candidates, reused from event to event
+  fPairCandidates     = new TClonesArray("AliAODConversionMother",100);
+  fBGCandidatePool    = new TClonesArray("AliAODConversionMother",1);
+
   fCutFolder          = new TList*[fnCuts];
   fESDList            = new TList*[fnCuts];
   if(fDoTHnSparse){
@@ -2832,6 +2850,9 @@ void AliAnalysisTaskGammaCalo::UserExec(Option_t *)
   if(fIsHeavyIon ==1)fEventPlaneAngle = EventPlane->GetEventplane("V0",fInputEvent,2);
   else fEventPlaneAngle=0.0;
 
+  // the same event pairs are built again for the first cut of every event
+  fPairCandidatesPhotons.clear();
+
   for(Int_t iCut = 0; iCut<fnCuts; iCut++){
 
     fiCut = iCut;
@@ -4303,193 +4324,241 @@ void AliAnalysisTaskGammaCalo::ProcessMCParticles()
   }
 }
 
+//________________________________________________________________________
+void AliAnalysisTaskGammaCalo::BuildPairCandidates(){
+
+  // Fill fPairCandidates with the same event photon pairs of fClusterCandidates.
+  // The pair kinematics do not depend on the meson cut, so the table is only
+  // rebuilt if the photons differ from the ones it was built from: the cut
+  // configurations sharing the cluster cut reuse the pairs of the first one.
+  // The mothers carry the photon indices as labels.
+  Int_t nPhotons = fClusterCandidates->GetEntries();
+  const Int_t nPhotonValues = 8;
+
+  Bool_t sameCandidates = ((Int_t)fPairCandidatesPhotons.size() == nPhotonValues*nPhotons && nPhotons > 1);
+  for(Int_t iGamma=0;iGamma<nPhotons && sameCandidates;iGamma++){
+    AliAODConversionPhoton *gamma=(AliAODConversionPhoton*)(fClusterCandidates->At(iGamma));
+    const Double_t *values = &fPairCandidatesPhotons[nPhotonValues*iGamma];
+    sameCandidates = gamma && values[0] == gamma->Px() && values[1] == gamma->Py() && values[2] == gamma->Pz() && values[3] == gamma->E() &&
+                     values[4] == gamma->GetConversionX() && values[5] == gamma->GetConversionY() && values[6] == gamma->GetConversionZ() &&
+                     values[7] == gamma->GetCaloClusterRef() + 1000.*gamma->GetPhotonQuality();
+  }
+  if(sameCandidates) return;
+
+  fPairCandidates->Clear();
+  fPairCandidatesPhotons.clear();
+  if(nPhotons < 2) return;
+
+  // accept the photons once for the timing selection instead of once per pair
+  vector<Bool_t> isFirstGamma(nPhotons,kTRUE), isSecondGamma(nPhotons,kTRUE);
+  fPairCandidatesPhotons.reserve(nPhotonValues*nPhotons);
+  for(Int_t iGamma=0;iGamma<nPhotons;iGamma++){
+    AliAODConversionPhoton *gamma=dynamic_cast<AliAODConversionPhoton*>(fClusterCandidates->At(iGamma));
+    if (gamma==NULL){
+      isFirstGamma[iGamma] = isSecondGamma[iGamma] = kFALSE;
+      for(Int_t iValue=0;iValue<nPhotonValues;iValue++) fPairCandidatesPhotons.push_back(0.);
+      continue;
+    }
+    if ( fDoInOutTimingCluster ){
+      Double_t tof = fInputEvent->GetCaloCluster(gamma->GetCaloClusterRef())->GetTOF();
+      if ( tof < fMinTimingCluster || tof > fMaxTimingCluster ) isFirstGamma[iGamma] = kFALSE;
+      if ( tof > fMinTimingCluster && tof < fMaxTimingCluster ) isSecondGamma[iGamma] = kFALSE;
+    }
+    fPairCandidatesPhotons.push_back(gamma->Px());
+    fPairCandidatesPhotons.push_back(gamma->Py());
+    fPairCandidatesPhotons.push_back(gamma->Pz());
+    fPairCandidatesPhotons.push_back(gamma->E());
+    fPairCandidatesPhotons.push_back(gamma->GetConversionX());
+    fPairCandidatesPhotons.push_back(gamma->GetConversionY());
+    fPairCandidatesPhotons.push_back(gamma->GetConversionZ());
+    fPairCandidatesPhotons.push_back(gamma->GetCaloClusterRef() + 1000.*gamma->GetPhotonQuality());
+  }
+
+  Int_t nPairs = 0;
+  for(Int_t firstGammaIndex=0;firstGammaIndex<nPhotons;firstGammaIndex++){
+    if (!isFirstGamma[firstGammaIndex]) continue;
+    AliAODConversionPhoton *gamma0=(AliAODConversionPhoton*)(fClusterCandidates->At(firstGammaIndex));
+    for(Int_t secondGammaIndex=firstGammaIndex+1;secondGammaIndex<nPhotons;secondGammaIndex++){
+      if (!isSecondGamma[secondGammaIndex]) continue;
+      AliAODConversionPhoton *gamma1=(AliAODConversionPhoton*)(fClusterCandidates->At(secondGammaIndex));
+      AliAODConversionMother *pi0cand = new((*fPairCandidates)[nPairs++]) AliAODConversionMother(gamma0,gamma1);
+      pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
+    }
+  }
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskGammaCalo::CalculatePi0Candidates(){
 
   // Conversion Gammas
   if(fClusterCandidates->GetEntries()>0){
 
-    for(Int_t firstGammaIndex=0;firstGammaIndex<fClusterCandidates->GetEntries();firstGammaIndex++){
-      AliAODConversionPhoton *gamma0=dynamic_cast<AliAODConversionPhoton*>(fClusterCandidates->At(firstGammaIndex));
-      if (gamma0==NULL) continue;
-      if ( fDoInOutTimingCluster ){
-        Double_t tof = fInputEvent->GetCaloCluster(gamma0->GetCaloClusterRef())->GetTOF();
-        if ( tof < fMinTimingCluster || tof > fMaxTimingCluster ) continue;
-      }
-
-      for(Int_t secondGammaIndex=firstGammaIndex+1;secondGammaIndex<fClusterCandidates->GetEntries();secondGammaIndex++){
-        AliAODConversionPhoton *gamma1=dynamic_cast<AliAODConversionPhoton*>(fClusterCandidates->At(secondGammaIndex));
-        if (gamma1==NULL) continue;
-        if ( fDoInOutTimingCluster ){
-          Double_t tof = fInputEvent->GetCaloCluster(gamma1->GetCaloClusterRef())->GetTOF();
-          if ( tof > fMinTimingCluster && tof < fMaxTimingCluster ) continue;
-        }
+    BuildPairCandidates();
+    for(Int_t iPair=0;iPair<fPairCandidates->GetEntriesFast();iPair++){
+      AliAODConversionMother *pi0cand = (AliAODConversionMother*)(fPairCandidates->UncheckedAt(iPair));
+      AliAODConversionPhoton *gamma0=(AliAODConversionPhoton*)(fClusterCandidates->At(pi0cand->GetLabel1()));
+      AliAODConversionPhoton *gamma1=(AliAODConversionPhoton*)(fClusterCandidates->At(pi0cand->GetLabel2()));
 
-        Double_t tempPi0CandWeight       = fWeightJetJetMC;
-        // Set the pi0 candidate jetjet weight to 1 in case both photons orignated from the minimum bias header
-        if (fIsMC>0 && ((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetSignalRejection() == 4){
-          if( ((AliConvEventCuts*)fEventCutArray->At(fiCut))->IsParticleFromBGEvent(gamma0->GetCaloPhotonMCLabel(0), fMCEvent, fInputEvent) == 2 &&
-              ((AliConvEventCuts*)fEventCutArray->At(fiCut))->IsParticleFromBGEvent(gamma1->GetCaloPhotonMCLabel(0), fMCEvent, fInputEvent) == 2)
-            tempPi0CandWeight = 1;
-        }
-        AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
-        pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
+      Double_t tempPi0CandWeight       = fWeightJetJetMC;
+      // Set the pi0 candidate jetjet weight to 1 in case both photons orignated from the minimum bias header
+      if (fIsMC>0 && ((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetSignalRejection() == 4){
+        if( ((AliConvEventCuts*)fEventCutArray->At(fiCut))->IsParticleFromBGEvent(gamma0->GetCaloPhotonMCLabel(0), fMCEvent, fInputEvent) == 2 &&
+            ((AliConvEventCuts*)fEventCutArray->At(fiCut))->IsParticleFromBGEvent(gamma1->GetCaloPhotonMCLabel(0), fMCEvent, fInputEvent) == 2)
+          tempPi0CandWeight = 1;
+      }
 
-        if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(),gamma0->GetLeadingCellID(),gamma1->GetLeadingCellID()))){
-          if(fLocalDebugFlag == 1) DebugMethodPrint1(pi0cand,gamma0,gamma1);
-          fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), tempPi0CandWeight);
-          if(fDoJetAnalysis){
-            if(fConvJetReader->GetNJets()>0){
-              fVectorJetPt = fConvJetReader->GetVectorJetPt();
-              fVectorJetPx = fConvJetReader->GetVectorJetPx();
-              fVectorJetPy = fConvJetReader->GetVectorJetPy();
-              fVectorJetPz = fConvJetReader->GetVectorJetPz();
-              fVectorJetEta = fConvJetReader->GetVectorJetEta();
-              fVectorJetPhi = fConvJetReader->GetVectorJetPhi();
-              fHistoJetMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), tempPi0CandWeight);
-              Double_t RJetPi0Cand = 0;
-              if(fVectorJetPt.size() == fConvJetReader->GetNJets() && fVectorJetEta.size() == fConvJetReader->GetNJets() && fVectorJetPhi.size() == fConvJetReader->GetNJets()){
-                Int_t counter = 0;
-                for(Int_t i=0; i<fConvJetReader->GetNJets(); i++){
-                  Double_t DeltaEta = fVectorJetEta.at(i)-pi0cand->Eta();
-                  Double_t DeltaPhi = abs(fVectorJetPhi.at(i)-pi0cand->Phi());
-                  if(DeltaPhi > M_PI) {
-                      DeltaPhi = 2*M_PI - DeltaPhi;
-                  }
-                  RJetPi0Cand = TMath::Sqrt(pow((DeltaEta),2)+pow((DeltaPhi),2));
-                  fHistoRJetPi0Cand[fiCut]->Fill(RJetPi0Cand,pi0cand->Pt(), tempPi0CandWeight);
-                  fHistoEtaPhiJetPi0Cand[fiCut]->Fill(DeltaPhi,DeltaEta, tempPi0CandWeight);
-                  if(fConvJetReader->Get_Jet_Radius() > 0 ){
-                    if(RJetPi0Cand < fConvJetReader->Get_Jet_Radius()){
-                      counter ++;
-                      fHistoPi0InJetMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), tempPi0CandWeight);
-                      fHistoEtaPhiJetWithPi0Cand[fiCut]->Fill(DeltaPhi, DeltaEta, tempPi0CandWeight);
-                      Double_t PtRatio = pi0cand->Pt()/(fVectorJetPt.at(i));
-                      fHistoJetPi0PtRatio[fiCut]->Fill(PtRatio);
-                      Double_t dotproduct = fVectorJetPx.at(i)*pi0cand->Px() + fVectorJetPy.at(i)*pi0cand->Py() + fVectorJetPz.at(i)*pi0cand->Pz();
-                      Double_t magn = pow(fVectorJetPx.at(i),2) + pow(fVectorJetPy.at(i),2) + pow(fVectorJetPz.at(i),2);
-                      Double_t z = dotproduct/magn;
-                      fHistoJetFragmFunc[fiCut]->Fill(z,fVectorJetPt.at(i));
-
-                      if(fDoJetQA){
-                        if(fIsMC > 0 && fConvJetReader->GetTrueNJets()>0){
-                          fTrueVectorJetPt = fConvJetReader->GetTrueVectorJetPt();
-                          fTrueVectorJetEta = fConvJetReader->GetTrueVectorJetEta();
-                          fTrueVectorJetPhi = fConvJetReader->GetTrueVectorJetPhi();
-                          Double_t min = 100;
-                          Int_t match = 0;
-                          for(Int_t j = 0; j<fConvJetReader->GetTrueNJets(); j++){
-                            Double_t R_jetjet;
-                            DeltaEta = fVectorJetEta.at(i)-fTrueVectorJetEta.at(j);
-                            DeltaPhi = abs(fVectorJetPhi.at(i)-fTrueVectorJetPhi.at(j));
-                            if(DeltaPhi > M_PI) {
-                              DeltaPhi = 2*M_PI - DeltaPhi;
-                            }
-                            R_jetjet = TMath::Sqrt(pow((DeltaEta),2)+pow((DeltaPhi),2));
-                            if(R_jetjet < min){
-                              min = R_jetjet;
-                              match = j;
-                            }
+      if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(),gamma0->GetLeadingCellID(),gamma1->GetLeadingCellID()))){
+        if(fLocalDebugFlag == 1) DebugMethodPrint1(pi0cand,gamma0,gamma1);
+        fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), tempPi0CandWeight);
+        if(fDoJetAnalysis){
+          if(fConvJetReader->GetNJets()>0){
+            fVectorJetPt = fConvJetReader->GetVectorJetPt();
+            fVectorJetPx = fConvJetReader->GetVectorJetPx();
+            fVectorJetPy = fConvJetReader->GetVectorJetPy();
+            fVectorJetPz = fConvJetReader->GetVectorJetPz();
+            fVectorJetEta = fConvJetReader->GetVectorJetEta();
+            fVectorJetPhi = fConvJetReader->GetVectorJetPhi();
+            fHistoJetMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), tempPi0CandWeight);
+            Double_t RJetPi0Cand = 0;
+            if(fVectorJetPt.size() == fConvJetReader->GetNJets() && fVectorJetEta.size() == fConvJetReader->GetNJets() && fVectorJetPhi.size() == fConvJetReader->GetNJets()){
+              Int_t counter = 0;
+              for(Int_t i=0; i<fConvJetReader->GetNJets(); i++){
+                Double_t DeltaEta = fVectorJetEta.at(i)-pi0cand->Eta();
+                Double_t DeltaPhi = abs(fVectorJetPhi.at(i)-pi0cand->Phi());
+                if(DeltaPhi > M_PI) {
+                    DeltaPhi = 2*M_PI - DeltaPhi;
+                }
+                RJetPi0Cand = TMath::Sqrt(pow((DeltaEta),2)+pow((DeltaPhi),2));
+                fHistoRJetPi0Cand[fiCut]->Fill(RJetPi0Cand,pi0cand->Pt(), tempPi0CandWeight);
+                fHistoEtaPhiJetPi0Cand[fiCut]->Fill(DeltaPhi,DeltaEta, tempPi0CandWeight);
+                if(fConvJetReader->Get_Jet_Radius() > 0 ){
+                  if(RJetPi0Cand < fConvJetReader->Get_Jet_Radius()){
+                    counter ++;
+                    fHistoPi0InJetMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), tempPi0CandWeight);
+                    fHistoEtaPhiJetWithPi0Cand[fiCut]->Fill(DeltaPhi, DeltaEta, tempPi0CandWeight);
+                    Double_t PtRatio = pi0cand->Pt()/(fVectorJetPt.at(i));
+                    fHistoJetPi0PtRatio[fiCut]->Fill(PtRatio);
+                    Double_t dotproduct = fVectorJetPx.at(i)*pi0cand->Px() + fVectorJetPy.at(i)*pi0cand->Py() + fVectorJetPz.at(i)*pi0cand->Pz();
+                    Double_t magn = pow(fVectorJetPx.at(i),2) + pow(fVectorJetPy.at(i),2) + pow(fVectorJetPz.at(i),2);
+                    Double_t z = dotproduct/magn;
+                    fHistoJetFragmFunc[fiCut]->Fill(z,fVectorJetPt.at(i));
+
+                    if(fDoJetQA){
+                      if(fIsMC > 0 && fConvJetReader->GetTrueNJets()>0){
+                        fTrueVectorJetPt = fConvJetReader->GetTrueVectorJetPt();
+                        fTrueVectorJetEta = fConvJetReader->GetTrueVectorJetEta();
+                        fTrueVectorJetPhi = fConvJetReader->GetTrueVectorJetPhi();
+                        Double_t min = 100;
+                        Int_t match = 0;
+                        for(Int_t j = 0; j<fConvJetReader->GetTrueNJets(); j++){
+                          Double_t R_jetjet;
+                          DeltaEta = fVectorJetEta.at(i)-fTrueVectorJetEta.at(j);
+                          DeltaPhi = abs(fVectorJetPhi.at(i)-fTrueVectorJetPhi.at(j));
+                          if(DeltaPhi > M_PI) {
+                            DeltaPhi = 2*M_PI - DeltaPhi;
+                          }
+                          R_jetjet = TMath::Sqrt(pow((DeltaEta),2)+pow((DeltaPhi),2));
+                          if(R_jetjet < min){
+                            min = R_jetjet;
+                            match = j;
                           }
-                          fJetPt = fVectorJetPt.at(i);
-                          fTrueJetPt = fTrueVectorJetPt.at(match);
-                          fPi0Pt = pi0cand->Pt();
-                          fPi0InvMass = pi0cand->M();
-                          tTreeJetPi0Correlations[fiCut]->Fill();
-
-                          fTrueVectorJetPt.clear();
-                          fTrueVectorJetEta.clear();
-                          fTrueVectorJetPhi.clear();
                         }
+                        fJetPt = fVectorJetPt.at(i);
+                        fTrueJetPt = fTrueVectorJetPt.at(match);
+                        fPi0Pt = pi0cand->Pt();
+                        fPi0InvMass = pi0cand->M();
+                        tTreeJetPi0Correlations[fiCut]->Fill();
+
+                        fTrueVectorJetPt.clear();
+                        fTrueVectorJetEta.clear();
+                        fTrueVectorJetPhi.clear();
                       }
                     }
                   }
                 }
-                fHistoDoubleCounting[fiCut]->Fill(counter);
               }
-              fVectorJetPt.clear();
-              fVectorJetPx.clear();
-              fVectorJetPy.clear();
-              fVectorJetPz.clear();
-              fVectorJetEta.clear();
-              fVectorJetPhi.clear();
+              fHistoDoubleCounting[fiCut]->Fill(counter);
             }
+            fVectorJetPt.clear();
+            fVectorJetPx.clear();
+            fVectorJetPy.clear();
+            fVectorJetPz.clear();
+            fVectorJetEta.clear();
+            fVectorJetPhi.clear();
           }
-          // fill new histograms
-          if(!fDoLightOutput && TMath::Abs(pi0cand->GetAlpha())<0.1){
-            fHistoMotherInvMassECalib[fiCut]->Fill(pi0cand->M(),pi0cand->E(),tempPi0CandWeight);
-          }
+        }
+        // fill new histograms
+        if(!fDoLightOutput && TMath::Abs(pi0cand->GetAlpha())<0.1){
+          fHistoMotherInvMassECalib[fiCut]->Fill(pi0cand->M(),pi0cand->E(),tempPi0CandWeight);
+        }
 
-          if (fDoMesonQA > 0 && fDoMesonQA < 3){
-            if ( pi0cand->M() > 0.05 && pi0cand->M() < 0.17){
-              fHistoMotherPi0PtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(), tempPi0CandWeight);
-              fHistoMotherPi0PtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()), tempPi0CandWeight);
-              fHistoMotherPi0PtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(), tempPi0CandWeight);
-              fHistoMotherPi0NGoodESDTracksPt[fiCut]->Fill(fV0Reader->GetNumberOfPrimaryTracks(),pi0cand->Pt(), tempPi0CandWeight);
-            }
-            if ( pi0cand->M() > 0.45 && pi0cand->M() < 0.65){
-              fHistoMotherEtaPtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(), tempPi0CandWeight);
-              fHistoMotherEtaPtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()), tempPi0CandWeight);
-              fHistoMotherEtaPtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(),  tempPi0CandWeight);
-              fHistoMotherEtaNGoodESDTracksPt[fiCut]->Fill(fV0Reader->GetNumberOfPrimaryTracks(),pi0cand->Pt(), tempPi0CandWeight);
-            }
+        if (fDoMesonQA > 0 && fDoMesonQA < 3){
+          if ( pi0cand->M() > 0.05 && pi0cand->M() < 0.17){
+            fHistoMotherPi0PtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(), tempPi0CandWeight);
+            fHistoMotherPi0PtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()), tempPi0CandWeight);
+            fHistoMotherPi0PtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(), tempPi0CandWeight);
+            fHistoMotherPi0NGoodESDTracksPt[fiCut]->Fill(fV0Reader->GetNumberOfPrimaryTracks(),pi0cand->Pt(), tempPi0CandWeight);
           }
-          if (fDoMesonQA == 2){
-            fHistoMotherPtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(), tempPi0CandWeight);
+          if ( pi0cand->M() > 0.45 && pi0cand->M() < 0.65){
+            fHistoMotherEtaPtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(), tempPi0CandWeight);
+            fHistoMotherEtaPtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()), tempPi0CandWeight);
+            fHistoMotherEtaPtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(),  tempPi0CandWeight);
+            fHistoMotherEtaNGoodESDTracksPt[fiCut]->Fill(fV0Reader->GetNumberOfPrimaryTracks(),pi0cand->Pt(), tempPi0CandWeight);
           }
-          if(fDoTHnSparse && ((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->DoBGCalculation()){
-            Int_t zbin = 0;
-            Int_t mbin = 0;
-
-            if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
-              zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
-              if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
-                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
-              } else {
-                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fClusterCandidates->GetEntries());
-              }
+        }
+        if (fDoMesonQA == 2){
+          fHistoMotherPtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(), tempPi0CandWeight);
+        }
+        if(fDoTHnSparse && ((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->DoBGCalculation()){
+          Int_t zbin = 0;
+          Int_t mbin = 0;
+
+          if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
+            zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+            if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
+              mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
+            } else {
+              mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fClusterCandidates->GetEntries());
             }
-            Double_t sparesFill[4] = {pi0cand->M(),pi0cand->Pt(),(Double_t)zbin,(Double_t)mbin};
-            fSparseMotherInvMassPtZM[fiCut]->Fill(sparesFill,1);
           }
+          Double_t sparesFill[4] = {pi0cand->M(),pi0cand->Pt(),(Double_t)zbin,(Double_t)mbin};
+          fSparseMotherInvMassPtZM[fiCut]->Fill(sparesFill,1);
+        }
 
-          if(fDoMesonQA == 4  && fIsMC == 0 && (pi0cand->Pt() > 13.) ){
-            Int_t zbin = 0;
-            Int_t mbin = 0;
-            if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
-              zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
-              if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
-                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
-              } else {
-                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fClusterCandidates->GetEntries());
-              }
+        if(fDoMesonQA == 4  && fIsMC == 0 && (pi0cand->Pt() > 13.) ){
+          Int_t zbin = 0;
+          Int_t mbin = 0;
+          if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
+            zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+            if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
+              mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
+            } else {
+              mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fClusterCandidates->GetEntries());
             }
-            fInvMassTreeInvMass = pi0cand->M();
-            fInvMassTreePt = pi0cand->Pt();
-            fInvMassTreeAlpha = TMath::Abs(pi0cand->GetAlpha());
-            fInvMassTreeTheta = pi0cand->GetOpeningAngle();
-            fInvMassTreeMixPool = zbin*100 + mbin;
-            fInvMassTreeZVertex = fInputEvent->GetPrimaryVertex()->GetZ();
-            fInvMassTreeEta = pi0cand->Eta();
-            tSigInvMassPtAlphaTheta[fiCut]->Fill();
           }
+          fInvMassTreeInvMass = pi0cand->M();
+          fInvMassTreePt = pi0cand->Pt();
+          fInvMassTreeAlpha = TMath::Abs(pi0cand->GetAlpha());
+          fInvMassTreeTheta = pi0cand->GetOpeningAngle();
+          fInvMassTreeMixPool = zbin*100 + mbin;
+          fInvMassTreeZVertex = fInputEvent->GetPrimaryVertex()->GetZ();
+          fInvMassTreeEta = pi0cand->Eta();
+          tSigInvMassPtAlphaTheta[fiCut]->Fill();
+        }
 
-          if(fIsMC> 0){
-            if(fInputEvent->IsA()==AliESDEvent::Class())
-              ProcessTrueMesonCandidates(pi0cand,gamma0,gamma1);
-            if(fInputEvent->IsA()==AliAODEvent::Class())
-              ProcessTrueMesonCandidatesAOD(pi0cand,gamma0,gamma1);
-          }
+        if(fIsMC> 0){
+          if(fInputEvent->IsA()==AliESDEvent::Class())
+            ProcessTrueMesonCandidates(pi0cand,gamma0,gamma1);
+          if(fInputEvent->IsA()==AliAODEvent::Class())
+            ProcessTrueMesonCandidatesAOD(pi0cand,gamma0,gamma1);
+        }
 
-          if((pi0cand->GetOpeningAngle() < 0.017) && (pi0cand->Pt() > 15.) && fDoClusterQA > 1){
-            if (fCloseHighPtClusters == NULL){
-              fCloseHighPtClusters = new TObjString(Form("%s", ((TString)fV0Reader->GetCurrentFileName()).Data()));
-              if (tClusterQATree) tClusterQATree->Fill();
-            }
+        if((pi0cand->GetOpeningAngle() < 0.017) && (pi0cand->Pt() > 15.) && fDoClusterQA > 1){
+          if (fCloseHighPtClusters == NULL){
+            fCloseHighPtClusters = new TObjString(Form("%s", ((TString)fV0Reader->GetCurrentFileName()).Data()));
+            if (tClusterQATree) tClusterQATree->Fill();
           }
         }
-        delete pi0cand;
-        pi0cand=0x0;
       }
     }
   }
@@ -5722,10 +5791,10 @@ void AliAnalysisTaskGammaCalo::CalculateBackground(){
     for(Int_t nEventsInBG=0;nEventsInBG<fBGHandler[fiCut]->GetNBGEvents();nEventsInBG++){
       AliGammaConversionAODVector *previousEventV0s = fBGHandler[fiCut]->GetBGGoodV0s(zbin,mbin,nEventsInBG);
       for(Int_t iCurrent=0;iCurrent<fClusterCandidates->GetEntries();iCurrent++){
-        AliAODConversionPhoton currentEventGoodV0 = *(AliAODConversionPhoton*)(fClusterCandidates->At(iCurrent));
+        AliAODConversionPhoton &currentEventGoodV0 = *(AliAODConversionPhoton*)(fClusterCandidates->At(iCurrent));
         for(UInt_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
-          AliAODConversionPhoton previousGoodV0 = (AliAODConversionPhoton)(*(previousEventV0s->at(iPrevious)));
-          AliAODConversionMother *backgroundCandidate = new AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
+          AliAODConversionPhoton &previousGoodV0 = *(previousEventV0s->at(iPrevious));
+          AliAODConversionMother *backgroundCandidate = new((*fBGCandidatePool)[0]) AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
           backgroundCandidate->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
 
           // Set the BG candidate jetjet weight to 1 in case both photons orignated from the minimum bias header
@@ -5757,8 +5826,6 @@ void AliAnalysisTaskGammaCalo::CalculateBackground(){
               tBckInvMassPtAlphaTheta[fiCut]->Fill();
             }
           }
-          delete backgroundCandidate;
-          backgroundCandidate = 0x0;
         }
       }
     }
@@ -5802,10 +5869,10 @@ void AliAnalysisTaskGammaCalo::CalculateBackground(){
         }
         if(acceptedPtMax){
           for(Int_t iCurrent=0;iCurrent<fClusterCandidates->GetEntries();iCurrent++){
-            AliAODConversionPhoton currentEventGoodV0 = *(AliAODConversionPhoton*)(fClusterCandidates->At(iCurrent));
+            AliAODConversionPhoton &currentEventGoodV0 = *(AliAODConversionPhoton*)(fClusterCandidates->At(iCurrent));
             for(UInt_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
-              AliAODConversionPhoton previousGoodV0 = (AliAODConversionPhoton)(*(previousEventV0s->at(iPrevious)));
-              AliAODConversionMother *backgroundCandidate = new AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
+              AliAODConversionPhoton &previousGoodV0 = *(previousEventV0s->at(iPrevious));
+              AliAODConversionMother *backgroundCandidate = new((*fBGCandidatePool)[0]) AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
               backgroundCandidate->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
 
               // Set the BG candidate jetjet weight to 1 in case both photons orignated from the minimum bias header
@@ -5819,8 +5886,6 @@ void AliAnalysisTaskGammaCalo::CalculateBackground(){
                 ->MesonIsSelected(backgroundCandidate,kFALSE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()),currentEventGoodV0.GetLeadingCellID(),previousGoodV0.GetLeadingCellID())){
                 fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate->M(),backgroundCandidate->Pt(), tempBGCandidateWeight);
               }
-              delete backgroundCandidate;
-              backgroundCandidate = 0x0;
             }
           }
         }
@@ -5833,10 +5898,10 @@ void AliAnalysisTaskGammaCalo::CalculateBackground(){
         previousEventV0s = fBGHandler[fiCut]->GetBGGoodV0s(zbin,mbin,nEventsInBG);
         if(previousEventV0s && previousEventV0s->size()>0){
               for(Int_t iCurrent=0;iCurrent<fClusterCandidates->GetEntries();iCurrent++){
-                AliAODConversionPhoton currentEventGoodV0 = *(AliAODConversionPhoton*)(fClusterCandidates->At(iCurrent));
+                AliAODConversionPhoton &currentEventGoodV0 = *(AliAODConversionPhoton*)(fClusterCandidates->At(iCurrent));
                 for(UInt_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
-                  AliAODConversionPhoton previousGoodV0 = (AliAODConversionPhoton)(*(previousEventV0s->at(iPrevious)));
-                  AliAODConversionMother *backgroundCandidate = new AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
+                  AliAODConversionPhoton &previousGoodV0 = *(previousEventV0s->at(iPrevious));
+                  AliAODConversionMother *backgroundCandidate = new((*fBGCandidatePool)[0]) AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
                   backgroundCandidate->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
 
                   if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(backgroundCandidate,kFALSE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(),currentEventGoodV0.GetLeadingCellID(),previousGoodV0.GetLeadingCellID()))){
@@ -5874,8 +5939,6 @@ void AliAnalysisTaskGammaCalo::CalculateBackground(){
                       tBckInvMassPtAlphaTheta[fiCut]->Fill();
                     }
                   }
-                  delete backgroundCandidate;
-                  backgroundCandidate = 0x0;
                 }
               }
         }
@@ -5886,11 +5949,11 @@ void AliAnalysisTaskGammaCalo::CalculateBackground(){
       AliGammaConversionAODVector *previousEventV0s = fBGHandler[fiCut]->GetBGGoodV0s(zbin,mbin,nEventsInBG);
       if(previousEventV0s){
         for(Int_t iCurrent=0;iCurrent<fClusterCandidates->GetEntries();iCurrent++){
-          AliAODConversionPhoton currentEventGoodV0 = *(AliAODConversionPhoton*)(fClusterCandidates->At(iCurrent));
+          AliAODConversionPhoton &currentEventGoodV0 = *(AliAODConversionPhoton*)(fClusterCandidates->At(iCurrent));
           for(UInt_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
 
-            AliAODConversionPhoton previousGoodV0 = (AliAODConversionPhoton)(*(previousEventV0s->at(iPrevious)));
-            AliAODConversionMother *backgroundCandidate = new AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
+            AliAODConversionPhoton &previousGoodV0 = *(previousEventV0s->at(iPrevious));
+            AliAODConversionMother *backgroundCandidate = new((*fBGCandidatePool)[0]) AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
             backgroundCandidate->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
 
             if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(backgroundCandidate,kFALSE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(),currentEventGoodV0.GetLeadingCellID(),previousGoodV0.GetLeadingCellID()))){
@@ -5928,8 +5991,6 @@ void AliAnalysisTaskGammaCalo::CalculateBackground(){
                 tBckInvMassPtAlphaTheta[fiCut]->Fill();
               }
             }
-            delete backgroundCandidate;
-            backgroundCandidate = 0x0;
           }
         }
       }
@@ -41,6 +41,7 @@ class AliAnalysisTaskGammaCalo : public AliAnalysisTaskSE {
     void ProcessClusters();
     void ProcessJets();
     void CalculatePi0Candidates();
+    void BuildPairCandidates();
 
     // MC functions
     void SetIsMC(Int_t isMC){fIsMC=isMC;}
@@ -139,6 +140,9 @@ class AliAnalysisTaskGammaCalo : public AliAnalysisTaskSE {
     TList**               fClusterTreeList;                                     // Array of lists with tree for EoverP
     TList*                fOutputContainer;                                     // Output container
     TList*                fClusterCandidates;                                   //! current list of cluster candidates
+    TClonesArray*         fPairCandidates;                                      //! same event photon pairs of the current event, shared between cuts with the same photons
+    vector<Double_t>      fPairCandidatesPhotons;                               //! kinematics of the photons fPairCandidates was built from
+    TClonesArray*         fBGCandidatePool;                                     //! reused storage for the mixed event photon pairs
     TList*                fEventCutArray;                                       // List with Event Cuts
     AliConvEventCuts*     fEventCuts;                                           // EventCutObject
     TList*                fClusterCutArray;                                     // List with Cluster Cuts
@@ -485,7 +489,7 @@ class AliAnalysisTaskGammaCalo : public AliAnalysisTaskSE {
     AliAnalysisTaskGammaCalo(const AliAnalysisTaskGammaCalo&);                  // Prevent copy-construction
     AliAnalysisTaskGammaCalo &operator=(const AliAnalysisTaskGammaCalo&);       // Prevent assignment
 
-    ClassDef(AliAnalysisTaskGammaCalo, 53);
+    ClassDef(AliAnalysisTaskGammaCalo, 54);
 };
 
 #endif
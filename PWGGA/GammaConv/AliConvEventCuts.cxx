@@ -176,7 +176,13 @@ AliConvEventCuts::AliConvEventCuts(const char *name,const char *title) :
   fNameHistoReweightingMultMC(""),
   hReweightMultData(NULL),
   hReweightMultMC(NULL),
-  fDebugLevel(0)
+  fDebugLevel(0),
+  fBGEventLabelCache(),
+  fBGEventCacheMCEvent(NULL),
+  fBGEventCacheInputEvent(NULL),
+  fBGEventCacheAODMCArray(NULL),
+  fBGEventCacheEntry(-1),
+  fBGEventCacheValid(kFALSE)
 {
   for(Int_t jj=0;jj<kNCuts;jj++){fCuts[jj]=0;}
   fCutString=new TObjString((GetCutNumber()).Data());
@@ -292,7 +298,13 @@ AliConvEventCuts::AliConvEventCuts(const AliConvEventCuts &ref) :
   fNameHistoReweightingMultMC(ref.fNameHistoReweightingMultMC),
   hReweightMultData(ref.hReweightMultData),
   hReweightMultMC(ref.hReweightMultMC),
-  fDebugLevel(ref.fDebugLevel)
+  fDebugLevel(ref.fDebugLevel),
+  fBGEventLabelCache(),
+  fBGEventCacheMCEvent(NULL),
+  fBGEventCacheInputEvent(NULL),
+  fBGEventCacheAODMCArray(NULL),
+  fBGEventCacheEntry(-1),
+  fBGEventCacheValid(kFALSE)
 {
   // Copy Constructor
   for(Int_t jj=0;jj<kNCuts;jj++){fCuts[jj]=ref.fCuts[jj];}
@@ -4313,6 +4325,9 @@ TString AliConvEventCuts::GetCutNumber(){
 //________________________________________________________________________
 void AliConvEventCuts::GetNotRejectedParticles(Int_t rejection, TList *HeaderList, AliVEvent *event){
 
+  // the accepted headers change, the results of IsParticleFromBGEvent have to be recomputed
+  fBGEventCacheValid = kFALSE;
+
   if(fNotRejectedStart){
     delete[] fNotRejectedStart;
     fNotRejectedStart         = NULL;
@@ -4592,6 +4607,46 @@ Int_t AliConvEventCuts::IsParticleFromBGEvent(Int_t index, AliMCEvent *mcEvent,
   //   if (debug > 2 ) cout << index << endl;
   if(index < 0) return 0; // No Particle
 
+  CheckBGEventCache(mcEvent, InputEvent);
+  if(debug > 1) return FindParticleFromBGEvent(index, mcEvent, InputEvent, debug); // print the decision for every call
+
+  // the result is known if the particle (or one of its daughters) was already checked in this event
+  if(index < fBGEventLabelCache.GetSize() && fBGEventLabelCache[index] >= 0) return fBGEventLabelCache[index];
+
+  Int_t accepted = FindParticleFromBGEvent(index, mcEvent, InputEvent, debug);
+
+  if(index >= fBGEventLabelCache.GetSize()){
+    Int_t size = fBGEventLabelCache.GetSize();
+    fBGEventLabelCache.Set(TMath::Max(2*size, index+1));
+    for(Int_t i = size; i < fBGEventLabelCache.GetSize(); i++) fBGEventLabelCache[i] = -1;
+  }
+  fBGEventLabelCache[index] = accepted;
+
+  return accepted;
+}
+
+//_________________________________________________________________________
+void AliConvEventCuts::CheckBGEventCache(AliMCEvent *mcEvent, AliVEvent *InputEvent){
+
+  // the lookup table of IsParticleFromBGEvent is valid for one event and one set of accepted headers
+  AliAnalysisManager *man = AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = man ? man->GetCurrentEntry() : -1;
+  if(fBGEventCacheValid && mcEvent == fBGEventCacheMCEvent && InputEvent == fBGEventCacheInputEvent && entry == fBGEventCacheEntry) return;
+
+  fBGEventLabelCache.Reset(-1);
+  fBGEventCacheMCEvent    = mcEvent;
+  fBGEventCacheInputEvent = InputEvent;
+  fBGEventCacheEntry      = entry;
+  fBGEventCacheValid      = kTRUE;
+
+  fBGEventCacheAODMCArray = NULL;
+  if(InputEvent && InputEvent->IsA()==AliAODEvent::Class())
+    fBGEventCacheAODMCArray = dynamic_cast<TClonesArray*>(InputEvent->FindListObject(AliAODMCParticle::StdBranchName()));
+}
+
+//_________________________________________________________________________
+Int_t AliConvEventCuts::FindParticleFromBGEvent(Int_t index, AliMCEvent *mcEvent, AliVEvent *InputEvent, Int_t debug ){
+
   Int_t accepted = 0;
   if(!InputEvent || InputEvent->IsA()==AliESDEvent::Class()){
     if(!mcEvent) return 0; // no mcEvent available, return 0
@@ -4610,7 +4665,7 @@ Int_t AliConvEventCuts::IsParticleFromBGEvent(Int_t index, AliMCEvent *mcEvent,
     if (debug > 1 && !accepted) cout << "rejected:" << index << endl;
   }
   else if(InputEvent->IsA()==AliAODEvent::Class()){
-    TClonesArray *AODMCTrackArray = dynamic_cast<TClonesArray*>(InputEvent->FindListObject(AliAODMCParticle::StdBranchName()));
+    TClonesArray *AODMCTrackArray = fBGEventCacheAODMCArray;
     if (AODMCTrackArray){
       AliAODMCParticle *aodMCParticle = static_cast<AliAODMCParticle*>(AODMCTrackArray->At(index));
       if(!aodMCParticle) return 0; // no particle
@@ -4618,7 +4673,7 @@ Int_t AliConvEventCuts::IsParticleFromBGEvent(Int_t index, AliMCEvent *mcEvent,
         if( aodMCParticle->GetMother() < 0) return 0;// material particle, return 0
         return IsParticleFromBGEvent(aodMCParticle->GetMother(),mcEvent,InputEvent, debug);
       }
-      index = TMath::Abs(static_cast<AliAODMCParticle*>(AODMCTrackArray->At(index))->GetLabel());
+      index = TMath::Abs(aodMCParticle->GetLabel());
       for(Int_t i = 0;i<fnHeaders;i++){
         if(index >= fNotRejectedStart[i] && index <= fNotRejectedEnd[i]){
           accepted = 1;
@@ -17,6 +17,7 @@
 #include "AliAnalysisManager.h"
 #include "TRandom3.h"
 #include "AliVCaloTrigger.h"
+#include "TArrayI.h"
 
 class AliESDEvent;
 class AliAODEvent;
@@ -26,6 +27,7 @@ class TF1;
 class AliAnalysisCuts;
 class iostream;
 class TList;
+class TClonesArray;
 class AliAnalysisManager;
 class AliAODMCParticle;
 class AliEMCALTriggerPatchInfo;
@@ -664,10 +666,23 @@ class AliConvEventCuts : public AliAnalysisCuts {
       TH1D*                       hReweightMultData;                      ///< histogram input for reweighting Eta
       TH1D*                       hReweightMultMC;                        ///< histogram input for reweighting Pi0
       Int_t                       fDebugLevel;                            ///< debug level for interactive debugging
+      // Per-event lookup table of IsParticleFromBGEvent
+      TArrayI                     fBGEventLabelCache;                     //!<! IsParticleFromBGEvent result of each MC label in the current event, -1 if not known yet
+      AliMCEvent*                 fBGEventCacheMCEvent;                   //!<! MC event the lookup table refers to
+      AliVEvent*                  fBGEventCacheInputEvent;                //!<! input event the lookup table refers to
+      TClonesArray*               fBGEventCacheAODMCArray;                //!<! AOD MC particles of the input event
+      Long64_t                    fBGEventCacheEntry;                     //!<! entry of the event in the analysis manager
+      Bool_t                      fBGEventCacheValid;                     //!<! kFALSE if the accepted headers changed since the table was filled
   private:
+      Int_t   FindParticleFromBGEvent(Int_t index,
+                                      AliMCEvent *mcEvent,
+                                      AliVEvent *event,
+                                      Int_t debug
+                                   );
+      void    CheckBGEventCache(AliMCEvent *mcEvent, AliVEvent *event);
 
       /// \cond CLASSIMP
-      ClassDef(AliConvEventCuts,56)
+      ClassDef(AliConvEventCuts,57)
       /// \endcond
 };
 
@@ -282,8 +282,6 @@ AliAODVertex* AliAODRecoDecayHF::RemoveDaughtersFromPrimaryVtx(AliAODEvent *aod)
 
   AliVertexerTracks *vertexer = new AliVertexerTracks(aod->GetMagneticField());
 
-  Int_t ndg = GetNDaughters();
-
   vertexer->SetITSMode();
   vertexer->SetMinClusters(3);
   vertexer->SetConstraintOff();
@@ -298,15 +296,8 @@ AliAODVertex* AliAODRecoDecayHF::RemoveDaughtersFromPrimaryVtx(AliAODEvent *aod)
     delete diamond; diamond=NULL;
   }
 
-  Int_t skipped[10]; for(Int_t i=0;i<10;i++) skipped[i]=-1;
-  Int_t nTrksToSkip=0,id;
-  AliAODTrack *t = 0;
-  for(Int_t i=0; i<ndg; i++) {
-    t = (AliAODTrack*)GetDaughter(i);
-    id = (Int_t)t->GetID();
-    if(id<0) continue;
-    skipped[nTrksToSkip++] = id;
-  }
+  Int_t skipped[10];
+  Int_t nTrksToSkip=GetDaughterIDsToSkip(skipped,10);
 
   vertexer->SetSkipTracks(nTrksToSkip,skipped);
   AliESDVertex *vtxESDNew = vertexer->FindPrimaryVertex(aod);
@@ -333,6 +324,25 @@ AliAODVertex* AliAODRecoDecayHF::RemoveDaughtersFromPrimaryVtx(AliAODEvent *aod)
   return vtxAODNew;
 }
 //-----------------------------------------------------------------------------------
+Int_t AliAODRecoDecayHF::GetDaughterIDsToSkip(Int_t *skipped,Int_t maxSkip) const {
+  //
+  // Fill skipped with the IDs of the daughter tracks that
+  // RemoveDaughtersFromPrimaryVtx() removes from the vertex fit
+  // (daughters with negative ID are kept) and return their number.
+  // Unused entries of the array are set to -1.
+  //
+  for(Int_t i=0;i<maxSkip;i++) skipped[i]=-1;
+  Int_t nTrksToSkip=0,id;
+  AliAODTrack *t = 0;
+  for(Int_t i=0; i<GetNDaughters() && nTrksToSkip<maxSkip; i++) {
+    t = (AliAODTrack*)GetDaughter(i);
+    id = (Int_t)t->GetID();
+    if(id<0) continue;
+    skipped[nTrksToSkip++] = id;
+  }
+  return nTrksToSkip;
+}
+//-----------------------------------------------------------------------------------
 void AliAODRecoDecayHF::RecalculateImpPars(AliAODVertex *vtxAODNew,AliAODEvent* aod) {
   //
   // now recalculate the daughters impact parameters
@@ -51,6 +51,7 @@ class AliAODRecoDecayHF : public AliAODRecoDecay {
   void UnsetOwnSecondaryVtx() {if(fOwnSecondaryVtx) {delete fOwnSecondaryVtx; fOwnSecondaryVtx=0;} return;}
   AliAODVertex* GetPrimaryVtx() const { return (GetOwnPrimaryVtx() ? GetOwnPrimaryVtx() : GetPrimaryVtxRef()); }
   AliAODVertex* RemoveDaughtersFromPrimaryVtx(AliAODEvent *aod);  
+  Int_t         GetDaughterIDsToSkip(Int_t *skipped,Int_t maxSkip=10) const;
   void          RecalculateImpPars(AliAODVertex *vtxAODNew,AliAODEvent *aod);
 
   void     SetIsFilled(Int_t filled){fIsFilled=filled;}
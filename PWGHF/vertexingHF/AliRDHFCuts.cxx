@@ -22,6 +22,7 @@
 // Author: A.Dainese, andrea.dainese@pd.infn.it
 /////////////////////////////////////////////////////////////
 #include <Riostream.h>
+#include <algorithm>
 
 #include "AliVEvent.h"
 #include "AliESDEvent.h"
@@ -130,7 +131,17 @@ fCutGeoNcrNclFractionNcr(0.85),
 fCutGeoNcrNclFractionNcl(0.7),
 fUseV0ANDSelectionOffline(kFALSE),
 fUseTPCtrackCutsOnThisDaughter(kTRUE),
-fApplyZcutOnSPDvtx(kFALSE)
+fApplyZcutOnSPDvtx(kFALSE),
+fPrimVtxWoDaughters(),
+fPrimVtxSkipKey(),
+fPrimVtxCacheEvent(0),
+fPrimVtxCacheVtxPars(),
+fPrimVtxCacheEntry(-1),
+fPrimVtxCacheTree(-1),
+fDgSelResults(),
+fDgSelConfigs(),
+fDgSelTrackCuts(),
+fDgSelEntry(-1)
 {
   //
   // Default Constructor
@@ -208,7 +219,17 @@ AliRDHFCuts::AliRDHFCuts(const AliRDHFCuts &source) :
   fCutGeoNcrNclFractionNcl(source.fCutGeoNcrNclFractionNcl),
   fUseV0ANDSelectionOffline(source.fUseV0ANDSelectionOffline),
   fUseTPCtrackCutsOnThisDaughter(source.fUseTPCtrackCutsOnThisDaughter),
-  fApplyZcutOnSPDvtx(source.fApplyZcutOnSPDvtx)
+  fApplyZcutOnSPDvtx(source.fApplyZcutOnSPDvtx),
+  fPrimVtxWoDaughters(),
+  fPrimVtxSkipKey(),
+  fPrimVtxCacheEvent(0),
+  fPrimVtxCacheVtxPars(),
+  fPrimVtxCacheEntry(-1),
+  fPrimVtxCacheTree(-1),
+  fDgSelResults(),
+  fDgSelConfigs(),
+  fDgSelTrackCuts(),
+  fDgSelEntry(-1)
 {
   //
   // Copy constructor
@@ -341,6 +362,7 @@ AliRDHFCuts::~AliRDHFCuts() {
     delete f1CutMinNCrossedRowsTPCPtDep;
     f1CutMinNCrossedRowsTPCPtDep = 0;
   }
+  ClearPrimaryVtxCache();
 
 }
 //---------------------------------------------------------------------------
@@ -851,12 +873,86 @@ void AliRDHFCuts::SetMinCrossedRowsTPCPtDep(const char *rows){
 //---------------------------------------------------------------------------
 Bool_t AliRDHFCuts::IsDaughterSelected(AliAODTrack *track,const AliESDVertex *primary,AliESDtrackCuts *cuts, const AliAODEvent* aod) const{
   //
-  // Convert to ESDtrack, relate to vertex and check cuts
+  // Check the daughter track cuts. The outcome is kept for the current
+  // event and reused when the same track is checked again with the same
+  // cuts and primary vertex (i.e. for the other candidates it belongs to)
   //
   if(!cuts) return kTRUE;
 
   if(cuts->GetFlagCutTOFdistance()) cuts->SetFlagCutTOFdistance(kFALSE);
 
+  Int_t iconf=GetDaughterSelConfig(primary,cuts,aod);
+  if(iconf<0) return CheckDaughterSelection(track,primary,cuts,aod);
+
+  std::pair<const AliAODTrack*,Int_t> key(track,iconf);
+  std::map<std::pair<const AliAODTrack*,Int_t>,Bool_t>::const_iterator it=fDgSelResults.find(key);
+  if(it!=fDgSelResults.end()) return it->second;
+
+  Bool_t isSel=CheckDaughterSelection(track,primary,cuts,aod);
+  fDgSelResults[key]=isSel;
+  return isSel;
+}
+//---------------------------------------------------------------------------
+void AliRDHFCuts::PreSelectDaughterTracks(AliAODEvent *aod) const{
+  //
+  // Apply the daughter track cuts to all the tracks of the event with
+  // respect to the event primary vertex, so that AreDaughtersSelected
+  // only looks up the outcome for the candidates using that vertex
+  //
+  if(!fTrackCuts || !aod) return;
+  AliAODVertex *vAOD = aod->GetPrimaryVertex();
+  if(!vAOD) return;
+  Double_t pos[3],cov[6];
+  vAOD->GetXYZ(pos);
+  vAOD->GetCovarianceMatrix(cov);
+  const AliESDVertex vESD(pos,cov,100.,100);
+
+  for(Int_t itr=0; itr<aod->GetNumberOfTracks(); itr++) {
+    AliAODTrack *track = dynamic_cast<AliAODTrack*>(aod->GetTrack(itr));
+    if(!track || track->Charge()==0) continue;
+    IsDaughterSelected(track,&vESD,fTrackCuts,aod);
+  }
+}
+//---------------------------------------------------------------------------
+Int_t AliRDHFCuts::GetDaughterSelConfig(const AliESDVertex *primary,const AliESDtrackCuts *cuts, const AliAODEvent* aod) const{
+  //
+  // Index of the (primary vertex, track cuts, options) combination
+  // used for the daughter selection in the current event, -1 if the
+  // outcome cannot be cached
+  //
+  const Int_t kNConfPars=10;
+  const Int_t kMaxConfigs=64;
+
+  AliAnalysisManager *man=AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = man ? man->GetCurrentEntry() : -1;
+  if(entry<0 || !primary) return -1;
+  if(entry!=fDgSelEntry || (Int_t)fDgSelTrackCuts.size()>=kMaxConfigs) {
+    // new event, or too many vertices (e.g. recomputed per candidate): start over
+    fDgSelResults.clear();
+    fDgSelConfigs.clear();
+    fDgSelTrackCuts.clear();
+    fDgSelEntry=entry;
+  }
+
+  Double_t conf[kNConfPars];
+  primary->GetXYZ(conf);
+  primary->GetCovarianceMatrix(&conf[3]);
+  conf[9]=(aod ? 1 : 0) + (fUseTPCtrackCutsOnThisDaughter ? 2 : 0) + (fApplySPDMisalignedPP2012 ? 4 : 0);
+
+  // look at the most recent configurations first
+  for(Int_t iconf=(Int_t)fDgSelTrackCuts.size()-1; iconf>=0; iconf--) {
+    if(fDgSelTrackCuts[iconf]!=cuts) continue;
+    if(std::equal(conf,conf+kNConfPars,fDgSelConfigs.begin()+iconf*kNConfPars)) return iconf;
+  }
+  fDgSelConfigs.insert(fDgSelConfigs.end(),conf,conf+kNConfPars);
+  fDgSelTrackCuts.push_back(cuts);
+  return (Int_t)fDgSelTrackCuts.size()-1;
+}
+//---------------------------------------------------------------------------
+Bool_t AliRDHFCuts::CheckDaughterSelection(AliAODTrack *track,const AliESDVertex *primary,AliESDtrackCuts *cuts, const AliAODEvent* aod) const{
+  //
+  // Convert to ESDtrack, relate to vertex and check cuts
+  //
 
   // convert to ESD track here
   AliESDtrack esdTrack(track);
@@ -1640,20 +1736,90 @@ Bool_t AliRDHFCuts::RecalcOwnPrimaryVtx(AliAODRecoDecayHF *d,
     return 0;
   }   
 
-  AliAODVertex *recvtx=d->RemoveDaughtersFromPrimaryVtx(aod);
+  AliAODVertex *recvtx=GetPrimaryVtxWithoutDaughters(d,aod);
   if(!recvtx){
     AliDebug(2,"Removal of daughter tracks failed");
     return kFALSE;
   }
 
 
-  //set recalculed primary vertex
+  //set recalculed primary vertex (owned by the cache)
   d->SetOwnPrimaryVtx(recvtx);
-  delete recvtx;
 
   return kTRUE;
 }
 //--------------------------------------------------------------------------
+AliAODVertex* AliRDHFCuts::GetPrimaryVtxWithoutDaughters(AliAODRecoDecayHF *d,
+							 AliAODEvent *aod) const
+{
+  //
+  // Primary vertex without the daughters of d, with the impact parameters
+  // of d recalculated with respect to it.
+  // The refit only depends on the event and on the set of removed tracks,
+  // so the vertices are kept for the current event and reused for the
+  // candidates (and the repeated IsSelected calls) that remove the same
+  // tracks. The returned vertex is owned by the cuts object.
+  //
+
+  AliAnalysisManager *man=AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = man ? man->GetCurrentEntry() : -1;
+  AliAODVertex *vtx = aod->GetPrimaryVertex();
+  if(entry<0 || !vtx) {
+    // no way to tell when the event changes: refit every time
+    ClearPrimaryVtxCache();
+    AliAODVertex *recvtx=d->RemoveDaughtersFromPrimaryVtx(aod);
+    if(recvtx) fPrimVtxWoDaughters[std::vector<Int_t>()]=recvtx;
+    return recvtx;
+  }
+  // The manager entry is the one in the current tree of the chain, and the
+  // event and its vertex are the same objects from one event to the next:
+  // the event is identified by the tree number, the entry and the primary
+  // vertex position and covariance
+  TTree *tree = man->GetTree();
+  Int_t treeNumber = tree ? tree->GetTreeNumber() : -1;
+  Double_t vtxPars[9];
+  vtx->GetXYZ(vtxPars);
+  vtx->GetCovarianceMatrix(&vtxPars[3]);
+  if(aod!=fPrimVtxCacheEvent || entry!=fPrimVtxCacheEntry || treeNumber!=fPrimVtxCacheTree ||
+     fPrimVtxCacheVtxPars.size()!=9 || !std::equal(vtxPars,vtxPars+9,fPrimVtxCacheVtxPars.begin())) {
+    ClearPrimaryVtxCache();
+    fPrimVtxCacheEvent=aod;
+    fPrimVtxCacheVtxPars.assign(vtxPars,vtxPars+9);
+    fPrimVtxCacheEntry=entry;
+    fPrimVtxCacheTree=treeNumber;
+  }
+
+  Int_t skipped[10];
+  Int_t nTrksToSkip=d->GetDaughterIDsToSkip(skipped,10);
+  fPrimVtxSkipKey.assign(skipped,skipped+nTrksToSkip);
+  std::sort(fPrimVtxSkipKey.begin(),fPrimVtxSkipKey.end());
+
+  std::map<std::vector<Int_t>,AliAODVertex*>::const_iterator it=fPrimVtxWoDaughters.find(fPrimVtxSkipKey);
+  if(it!=fPrimVtxWoDaughters.end()) {
+    if(it->second) d->RecalculateImpPars(it->second,aod);
+    return it->second;
+  }
+
+  // failed removals are stored as well, to avoid repeating them
+  AliAODVertex *recvtx=d->RemoveDaughtersFromPrimaryVtx(aod);
+  fPrimVtxWoDaughters[fPrimVtxSkipKey]=recvtx;
+  return recvtx;
+}
+//--------------------------------------------------------------------------
+void AliRDHFCuts::ClearPrimaryVtxCache() const
+{
+  //
+  // Delete the primary vertices without daughters of the current event
+  //
+  std::map<std::vector<Int_t>,AliAODVertex*>::iterator it;
+  for(it=fPrimVtxWoDaughters.begin(); it!=fPrimVtxWoDaughters.end(); ++it) delete it->second;
+  fPrimVtxWoDaughters.clear();
+  fPrimVtxCacheEvent=0;
+  fPrimVtxCacheVtxPars.clear();
+  fPrimVtxCacheEntry=-1;
+  fPrimVtxCacheTree=-1;
+}
+//--------------------------------------------------------------------------
 Bool_t AliRDHFCuts::SetMCPrimaryVtx(AliAODRecoDecayHF *d,AliAODEvent *aod) const
 {
   //
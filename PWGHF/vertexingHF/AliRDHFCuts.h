@@ -11,6 +11,8 @@
 /// \author Author: A.Dainese, andrea.dainese@pd.infn.it
 //***********************************************************
 
+#include <map>
+#include <vector>
 #include <TString.h>
 
 #include "AliAnalysisCuts.h"
@@ -296,6 +298,7 @@ class AliRDHFCuts : public AliAnalysisCuts
   Bool_t IsEventSelected(AliVEvent *event);
   Bool_t AreDaughtersSelected(AliAODRecoDecayHF *rd, const AliAODEvent* aod=0x0) const;
   Bool_t IsDaughterSelected(AliAODTrack *track,const AliESDVertex *primary,AliESDtrackCuts *cuts, const AliAODEvent* aod=0x0) const;
+  void   PreSelectDaughterTracks(AliAODEvent *aod) const;
   virtual Int_t IsSelectedPID(AliAODRecoDecayHF * /*rd*/) {return 1;}
   static Int_t CheckMatchingAODdeltaAODevents();
 
@@ -405,6 +408,10 @@ class AliRDHFCuts : public AliAnalysisCuts
 
   Bool_t IsSignalMC(AliAODRecoDecay *d,AliAODEvent *aod,Int_t pdg) const;
   Bool_t RecomputePrimaryVertex(AliAODEvent* event) const;
+  AliAODVertex* GetPrimaryVtxWithoutDaughters(AliAODRecoDecayHF *d,AliAODEvent *aod) const;
+  void ClearPrimaryVtxCache() const;
+  Bool_t CheckDaughterSelection(AliAODTrack *track,const AliESDVertex *primary,AliESDtrackCuts *cuts, const AliAODEvent* aod) const;
+  Int_t GetDaughterSelConfig(const AliESDVertex *primary,const AliESDtrackCuts *cuts, const AliAODEvent* aod) const;
 
   /// cuts on the event
   Int_t fMinVtxType; /// 0: not cut; 1: SPDZ; 2: SPD3D; 3: Tracks
@@ -482,9 +489,19 @@ class AliRDHFCuts : public AliAnalysisCuts
   Bool_t fUseV0ANDSelectionOffline; ///flag to apply V0AND selection offline
   Bool_t fUseTPCtrackCutsOnThisDaughter; ///flag to apply TPC track quality cuts on specific D-meson daughter (used for different strategies for soft pion and D0daughters from Dstar decay)
   Bool_t fApplyZcutOnSPDvtx; //flag to apply the cut on |Zvtx| > X cm using the z coordinate of the SPD vertex
+  mutable std::map<std::vector<Int_t>,AliAODVertex*> fPrimVtxWoDaughters; //!<! primary vertices without the candidate daughters in the current event, keyed on the sorted IDs of the removed tracks
+  mutable std::vector<Int_t> fPrimVtxSkipKey; //!<! buffer for the lookup key in fPrimVtxWoDaughters
+  mutable AliAODEvent *fPrimVtxCacheEvent;   //!<! event to which fPrimVtxWoDaughters refers
+  mutable std::vector<Double_t> fPrimVtxCacheVtxPars; //!<! primary vertex position and covariance of fPrimVtxCacheEvent
+  mutable Long64_t fPrimVtxCacheEntry;       //!<! analysis manager entry of fPrimVtxCacheEvent
+  mutable Int_t fPrimVtxCacheTree;           //!<! number of the chain tree of fPrimVtxCacheEntry
+  mutable std::map<std::pair<const AliAODTrack*,Int_t>,Bool_t> fDgSelResults; //!<! outcome of IsDaughterSelected in the current event, keyed on track and selection configuration
+  mutable std::vector<Double_t> fDgSelConfigs; //!<! primary vertex position, covariance and options of each selection configuration
+  mutable std::vector<const AliESDtrackCuts*> fDgSelTrackCuts; //!<! track cuts of each selection configuration
+  mutable Long64_t fDgSelEntry;              //!<! analysis manager entry of fDgSelResults
 
   /// \cond CLASSIMP    
-  ClassDef(AliRDHFCuts,43);  /// base class for cuts on AOD reconstructed heavy-flavour decays
+  ClassDef(AliRDHFCuts,45);  /// base class for cuts on AOD reconstructed heavy-flavour decays
   /// \endcond
 };
 
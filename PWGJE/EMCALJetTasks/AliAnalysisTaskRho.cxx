@@ -84,8 +84,7 @@ Bool_t AliAnalysisTaskRho::Run()
     }
   }
 
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
+  fRhoEstimator.Reset();
 
   // push all jets within selected acceptance into stack
   for (Int_t iJets = 0; iJets < Njets; ++iJets) {
@@ -103,14 +102,13 @@ Bool_t AliAnalysisTaskRho::Run()
     if (!AcceptJet(jet))
       continue;
 
-    rhovec[NjetAcc] = jet->Pt() / jet->Area();
-    ++NjetAcc;
+    fRhoEstimator.Add(jet->Pt() / jet->Area());
   }
 
 
-  if (NjetAcc > 0) {
+  if (fRhoEstimator.GetN() > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = fRhoEstimator.GetMedian();
     fOutRho->SetVal(rho);
 
     if (fOutRhoScaled) {
@@ -45,9 +45,7 @@ Bool_t AliAnalysisTaskRhoAverage::Run()
 {
   // Run the analysis.
 
-  const Int_t NMAX = 9999;
-  static Double_t rhovec[NMAX];
-  Int_t NpartAcc = 0;
+  fRhoEstimator.Reset();
 
   Int_t   maxPartIds[] = {0, 0};
   Float_t maxPartPts[] = {0, 0};
@@ -108,14 +106,13 @@ Bool_t AliAnalysisTaskRhoAverage::Run()
   if (tracks && (fRhoType == 0 || fRhoType == 1)) {
     AliVParticle *track = 0;
     tracks->ResetCurrentID();
-    while ((track = tracks->GetNextAcceptParticle()) && NpartAcc < NMAX) {
+    while ((track = tracks->GetNextAcceptParticle())) {
 
       // exlcuding lead particles
       if (tracks->GetCurrentID() == maxPartIds[0]-1 || tracks->GetCurrentID() == maxPartIds[1]-1)
         continue;
 
-      rhovec[NpartAcc] = track->Pt();
-      ++NpartAcc;
+      fRhoEstimator.Add(track->Pt());
     }
   }
 
@@ -123,7 +120,7 @@ Bool_t AliAnalysisTaskRhoAverage::Run()
 
     AliVCluster *cluster = 0;
     clusters->ResetCurrentID();
-    while ((cluster = clusters->GetNextAcceptCluster()) && NpartAcc < NMAX) {
+    while ((cluster = clusters->GetNextAcceptCluster())) {
       // exlcuding lead particles
       if (clusters->GetCurrentID() == -maxPartIds[0]-1 || clusters->GetCurrentID() == -maxPartIds[1]-1)
         continue;
@@ -131,22 +128,18 @@ Bool_t AliAnalysisTaskRhoAverage::Run()
       TLorentzVector nPart;
       clusters->GetMomentum(nPart, clusters->GetCurrentID());
 
-      rhovec[NpartAcc] = nPart.Pt();
-      ++NpartAcc;
+      fRhoEstimator.Add(nPart.Pt());
     }
   }
 
-  if (NpartAcc == NMAX) {
-    AliError(Form("%s: NpartAcc >= %d", GetName(), NMAX));
-  }
-
   Double_t rho = 0;
 
+  Int_t NpartAcc = fRhoEstimator.GetN();
   if (NpartAcc > 0) {
     if (fUseMedian)
-      rho = TMath::Median(NpartAcc, rhovec);
+      rho = fRhoEstimator.GetMedian();
     else
-      rho = TMath::Mean(NpartAcc, rhovec);
+      rho = fRhoEstimator.GetMean();
 
     rho *= NpartAcc / fTotalArea;
   }
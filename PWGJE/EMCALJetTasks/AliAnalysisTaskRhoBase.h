@@ -11,6 +11,7 @@ class TH3F;
 class AliRhoParameter;
 
 #include "AliAnalysisTaskEmcalJet.h"
+#include "AliRhoEstimator.h"
 
 class AliAnalysisTaskRhoBase : public AliAnalysisTaskEmcalJet {
  public:
@@ -80,9 +81,11 @@ class AliAnalysisTaskRhoBase : public AliAnalysisTaskEmcalJet {
   TH2F                  *fHistRhovsNcluster;             //!rho vs. no. of clusters
   TH2F                  *fHistRhoScaledvsNcluster;       //!rhoscaled vs. no. of clusters
 
+  AliRhoEstimator        fRhoEstimator;                  //!values of the accepted jets, reused in each event
+
   AliAnalysisTaskRhoBase(const AliAnalysisTaskRhoBase&);             // not implemented
   AliAnalysisTaskRhoBase& operator=(const AliAnalysisTaskRhoBase&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoBase, 11); // Rho base task
+  ClassDef(AliAnalysisTaskRhoBase, 12); // Rho base task
 };
 #endif
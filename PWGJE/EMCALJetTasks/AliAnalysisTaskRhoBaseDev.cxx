@@ -68,7 +68,8 @@ AliAnalysisTaskRhoBaseDev::AliAnalysisTaskRhoBaseDev() :
   fHistNclusterVsCent(0),
   fHistRhoScaledVsCent(0),
   fHistRhoScaledVsNtrack(0),
-  fHistRhoScaledVsNcluster(0)
+  fHistRhoScaledVsNcluster(0),
+  fRhoEstimator()
 {
 }
 
@@ -107,7 +108,8 @@ AliAnalysisTaskRhoBaseDev::AliAnalysisTaskRhoBaseDev(const char *name, Bool_t hi
   fHistNclusterVsCent(0),
   fHistRhoScaledVsCent(0),
   fHistRhoScaledVsNtrack(0),
-  fHistRhoScaledVsNcluster(0)
+  fHistRhoScaledVsNcluster(0),
+  fRhoEstimator()
 {
   SetMakeGeneralHistograms(histo);
 }
@@ -25,6 +25,7 @@ class AliRhoParameter;
 #include <string>
 
 #include "AliAnalysisTaskJetUE.h"
+#include "AliRhoEstimator.h"
 
 
 /** \class AliAnalysisTaskRhoBaseDev
@@ -115,11 +116,13 @@ class AliAnalysisTaskRhoBaseDev : public AliAnalysisTaskJetUE {
   TH2                                *fHistRhoScaledVsNtrack;         //!<!rhoscaled vs. no. of tracks
   TH2                                *fHistRhoScaledVsNcluster;       //!<!rhoscaled vs. no. of clusters
 
+  AliRhoEstimator                     fRhoEstimator;                  //!<!values of the accepted jets, reused in each event
+
   AliAnalysisTaskRhoBaseDev(const AliAnalysisTaskRhoBaseDev&);             // not implemented
   AliAnalysisTaskRhoBaseDev& operator=(const AliAnalysisTaskRhoBaseDev&);  // not implemented
   
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskRhoBaseDev, 2);
+  ClassDef(AliAnalysisTaskRhoBaseDev, 3);
   /// \endcond
 };
 #endif
@@ -104,8 +104,7 @@ void AliAnalysisTaskRhoDev::CalculateRho()
 
   auto maxJets = GetLeadingJets();
 
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
+  fRhoEstimator.Reset();
   Double_t TotaljetArea = 0; // Total area of background jets (including ghost jets)
   Double_t TotaljetAreaPhys = 0; // Total area of physical background jets (excluding ghost jets)
   // Ghost jet is a jet made only of ghost particles
@@ -141,8 +140,7 @@ void AliAnalysisTaskRhoDev::CalculateRho()
 
     if (overlapsWithSignal) continue;
 
-    rhovec[NjetAcc] = jet->Pt() / jet->Area();
-    ++NjetAcc;
+    fRhoEstimator.Add(jet->Pt() / jet->Area());
   }
 
   // Occupancy correction for sparse event described in https://arxiv.org/abs/1207.2392
@@ -153,9 +151,9 @@ void AliAnalysisTaskRhoDev::CalculateRho()
     fOccupancyFactor = 0;
   }
 
-  if (NjetAcc > 0) {
+  if (fRhoEstimator.GetN() > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = fRhoEstimator.GetMedian();
 
     if (fRhoSparse) rho = rho * fOccupancyFactor;
 
@@ -10,6 +10,7 @@ class TH2F;
 class AliRhoParameter;
 
 #include "AliAnalysisTaskEmcalJet.h"
+#include "AliRhoEstimator.h"
 
 class AliAnalysisTaskRhoMassBase : public AliAnalysisTaskEmcalJet {
  public:
@@ -70,9 +71,11 @@ class AliAnalysisTaskRhoMassBase : public AliAnalysisTaskEmcalJet {
 
   TH2F                  *fHistGammaVsNtrack;             //!Gamma(<E>/<M>) vs Ntrack
 
+  AliRhoEstimator        fRhoEstimator;                  //!values of the accepted jets, reused in each event
+
   AliAnalysisTaskRhoMassBase(const AliAnalysisTaskRhoMassBase&);             // not implemented
   AliAnalysisTaskRhoMassBase& operator=(const AliAnalysisTaskRhoMassBase&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoMassBase, 2); // Rho mass base task
+  ClassDef(AliAnalysisTaskRhoMassBase, 3); // Rho mass base task
 };
 #endif
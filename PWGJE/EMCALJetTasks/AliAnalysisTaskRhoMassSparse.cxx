@@ -137,10 +137,7 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     }
   }
 
-  static Double_t rhomvec[999];
-  static Double_t Evec[999];
-  static Double_t Mvec[999];
-  Int_t NjetAcc = 0;
+  fRhoEstimator.Reset();
   Double_t TotaljetArea=0;
   Double_t TotaljetAreaPhys=0;
 
@@ -194,11 +191,9 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     if(jet->Area()>0.) {// && (jet->M()*jet->M() + jet->Pt()*jet->Pt())>0.) {
        //rhomvec[NjetAcc] = (TMath::Sqrt(sumM*sumM + sumPt*sumPt) - sumPt ) / jet->Area();
       // rhomvec[NjetAcc] = (TMath::Sqrt(jet->M()*jet->M() + jet->Pt()*jet->Pt()) - jet->Pt() ) / jet->Area();
-      rhomvec[NjetAcc] = GetMd(jet) / jet->Area();
-      fHistMdAreavsCent->Fill(fCent,rhomvec[NjetAcc]);
-      Evec[NjetAcc] = jet->E();
-      Mvec[NjetAcc] = jet->M();
-      ++NjetAcc;
+      Double_t rhom = GetMd(jet) / jet->Area();
+      fHistMdAreavsCent->Fill(fCent,rhom);
+      fRhoEstimator.Add(rhom, jet->E(), jet->M());
     }
   }
 
@@ -209,9 +204,9 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     fHistOccCorrvsCent->Fill(fCent, OccCorr);
 
 
-  if (NjetAcc > 0) {
+  if (fRhoEstimator.GetN() > 0) {
     //find median value
-    Double_t rhom = TMath::Median(NjetAcc, rhomvec);
+    Double_t rhom = fRhoEstimator.GetMedian();
     if(fRhoCMS){
       rhom = rhom * OccCorr;
     }
@@ -219,8 +214,8 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     fOutRhoMass->SetVal(rhom);
 
     Int_t Ntracks = fTracks->GetEntries();
-    Double_t meanM = TMath::Mean(NjetAcc, Mvec);
-    Double_t meanE = TMath::Mean(NjetAcc, Evec);
+    Double_t meanM = fRhoEstimator.GetMeanM();
+    Double_t meanE = fRhoEstimator.GetMeanE();
     Double_t gamma = 0.;
     if(meanM>0.) gamma = meanE/meanM;
     fHistGammaVsNtrack->Fill(Ntracks,gamma);
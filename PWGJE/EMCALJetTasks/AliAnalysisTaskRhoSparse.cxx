@@ -128,8 +128,7 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
     }
   }
 
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
+  fRhoEstimator.Reset();
   Double_t TotaljetAreaPhys=0;
   Double_t TotalTPCArea=2*TMath::Pi()*0.9;
 
@@ -175,8 +174,7 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
     if(jet->GetNumberOfTracks()>0)
     {
     	  TotaljetAreaPhys+=jet->Area();
-    	  rhovec[NjetAcc] = jet->Pt() / jet->Area();
-    	  ++NjetAcc;
+    	  fRhoEstimator.Add(jet->Pt() / jet->Area());
     }
   }
 
@@ -185,9 +183,9 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
   if (fCreateHisto)
     fHistOccCorrvsCent->Fill(fCent, OccCorr);
 
-  if (NjetAcc > 0) {
+  if (fRhoEstimator.GetN() > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = fRhoEstimator.GetMedian();
 
     if(fRhoCMS){
       rho = rho * OccCorr;
@@ -19,9 +19,15 @@
 
 #include "AliJetResponseMaker.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <TClonesArray.h>
 #include <TH2F.h>
 #include <THnSparse.h>
+#include <TVector2.h>
 
 #include "AliTLorentzVector.h"
 #include "AliAnalysisManager.h"
@@ -45,6 +51,7 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fMatchingPar1(0),
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
+  fMatchingSearchRadius(0),
   fMinJetMCPt(1),
   fEmbeddingQA(),
   fHistoType(0),
@@ -134,6 +141,7 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fMatchingPar1(0),
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
+  fMatchingSearchRadius(0),
   fMinJetMCPt(1),
   fEmbeddingQA(),
   fHistoType(0),
@@ -1413,10 +1421,125 @@ Bool_t AliJetResponseMaker::DoJetMatching()
   return kTRUE;
 }
 
+/**
+ * Shared-energy content of a jet 1, indexed by the index of the matching constituent
+ * of the jets 2: each entry holds the pt of all the jet 1 constituents associated
+ * with it, and the weight with which the jet 2 constituent pt has to be counted.
+ * With this map the shared energy fraction of a jet pair is a hash lookup per jet 2
+ * constituent, instead of a loop over all the jet 1 constituents.
+ */
+class AliJetResponseMaker::SharedEnergyMap {
+ public:
+  SharedEnergyMap() : fShared(), fD1(0), fTotalPt1(0) {}
+
+  void Reset(Double_t pt1) { fShared.clear(); fD1 = pt1; fTotalPt1 = pt1; }
+  void Add(Int_t index, Double_t pt1, Double_t weight2) {
+    auto it = fShared.find(index);
+    if (it == fShared.end()) fShared.insert(std::make_pair(index, std::make_pair(pt1, weight2)));
+    else it->second.first += pt1; // the weight is defined by the first constituent found
+  }
+  /// Removes the pt of jet 1 constituents which are not MC particles
+  void Remove(Double_t pt1) { fD1 -= pt1; fTotalPt1 -= pt1; }
+
+  std::unordered_map<Int_t, std::pair<Double_t, Double_t> > fShared; ///< index -> (pt of jet 1 constituents, weight of jet 2 constituent)
+  Double_t fD1;       ///< jet 1 pt without constituents which are not MC particles
+  Double_t fTotalPt1; ///< jet 1 pt cleaned from the background
+};
+
+namespace {
+  /**
+   * Bins the jets in an eta-phi grid with cells of at least the search radius,
+   * so that only the jets in the 3x3 neighbouring cells have to be tested.
+   */
+  class JetEtaPhiGrid {
+  public:
+    JetEtaPhiGrid() : fEtaMin(0), fCellEta(1), fNEta(0), fNPhi(0), fCells() {}
+
+    void Build(const std::vector<AliEmcalJet*> &jets, Double_t radius) {
+      fNEta = 0;
+      fNPhi = 0;
+      if (jets.empty()) return;
+      Double_t etaMin = jets[0]->Eta(), etaMax = etaMin;
+      for (auto jet : jets) {
+        etaMin = TMath::Min(etaMin, jet->Eta());
+        etaMax = TMath::Max(etaMax, jet->Eta());
+      }
+      fEtaMin = etaMin;
+      fCellEta = radius;
+      fNEta = TMath::FloorNint((etaMax - etaMin) / radius) + 1;
+      fNPhi = TMath::Max(1, TMath::FloorNint(TMath::TwoPi() / radius));
+      fCells.assign(fNEta * fNPhi, std::vector<Int_t>());
+      for (UInt_t i = 0; i < jets.size(); i++) {
+        fCells[EtaBin(jets[i]->Eta()) * fNPhi + PhiBin(jets[i]->Phi())].push_back(i);
+      }
+    }
+
+    /// Fills the indexes of the jets which may be within the search radius, in increasing order
+    void GetCandidates(Double_t eta, Double_t phi, std::vector<Int_t> &candidates) const {
+      candidates.clear();
+      if (fNEta == 0) return;
+      Int_t ieta = TMath::FloorNint((eta - fEtaMin) / fCellEta);
+      Int_t iphi = PhiBin(phi);
+      // with less than 3 phi cells the neighbours would be counted twice
+      Int_t dphiMin = fNPhi < 3 ? 0 : -1, dphiMax = fNPhi < 3 ? fNPhi - 1 : 1;
+      for (Int_t jeta = ieta - 1; jeta <= ieta + 1; jeta++) {
+        if (jeta < 0 || jeta >= fNEta) continue;
+        for (Int_t dphi = dphiMin; dphi <= dphiMax; dphi++) {
+          Int_t jphi = fNPhi < 3 ? dphi : (iphi + dphi + fNPhi) % fNPhi;
+          const std::vector<Int_t> &cell = fCells[jeta * fNPhi + jphi];
+          candidates.insert(candidates.end(), cell.begin(), cell.end());
+        }
+      }
+      // keep the same order as a loop over the full collection (relevant for equal distances)
+      std::sort(candidates.begin(), candidates.end());
+    }
+
+  private:
+    Int_t EtaBin(Double_t eta) const { return TMath::Min(fNEta - 1, TMath::Max(0, TMath::FloorNint((eta - fEtaMin) / fCellEta))); }
+    Int_t PhiBin(Double_t phi) const {
+      phi = TVector2::Phi_0_2pi(phi);
+      return TMath::Min(fNPhi - 1, TMath::FloorNint(phi / TMath::TwoPi() * fNPhi));
+    }
+
+    Double_t fEtaMin;
+    Double_t fCellEta;
+    Int_t fNEta;
+    Int_t fNPhi;
+    std::vector<std::vector<Int_t> > fCells;
+  };
+}
+
+//________________________________________________________________________
+Double_t AliJetResponseMaker::GetMatchingSearchRadius() const
+{
+  // Radius in eta-phi within which the jet pairs are tested by the matching (0 = all pairs).
+  // By default all pairs are tested, so the closest and second closest jets are the same
+  // as for a full pair loop. A negative value of fMatchingSearchRadius selects the radius
+  // automatically: the largest matching parameter for the geometrical matching, and
+  // 1.25 (R1+R2) for the MC label and same collections matching (jets sharing a constituent
+  // are at most R1+R2 apart, plus some margin for the recombination of the jet axis).
+  // With a search radius the matched pairs are unchanged, but jets without any partner
+  // within the radius are left without closest (or second closest) jet.
+
+  if (fMatchingSearchRadius >= 0) return fMatchingSearchRadius;
+
+  if (fMatching == kGeometrical) return TMath::Max(fMatchingPar1, fMatchingPar2);
+
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+  if (jets1->GetJetRadius() <= 0 || jets2->GetJetRadius() <= 0) return 0;
+
+  return 1.25 * (jets1->GetJetRadius() + jets2->GetJetRadius());
+}
+
 //________________________________________________________________________
 void AliJetResponseMaker::DoJetLoop()
 {
   // Do the jet loop.
+  // If a search radius is set, the jets 2 are binned in an eta-phi grid, so that each jet 1
+  // is only compared with the jets 2 within the search radius. For the MC label and same
+  // collections matching, the constituents of each jet are reduced once, so that the
+  // shared energy of each pair is computed with hash lookups.
 
   AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
   AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
@@ -1426,8 +1549,29 @@ void AliJetResponseMaker::DoJetLoop()
   AliEmcalJet* jet1 = 0;
   AliEmcalJet* jet2 = 0;
 
+  std::vector<AliEmcalJet*> jetList2;
   jets2->ResetCurrentID();
-  while ((jet2 = jets2->GetNextJet())) jet2->ResetMatching();
+  while ((jet2 = jets2->GetNextJet())) {
+    jet2->ResetMatching();
+    jetList2.push_back(jet2);
+  }
+
+  const Double_t searchRadius = GetMatchingSearchRadius();
+  JetEtaPhiGrid grid;
+  if (searchRadius > 0) grid.Build(jetList2, searchRadius);
+
+  // Constituents of the jets 2
+  std::vector<ConstituentList> tracksOfJets2, clustersOfJets2;
+  if (fMatching == kMCLabel || fMatching == kSameCollections) {
+    tracksOfJets2.resize(jetList2.size());
+    clustersOfJets2.resize(jetList2.size());
+    for (UInt_t ijet2 = 0; ijet2 < jetList2.size(); ijet2++) {
+      FillMatchingConstituents(jetList2[ijet2], fMatching, tracksOfJets2[ijet2], clustersOfJets2[ijet2]);
+    }
+  }
+
+  SharedEnergyMap sharedTracks1, sharedClusters1;
+  std::vector<Int_t> candidates;
 
   jets1->ResetCurrentID();
   while ((jet1 = jets1->GetNextJet())) {
@@ -1435,222 +1579,238 @@ void AliJetResponseMaker::DoJetLoop()
 
     if (jet1->MCPt() < fMinJetMCPt) continue;
 
-    jets2->ResetCurrentID();
-    while ((jet2 = jets2->GetNextJet())) {
-      SetMatchingLevel(jet1, jet2, fMatching);
+    // Reduce the constituents of jet 1 once for all its pairs
+    if (fMatching == kMCLabel) {
+      FillMCLabelSharedEnergy(jet1, sharedTracks1);
+    }
+    else if (fMatching == kSameCollections) {
+      FillSameCollectionsSharedEnergy(jet1, sharedTracks1, sharedClusters1);
+    }
+
+    if (searchRadius > 0) {
+      grid.GetCandidates(jet1->Eta(), jet1->Phi(), candidates);
+    }
+    else {
+      candidates.resize(jetList2.size());
+      for (UInt_t ijet2 = 0; ijet2 < jetList2.size(); ijet2++) candidates[ijet2] = ijet2;
+    }
+
+    for (auto ijet2 : candidates) {
+      jet2 = jetList2[ijet2];
+
+      if (searchRadius > 0 && jet1->DeltaR(jet2) > searchRadius) continue;
+
+      Double_t d1 = -1;
+      Double_t d2 = -1;
+
+      if (fMatching == kMCLabel) {
+        GetMCLabelMatchingLevel(jet1, jet2, sharedTracks1, tracksOfJets2[ijet2], d1, d2);
+      }
+      else if (fMatching == kSameCollections) {
+        GetSameCollectionsMatchingLevel(jet1, jet2, sharedTracks1, sharedClusters1, tracksOfJets2[ijet2], clustersOfJets2[ijet2], d1, d2);
+      }
+      else {
+        SetMatchingLevel(jet1, jet2, fMatching);
+        continue;
+      }
+
+      UpdateClosestJets(jet1, jet2, d1, d2);
     } // jet2 loop
   } // jet1 loop
 }
 
 //________________________________________________________________________
-void AliJetResponseMaker::GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const
+void AliJetResponseMaker::FillMatchingConstituents(AliEmcalJet *jet, MatchingType matching, ConstituentList &tracks, ConstituentList &clusters) const
 {
-  d = jet1->DeltaR(jet2);
+  // Reduce the constituents of a jet to (index, pt) pairs, for the MC label or same collections matching.
+
+  tracks.clear();
+  clusters.clear();
+
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  Bool_t useTracks = kFALSE;
+  Bool_t useClusters = kFALSE;
+  if (matching == kMCLabel) {
+    useTracks = (jets2->GetParticleContainer() != 0);
+  }
+  else if (matching == kSameCollections) {
+    useTracks = (jets1->GetParticleContainer() && jets2->GetParticleContainer());
+    // with cells the shared cluster energy is computed in SubtractSharedCellEnergy
+    useClusters = (jets1->GetClusterContainer() && jets2->GetClusterContainer() && !(fUseCellsToMatch && fCaloCells));
+  }
+
+  if (useTracks) {
+    for (Int_t iTrack = 0; iTrack < jet->GetNumberOfTracks(); iTrack++) {
+      AliVParticle *part = jet->Track(iTrack);
+      if (!part) {
+        AliWarning(Form("Could not find track %d!", jet->TrackAt(iTrack)));
+        continue;
+      }
+      tracks.push_back(std::make_pair(jet->TrackAt(iTrack), part->Pt()));
+    }
+  }
+
+  if (useClusters) {
+    for (Int_t iClus = 0; iClus < jet->GetNumberOfClusters(); iClus++) {
+      AliVCluster *clus = jet->Cluster(iClus);
+      if (!clus) {
+        AliWarning(Form("Could not find cluster %d!", jet->ClusterAt(iClus)));
+        continue;
+      }
+      TLorentzVector part;
+      clus->GetMomentum(part, fVertex);
+      clusters.push_back(std::make_pair(jet->ClusterAt(iClus), part.Pt()));
+    }
+  }
 }
 
 //________________________________________________________________________
-void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const
-{ 
+void AliJetResponseMaker::FillMCLabelSharedEnergy(AliEmcalJet *jet1, SharedEnergyMap &shared1) const
+{
+  // Associate the constituents of a jet 1 with the MC particles (indexes in the particle container of the jets 2).
+
   AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
   AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
 
-  if (!jets1 || !jets1->GetArray() || !jets2 || !jets2->GetArray()) return;
-
   // tracks1 just serves as a proxy to ensure that tracks are in jets1
   AliParticleContainer *tracks1   = jets1->GetParticleContainer();
   // tracks2 is used to retrieve MC labels associated with tracks in the container
   // NOTE: For multiple containers, this would need to be generalized!
   AliParticleContainer *tracks2   = jets2->GetParticleContainer();
 
-  // d1 and d2 represent the matching level: 0 = maximum level of matching, 1 = the two jets are completely unrelated
-  d1 = jet1->Pt();
-  d2 = jet2->Pt();
-  Double_t totalPt1 = d1; // the total pt of the reconstructed jet will be cleaned from the background
-
-  // remove completely tracks that are not MC particles (label == 0)
-  if (tracks1 && tracks1->GetArray()) {
-    for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
-      AliVParticle *track = jet1->Track(iTrack);
-      if (!track) {
-        AliWarning(Form("Could not find track %d!", iTrack));
-        continue;
-      }
+  shared1.Reset(jet1->Pt()); // the total pt of the reconstructed jet will be cleaned from the background
 
-      Int_t MClabel = TMath::Abs(track->GetLabel());
-      MClabel -= fMCLabelShift;
-      if (MClabel != 0) continue;
+  for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
+    AliVParticle *track = jet1->Track(iTrack);
+    if (!track) {
+      AliWarning(Form("Could not find track %d!", iTrack));
+      continue;
+    }
 
+    Int_t MClabel = TMath::Abs(track->GetLabel());
+    MClabel -= fMCLabelShift;
+    if (MClabel == 0 && tracks1 && tracks1->GetArray()) {
       // this is not a MC particle; remove it completely
       AliDebug(3,Form("Track %d (pT = %f) is not a MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
-      totalPt1 -= track->Pt();
-      d1 -= track->Pt();
+      shared1.Remove(track->Pt());
+    }
+    if (MClabel <= 0 || !tracks2) continue;
+
+    Int_t index = tracks2->GetIndexFromLabel(MClabel);
+    if (index < 0) {
+      AliDebug(2,Form("Track %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
+      continue;
     }
+    shared1.Add(index, track->Pt(), 1.);
   }
 
-  // remove completely clusters that are not MC particles (label == 0)
-  if (fUseCellsToMatch && fCaloCells) { 
-    for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
-      AliVCluster *clus = jet1->Cluster(iClus);
-      if (!clus) {
-        AliWarning(Form("Could not find cluster %d!", iClus));
-        continue;
-      }
-      AliTLorentzVector part;
-      clus->GetMomentum(part, fVertex);
+  for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
+    AliVCluster *clus = jet1->Cluster(iClus);
+    if (!clus) {
+      AliWarning(Form("Could not find cluster %d!", iClus));
+      continue;
+    }
+    AliTLorentzVector part;
+    clus->GetMomentum(part, fVertex);
 
+    if (fUseCellsToMatch && fCaloCells) { // if the cell colection is available, look for cells with a matched MC particle
       for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) {
         Int_t cellId = clus->GetCellAbsId(iCell);
         Double_t cellFrac = clus->GetCellAmplitudeFraction(iCell);
 
         Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(cellId));
         MClabel -= fMCLabelShift;
-        if (MClabel != 0) continue;
+        if (MClabel == 0) {
+          // this is not a MC particle; remove it completely
+          AliDebug(3,Form("Cell %d (frac = %f) is not a MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
+          shared1.Remove(part.Pt() * cellFrac);
+        }
+        if (MClabel <= 0 || !tracks2) continue;
 
-        // this is not a MC particle; remove it completely
-        AliDebug(3,Form("Cell %d (frac = %f) is not a MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
-        totalPt1 -= part.Pt() * cellFrac;
-        d1 -= part.Pt() * cellFrac;
+        Int_t index = tracks2->GetIndexFromLabel(MClabel);
+        if (index < 0) {
+          AliDebug(3,Form("Cell %d (frac = %f) does not have an associated MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
+          continue;
+        }
+        shared1.Add(index, part.Pt() * cellFrac, cellFrac);
       }
     }
-  }
-  else {
-    for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
-      AliVCluster *clus = jet1->Cluster(iClus);
-      if (!clus) {
-        AliWarning(Form("Could not find cluster %d!", iClus));
-        continue;
-      }
-      TLorentzVector part;
-      clus->GetMomentum(part, fVertex);
-
+    else { //otherwise look for the first contributor to the cluster
       Int_t MClabel = TMath::Abs(clus->GetLabel());
       MClabel -= fMCLabelShift;
-      if (MClabel != 0) continue;
-
-      // this is not a MC particle; remove it completely
-      AliDebug(3,Form("Cluster %d (pT = %f) is not a MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
-      totalPt1 -= part.Pt();
-      d1 -= part.Pt();
-    }
-  }
-
-  for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
-    Bool_t track2Found = kFALSE;
-    Int_t index2 = jet2->TrackAt(iTrack2);
-
-    // now look for common particles in the track array
-    for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
-      AliVParticle *track = jet1->Track(iTrack);
-      if (!track) {
-        AliWarning(Form("Could not find track %d!", iTrack));
-        continue;
+      if (MClabel == 0) {
+        // this is not a MC particle; remove it completely
+        AliDebug(3,Form("Cluster %d (pT = %f) is not a MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
+        shared1.Remove(part.Pt());
       }
-      Int_t MClabel = TMath::Abs(track->GetLabel());
-      MClabel -= fMCLabelShift;	  
-      if (MClabel <= 0) continue;
+      if (MClabel <= 0 || !tracks2) continue;
 
-      Int_t index = -1;
-      index = tracks2->GetIndexFromLabel(MClabel);
+      Int_t index = tracks2->GetIndexFromLabel(MClabel);
       if (index < 0) {
-        AliDebug(2,Form("Track %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
+        AliDebug(3,Form("Cluster %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
         continue;
       }
-
-      if (index2 != index) continue;
-
-      // found common particle
-      d1 -= track->Pt();
-
-      if (!track2Found) {
-        AliVParticle *MCpart = jet2->Track(iTrack2);
-        AliDebug(3,Form("Track %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-            iTrack,track->Pt(),track->Eta(),track->Phi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
-        d2 -= MCpart->Pt();
-      }
-
-      track2Found = kTRUE;
+      shared1.Add(index, part.Pt(), 1.);
     }
+  }
+}
 
-    // now look for common particles in the cluster array
-    if (fUseCellsToMatch && fCaloCells) { // if the cell colection is available, look for cells with a matched MC particle
-      for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
-        AliVCluster *clus = jet1->Cluster(iClus);
-        if (!clus) {
-          AliWarning(Form("Could not find cluster %d!", iClus));
-          continue;
-        }
-        AliTLorentzVector part;
-        clus->GetMomentum(part, fVertex);
-
-        for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) {
-          Int_t cellId = clus->GetCellAbsId(iCell);
-          Double_t cellFrac = clus->GetCellAmplitudeFraction(iCell);
-
-          Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(cellId));
-          MClabel -= fMCLabelShift;
-          if (MClabel <= 0) continue;
-
-          Int_t index1 = -1;
-          index1 = tracks2->GetIndexFromLabel(MClabel);
-          if (index1 < 0) {
-            AliDebug(3,Form("Cell %d (frac = %f) does not have an associated MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
-            continue;
-          }
+//________________________________________________________________________
+void AliJetResponseMaker::FillSameCollectionsSharedEnergy(AliEmcalJet *jet1, SharedEnergyMap &tracks1, SharedEnergyMap &clusters1) const
+{
+  // Index the constituents of a jet 1 by their position in the track and cluster collections.
 
-          if (index2 != index1) continue;
+  tracks1.Reset(jet1->Pt());
+  clusters1.Reset(jet1->Pt());
 
-          // found common particle
-          d1 -= part.Pt() * cellFrac;
+  ConstituentList constTracks1, constClusters1;
+  FillMatchingConstituents(jet1, kSameCollections, constTracks1, constClusters1);
 
-          if (!track2Found) { // only if it is not already found among charged tracks (charged particles are most likely already found)
-            AliVParticle *MCpart = jet2->Track(iTrack2);
-            AliDebug(3,Form("Cell %d belonging to cluster %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-                iCell,iClus,part.Pt(),part.Eta(),part.Phi_0_2pi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
-            d2 -= MCpart->Pt() * cellFrac;
-          }
+  for (auto &constituent1 : constTracks1) tracks1.Add(constituent1.first, constituent1.second, 1.);
+  for (auto &constituent1 : constClusters1) clusters1.Add(constituent1.first, constituent1.second, 1.);
+}
 
-          track2Found = kTRUE;
-        }
-      }
-    }
-    else { //otherwise look for the first contributor to the cluster, and if matched to a MC label remove it
-      for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
-        AliVCluster *clus = jet1->Cluster(iClus);
-        if (!clus) {
-          AliWarning(Form("Could not find cluster %d!", iClus));
-          continue;
-        }
-        AliTLorentzVector part;
-        clus->GetMomentum(part, fVertex);
+//________________________________________________________________________
+void AliJetResponseMaker::GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const
+{
+  d = jet1->DeltaR(jet2);
+}
 
-        Int_t MClabel = TMath::Abs(clus->GetLabel());
-        MClabel -= fMCLabelShift;
-        if (MClabel <= 0) continue;
+//________________________________________________________________________
+void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const
+{ 
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
 
-        Int_t index = -1;
-        index = tracks2->GetIndexFromLabel(MClabel);
+  if (!jets1 || !jets1->GetArray() || !jets2 || !jets2->GetArray()) return;
 
-        if (index < 0) {
-          AliDebug(3,Form("Cluster %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
-          continue;
-        }
+  SharedEnergyMap shared1;
+  ConstituentList tracks2, clusters2;
+  FillMCLabelSharedEnergy(jet1, shared1);
+  FillMatchingConstituents(jet2, kMCLabel, tracks2, clusters2);
 
-        if (index2 != index) continue;
+  GetMCLabelMatchingLevel(jet1, jet2, shared1, tracks2, d1, d2);
+}
 
-        // found common particle
-        d1 -= part.Pt();
+//________________________________________________________________________
+void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet* /*jet1*/, AliEmcalJet *jet2, const SharedEnergyMap &shared1, const ConstituentList &tracks2, Double_t &d1, Double_t &d2) const
+{
+  // MC label matching level from the reduced constituents of jet 1 (FillMCLabelSharedEnergy)
+  // and of jet 2 (FillMatchingConstituents).
 
-        if (!track2Found) { // only if it is not already found among charged tracks (charged particles are most likely already found)
-          AliVParticle *MCpart = jet2->Track(iTrack2);
-          AliDebug(3,Form("Cluster %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-              iClus,part.Pt(),part.Eta(),part.Phi_0_2pi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
+  // d1 and d2 represent the matching level: 0 = maximum level of matching, 1 = the two jets are completely unrelated
+  d1 = shared1.fD1;
+  d2 = jet2->Pt();
 
-          d2 -= MCpart->Pt();
-        }
+  for (auto &constituent2 : tracks2) {
+    auto shared = shared1.fShared.find(constituent2.first);
+    if (shared == shared1.fShared.end()) continue;
 
-        track2Found = kTRUE;
-      }
-    }
+    // found common particle
+    d1 -= shared->second.first;
+    d2 -= constituent2.second * shared->second.second;
   }
 
   if (d1 < 0)
@@ -1659,10 +1819,10 @@ void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet
   if (d2 < 0)
     d2 = 0;
 
-  if (totalPt1 < 1)
+  if (shared1.fTotalPt1 < 1)
     d1 = -1;
   else
-    d1 /= totalPt1;
+    d1 /= shared1.fTotalPt1;
 
   if (jet2->Pt() < 1)
     d2 = -1;
@@ -1678,176 +1838,46 @@ void AliJetResponseMaker::GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, Ali
 
   if (!jets1 || !jets1->GetArray() || !jets2 || !jets2->GetArray()) return;
 
-  // All of the containers are simply used as proxies for whether tracks or clusters are in a jet
-  AliParticleContainer *tracks1   = jets1->GetParticleContainer();
-  AliClusterContainer  *clusters1 = jets1->GetClusterContainer();
-  AliParticleContainer *tracks2   = jets2->GetParticleContainer();
-  AliClusterContainer  *clusters2 = jets2->GetClusterContainer();
+  SharedEnergyMap tracks1, clusters1;
+  ConstituentList tracks2, clusters2;
+  FillSameCollectionsSharedEnergy(jet1, tracks1, clusters1);
+  FillMatchingConstituents(jet2, kSameCollections, tracks2, clusters2);
+
+  GetSameCollectionsMatchingLevel(jet1, jet2, tracks1, clusters1, tracks2, clusters2, d1, d2);
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2,
+    const SharedEnergyMap &tracks1, const SharedEnergyMap &clusters1,
+    const ConstituentList &tracks2, const ConstituentList &clusters2, Double_t &d1, Double_t &d2) const
+{
+  // Same collections matching level from the reduced constituents of jet 1 (FillSameCollectionsSharedEnergy)
+  // and of jet 2 (FillMatchingConstituents).
 
   // d1 and d2 represent the matching level: 0 = maximum level of matching, 1 = the two jets are completely unrelated
   d1 = jet1->Pt();
   d2 = jet2->Pt();
 
-  if (tracks1 && tracks2) {
-
-    for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
-      Int_t index2 = jet2->TrackAt(iTrack2);
-      for (Int_t iTrack1 = 0; iTrack1 < jet1->GetNumberOfTracks(); iTrack1++) {
-        Int_t index1 = jet1->TrackAt(iTrack1);
-        if (index2 == index1) { // found common particle
-          AliVParticle *part1 = jet1->Track(iTrack1);
-          if (!part1) {
-            AliWarning(Form("Could not find track %d!", index1));
-            continue;
-          }
-          AliVParticle *part2 = jet2->Track(iTrack2);
-          if (!part2) {
-            AliWarning(Form("Could not find track %d!", index2));
-            continue;
-          }
-
-          d1 -= part1->Pt();
-          d2 -= part2->Pt();
-          break;
-        }
-      }
-    }
+  for (auto &constituent2 : tracks2) {
+    auto shared = tracks1.fShared.find(constituent2.first);
+    if (shared == tracks1.fShared.end()) continue;
 
+    // found common particle
+    d1 -= shared->second.first;
+    d2 -= constituent2.second;
   }
 
-  if (clusters1 && clusters2) {
-
-    if (fUseCellsToMatch && fCaloCells) {
-      // Note: this section of the code needs to be revised and tested heavily
-      // While fixing some inconsistencies in AliAnalysisTaskEMCALClusterizeFast
-      // some issues came up, e.g. memory leaks (fixed) and inconsistent use of
-      // fCaloCells. In principle the two cluster collections may use cells
-      // from different sources (embedding / non-embedding). This is not handled
-      // correctly in the current version of this code.
-      AliWarning("ATTENTION ATTENTION ATTENTION: this section of the AliJetResponseMaker code needs to be revised and tested before using it for physics!!!");
-      const Int_t nClus1 = jet1->GetNumberOfClusters();
-
-      Int_t ncells1[nClus1];
-      UShort_t *cellsId1[nClus1];
-      Double_t *cellsFrac1[nClus1];
-      Double_t *cellsClusFrac1[nClus1];
-      Int_t *sortedIndexes1[nClus1];
-      Double_t ptClus1[nClus1];
-      for (Int_t iClus1 = 0; iClus1 < nClus1; iClus1++) {
-        Int_t index1 = jet1->ClusterAt(iClus1);
-        AliVCluster *clus1 = clusters1->GetCluster(index1);
-        if (!clus1) {
-          AliWarning(Form("Could not find cluster %d!", index1));
-          ncells1[iClus1] = 0;
-          cellsId1[iClus1] = 0;
-          cellsFrac1[iClus1] = 0;
-          cellsClusFrac1[iClus1] = 0;
-          sortedIndexes1[iClus1] = 0;
-          ptClus1[iClus1] = 0;
-          continue;
-        }
-        TLorentzVector part1;
-        clus1->GetMomentum(part1, fVertex);
-
-        ncells1[iClus1] = clus1->GetNCells();
-        cellsId1[iClus1] = clus1->GetCellsAbsId();
-        cellsFrac1[iClus1] = clus1->GetCellsAmplitudeFraction();
-        cellsClusFrac1[iClus1] = new Double_t[ncells1[iClus1]];
-        sortedIndexes1[iClus1] = new Int_t[ncells1[iClus1]];
-        ptClus1[iClus1] = part1.Pt();
-
-        for (Int_t iCell = 0; iCell < ncells1[iClus1]; iCell++) {
-          cellsClusFrac1[iClus1][iCell] = fCaloCells->GetCellAmplitude(cellsId1[iClus1][iCell]) / clus1->E();
-        }
-
-        TMath::Sort(ncells1[iClus1], cellsId1[iClus1], sortedIndexes1[iClus1], kFALSE);
-      }
-
-      const Int_t nClus2 = jet2->GetNumberOfClusters();
-
-      const Int_t maxNcells2 = 11520;
-      Int_t sortedIndexes2[maxNcells2];
-      for (Int_t iClus2 = 0; iClus2 < nClus2; iClus2++) {
-        Int_t index2 = jet2->ClusterAt(iClus2);
-        AliVCluster *clus2 =  clusters2->GetCluster(index2);
-        if (!clus2) {
-          AliWarning(Form("Could not find cluster %d!", index2));
-          continue;
-        }
-        Int_t ncells2 = clus2->GetNCells();
-        if (ncells2 >= maxNcells2) {
-          AliError(Form("Number of cells in the cluster %d >= %d",ncells2,maxNcells2));
-          continue;
-        }
-        UShort_t *cellsId2 = clus2->GetCellsAbsId();
-        Double_t *cellsFrac2 = clus2->GetCellsAmplitudeFraction();
-        Double_t *cellsClusFrac2 = new Double_t[ncells2];
+  for (auto &constituent2 : clusters2) {
+    auto shared = clusters1.fShared.find(constituent2.first);
+    if (shared == clusters1.fShared.end()) continue;
 
-        for (Int_t iCell = 0; iCell < ncells2; iCell++) {
-          cellsClusFrac2[iCell] = fCaloCells->GetCellAmplitude(cellsId2[iCell]) / clus2->E();
-        }
-
-        TLorentzVector part2;
-        clus2->GetMomentum(part2, fVertex);
-        Double_t ptClus2 = part2.Pt();
-
-        TMath::Sort(ncells2, cellsId2, sortedIndexes2, kFALSE);
-
-        for (Int_t iClus1 = 0; iClus1 < nClus1; iClus1++) {
-          if (sortedIndexes1[iClus1] == 0)
-            continue;
-          Int_t iCell1 = 0, iCell2 = 0;
-          while (iCell1 < ncells1[iClus1] && iCell2 < ncells2) {
-            if (cellsId1[iClus1][sortedIndexes1[iClus1][iCell1]] == cellsId2[sortedIndexes2[iCell2]]) { // found a common cell
-              d1 -= cellsFrac1[iClus1][sortedIndexes1[iClus1][iCell1]] * cellsClusFrac1[iClus1][sortedIndexes1[iClus1][iCell1]] * ptClus1[iClus1];
-              d2 -= cellsFrac2[sortedIndexes2[iCell2]] * cellsClusFrac2[sortedIndexes2[iCell2]] * ptClus2;
-              iCell1++;
-              iCell2++;
-            }
-            else if (cellsId1[iClus1][sortedIndexes1[iClus1][iCell1]] > cellsId2[sortedIndexes2[iCell2]]) {
-              iCell2++;
-            }
-            else {
-              iCell1++;
-            }
-          }
-        }
-        delete[] cellsClusFrac2;
-      }
-      for (Int_t iClus1 = 0; iClus1 < nClus1; iClus1++) {
-        delete[] cellsClusFrac1[iClus1];
-        delete[] sortedIndexes1[iClus1];
-      }
-    }
-    else {
-      for (Int_t iClus2 = 0; iClus2 < jet2->GetNumberOfClusters(); iClus2++) {
-        Int_t index2 = jet2->ClusterAt(iClus2);
-        for (Int_t iClus1 = 0; iClus1 < jet1->GetNumberOfClusters(); iClus1++) {
-          Int_t index1 = jet1->ClusterAt(iClus1);
-          if (index2 == index1) { // found common particle
-            AliVCluster *clus1 = jet1->Cluster(iClus1);
-            if (!clus1) {
-              AliWarning(Form("Could not find cluster %d!", index1));
-              continue;
-            }
-            AliVCluster *clus2 =  jet2->Cluster(iClus2);
-            if (!clus2) {
-              AliWarning(Form("Could not find cluster %d!", index2));
-              continue;
-            }
-            TLorentzVector part1, part2;
-            clus1->GetMomentum(part1, fVertex);
-            clus2->GetMomentum(part2, fVertex);
-
-            d1 -= part1.Pt();
-            d2 -= part2.Pt();
-            break;
-          }
-        }
-      }
-    }
+    // found common particle
+    d1 -= shared->second.first;
+    d2 -= constituent2.second;
   }
 
+  if (fUseCellsToMatch && fCaloCells) SubtractSharedCellEnergy(jet1, jet2, d1, d2);
+
   if (d1 < 0)
     d1 = 0;
 
@@ -1865,6 +1895,121 @@ void AliJetResponseMaker::GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, Ali
     d2 = -1;
 }
 
+//________________________________________________________________________
+void AliJetResponseMaker::SubtractSharedCellEnergy(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const
+{
+  // Subtract the energy of the cells shared by the clusters of the two jets (same collections matching).
+
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  AliClusterContainer  *clusters1 = jets1->GetClusterContainer();
+  AliClusterContainer  *clusters2 = jets2->GetClusterContainer();
+
+  if (!clusters1 || !clusters2) return;
+
+  // Note: this section of the code needs to be revised and tested heavily
+  // While fixing some inconsistencies in AliAnalysisTaskEMCALClusterizeFast
+  // some issues came up, e.g. memory leaks (fixed) and inconsistent use of
+  // fCaloCells. In principle the two cluster collections may use cells
+  // from different sources (embedding / non-embedding). This is not handled
+  // correctly in the current version of this code.
+  AliWarning("ATTENTION ATTENTION ATTENTION: this section of the AliJetResponseMaker code needs to be revised and tested before using it for physics!!!");
+  const Int_t nClus1 = jet1->GetNumberOfClusters();
+
+  Int_t ncells1[nClus1];
+  UShort_t *cellsId1[nClus1];
+  Double_t *cellsFrac1[nClus1];
+  Double_t *cellsClusFrac1[nClus1];
+  Int_t *sortedIndexes1[nClus1];
+  Double_t ptClus1[nClus1];
+  for (Int_t iClus1 = 0; iClus1 < nClus1; iClus1++) {
+    Int_t index1 = jet1->ClusterAt(iClus1);
+    AliVCluster *clus1 = clusters1->GetCluster(index1);
+    if (!clus1) {
+      AliWarning(Form("Could not find cluster %d!", index1));
+      ncells1[iClus1] = 0;
+      cellsId1[iClus1] = 0;
+      cellsFrac1[iClus1] = 0;
+      cellsClusFrac1[iClus1] = 0;
+      sortedIndexes1[iClus1] = 0;
+      ptClus1[iClus1] = 0;
+      continue;
+    }
+    TLorentzVector part1;
+    clus1->GetMomentum(part1, fVertex);
+
+    ncells1[iClus1] = clus1->GetNCells();
+    cellsId1[iClus1] = clus1->GetCellsAbsId();
+    cellsFrac1[iClus1] = clus1->GetCellsAmplitudeFraction();
+    cellsClusFrac1[iClus1] = new Double_t[ncells1[iClus1]];
+    sortedIndexes1[iClus1] = new Int_t[ncells1[iClus1]];
+    ptClus1[iClus1] = part1.Pt();
+
+    for (Int_t iCell = 0; iCell < ncells1[iClus1]; iCell++) {
+      cellsClusFrac1[iClus1][iCell] = fCaloCells->GetCellAmplitude(cellsId1[iClus1][iCell]) / clus1->E();
+    }
+
+    TMath::Sort(ncells1[iClus1], cellsId1[iClus1], sortedIndexes1[iClus1], kFALSE);
+  }
+
+  const Int_t nClus2 = jet2->GetNumberOfClusters();
+
+  const Int_t maxNcells2 = 11520;
+  Int_t sortedIndexes2[maxNcells2];
+  for (Int_t iClus2 = 0; iClus2 < nClus2; iClus2++) {
+    Int_t index2 = jet2->ClusterAt(iClus2);
+    AliVCluster *clus2 =  clusters2->GetCluster(index2);
+    if (!clus2) {
+      AliWarning(Form("Could not find cluster %d!", index2));
+      continue;
+    }
+    Int_t ncells2 = clus2->GetNCells();
+    if (ncells2 >= maxNcells2) {
+      AliError(Form("Number of cells in the cluster %d >= %d",ncells2,maxNcells2));
+      continue;
+    }
+    UShort_t *cellsId2 = clus2->GetCellsAbsId();
+    Double_t *cellsFrac2 = clus2->GetCellsAmplitudeFraction();
+    Double_t *cellsClusFrac2 = new Double_t[ncells2];
+
+    for (Int_t iCell = 0; iCell < ncells2; iCell++) {
+      cellsClusFrac2[iCell] = fCaloCells->GetCellAmplitude(cellsId2[iCell]) / clus2->E();
+    }
+
+    TLorentzVector part2;
+    clus2->GetMomentum(part2, fVertex);
+    Double_t ptClus2 = part2.Pt();
+
+    TMath::Sort(ncells2, cellsId2, sortedIndexes2, kFALSE);
+
+    for (Int_t iClus1 = 0; iClus1 < nClus1; iClus1++) {
+      if (sortedIndexes1[iClus1] == 0)
+        continue;
+      Int_t iCell1 = 0, iCell2 = 0;
+      while (iCell1 < ncells1[iClus1] && iCell2 < ncells2) {
+        if (cellsId1[iClus1][sortedIndexes1[iClus1][iCell1]] == cellsId2[sortedIndexes2[iCell2]]) { // found a common cell
+          d1 -= cellsFrac1[iClus1][sortedIndexes1[iClus1][iCell1]] * cellsClusFrac1[iClus1][sortedIndexes1[iClus1][iCell1]] * ptClus1[iClus1];
+          d2 -= cellsFrac2[sortedIndexes2[iCell2]] * cellsClusFrac2[sortedIndexes2[iCell2]] * ptClus2;
+          iCell1++;
+          iCell2++;
+        }
+        else if (cellsId1[iClus1][sortedIndexes1[iClus1][iCell1]] > cellsId2[sortedIndexes2[iCell2]]) {
+          iCell2++;
+        }
+        else {
+          iCell1++;
+        }
+      }
+    }
+    delete[] cellsClusFrac2;
+  }
+  for (Int_t iClus1 = 0; iClus1 < nClus1; iClus1++) {
+    delete[] cellsClusFrac1[iClus1];
+    delete[] sortedIndexes1[iClus1];
+  }
+}
+
 //________________________________________________________________________
 void AliJetResponseMaker::SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, MatchingType matching) 
 {
@@ -1886,6 +2031,12 @@ void AliJetResponseMaker::SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2,
     ;
   }
 
+  UpdateClosestJets(jet1, jet2, d1, d2);
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::UpdateClosestJets(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t d1, Double_t d2)
+{
   if (d1 >= 0) {
 
     if (d1 < jet1->ClosestJetDistance()) {
@@ -24,6 +24,9 @@ class TH2;
 class THnSparse;
 class AliNamedArrayI;
 
+#include <utility>
+#include <vector>
+
 #include "AliEmcalJet.h"
 #include "AliAnalysisTaskEmcalJet.h"
 #include "AliEmcalEmbeddingQA.h"
@@ -46,6 +49,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   void                        SetMatching(MatchingType t, Double_t p1=1, Double_t p2=1)       { fMatching = t; fMatchingPar1 = p1; fMatchingPar2 = p2; }
   void                        SetPtHardBin(Int_t b)                                           { fSelectPtHardBin   = b         ; }
   void                        SetUseCellsToMatch(Bool_t i)                                    { fUseCellsToMatch   = i         ; }
+  void                        SetMatchingSearchRadius(Double_t r)                             { fMatchingSearchRadius = r      ; }
   void                        SetMinJetMCPt(Float_t pt)                                       { fMinJetMCPt        = pt        ; }
   void                        SetHistoType(Int_t b)                                           { fHistoType         = b         ; }
   void                        SetDeltaPtAxis(Int_t b)                                         { fDeltaPtAxis       = b         ; }
@@ -91,15 +95,27 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
       const Double_t    maxTrackPt         = 100);
 
  protected:
+  class SharedEnergyMap;
+  typedef std::vector<std::pair<Int_t, Double_t> > ConstituentList; // (index in the collection, pt) of the jet constituents
+
   void                        ExecOnce();
   void                        DoJetLoop();
   Bool_t                      FillHistograms();
   Bool_t                      Run();
   Bool_t                      DoJetMatching();
   void                        SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, MatchingType matching);
+  void                        UpdateClosestJets(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t d1, Double_t d2);
+  Double_t                    GetMatchingSearchRadius() const;
   void                        GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const;
   void                        GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
   void                        GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
+  void                        GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, const SharedEnergyMap &shared1, const ConstituentList &tracks2, Double_t &d1, Double_t &d2) const;
+  void                        GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, const SharedEnergyMap &tracks1, const SharedEnergyMap &clusters1,
+                                                              const ConstituentList &tracks2, const ConstituentList &clusters2, Double_t &d1, Double_t &d2) const;
+  void                        FillMatchingConstituents(AliEmcalJet *jet, MatchingType matching, ConstituentList &tracks, ConstituentList &clusters) const;
+  void                        FillMCLabelSharedEnergy(AliEmcalJet *jet1, SharedEnergyMap &shared1) const;
+  void                        FillSameCollectionsSharedEnergy(AliEmcalJet *jet1, SharedEnergyMap &tracks1, SharedEnergyMap &clusters1) const;
+  void                        SubtractSharedCellEnergy(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
   void                        FillMatchingHistos(AliEmcalJet* jet1, AliEmcalJet* jet2, Double_t d, Double_t CE1, Double_t CE2);
   void                        FillJetHisto(AliEmcalJet* jet, Int_t Set);
   void                        AllocateTH2();
@@ -110,6 +126,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   Double_t                    fMatchingPar1;                           // matching parameter for jet1-jet2 matching
   Double_t                    fMatchingPar2;                           // matching parameter for jet2-jet1 matching
   Bool_t                      fUseCellsToMatch;                        // use cells instead of clusters to match jets (slower but sometimes needed)
+  Double_t                    fMatchingSearchRadius;                   // only jet pairs closer than this in eta-phi are tested (0 = all pairs, default; <0 = automatic)
   Double_t                    fMinJetMCPt;                             // minimum jet MC pt
   AliEmcalEmbeddingQA         fEmbeddingQA;                            //!<! Embedding QA hists (will only be added if embedding)
   Int_t                       fHistoType;                              // histogram type (0=TH2, 1=THnSparse)
@@ -204,6 +221,6 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   AliJetResponseMaker(const AliJetResponseMaker&);            // not implemented
   AliJetResponseMaker &operator=(const AliJetResponseMaker&); // not implemented
 
-  ClassDef(AliJetResponseMaker, 29) // Jet response matrix producing task
+  ClassDef(AliJetResponseMaker, 30) // Jet response matrix producing task
 };
 #endif
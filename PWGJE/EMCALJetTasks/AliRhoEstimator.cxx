@@ -0,0 +1,77 @@
+// $Id$
+//
+// Median and mean of the rho values collected in an event.
+// The values are kept in buffers owned by the estimator, reused
+// from one event to the next, so that the rho tasks need neither
+// fixed-size static arrays nor a copy of the values for the median.
+
+#include <algorithm>
+
+#include "AliRhoEstimator.h"
+
+ClassImp(AliRhoEstimator)
+
+//________________________________________________________________________
+AliRhoEstimator::AliRhoEstimator() :
+  TObject(),
+  fRho(),
+  fE(),
+  fM()
+{
+  // Constructor.
+}
+
+//________________________________________________________________________
+void AliRhoEstimator::Reset()
+{
+  // Remove all the values (the allocated memory is kept for the next event).
+
+  fRho.clear();
+  fE.clear();
+  fM.clear();
+}
+
+//________________________________________________________________________
+Double_t AliRhoEstimator::GetMedian()
+{
+  // Median of the rho values (the order of the values is changed).
+
+  if (fRho.empty())
+    return 0;
+
+  return Median(fRho.size(), &fRho[0]);
+}
+
+//________________________________________________________________________
+Double_t AliRhoEstimator::Median(Int_t n, Double_t *values)
+{
+  // Median of n values, same as TMath::Median (average of the two
+  // central values for an even number of values), without copying the values.
+  // The order of the values is changed.
+
+  if (n <= 0)
+    return 0;
+
+  Double_t *mid = values + n / 2;
+  std::nth_element(values, mid, values + n);
+  if (n % 2 == 1)
+    return *mid;
+
+  Double_t low = *std::max_element(values, mid);
+  return (low + *mid) * 0.5;
+}
+
+//________________________________________________________________________
+Double_t AliRhoEstimator::Mean(const std::vector<Double_t> &values)
+{
+  // Mean of the values, same as TMath::Mean.
+
+  Double_t sum = 0;
+  Double_t sumw = 0;
+  for (std::vector<Double_t>::const_iterator it = values.begin(); it != values.end(); ++it) {
+    sum += *it;
+    sumw += 1;
+  }
+
+  return sumw > 0 ? sum / sumw : 0;
+}
@@ -0,0 +1,39 @@
+#ifndef ALIRHOESTIMATOR_H
+#define ALIRHOESTIMATOR_H
+
+// $Id$
+
+#include <vector>
+
+#include <TObject.h>
+
+class AliRhoEstimator : public TObject {
+ public:
+  AliRhoEstimator();
+  virtual ~AliRhoEstimator() {}
+
+  void             Reset();
+  void             Add(Double_t rho)                         { fRho.push_back(rho)                       ; }
+  void             Add(Double_t rho, Double_t e, Double_t m) { fRho.push_back(rho); fE.push_back(e); fM.push_back(m); }
+
+  Int_t            GetN()                              const { return fRho.size()                        ; }
+  Double_t         GetMedian();
+  Double_t         GetMean()                           const { return Mean(fRho)                         ; }
+  Double_t         GetMeanE()                          const { return Mean(fE)                           ; }
+  Double_t         GetMeanM()                          const { return Mean(fM)                           ; }
+
+  static Double_t  Median(Int_t n, Double_t *values);
+  static Double_t  Mean(const std::vector<Double_t> &values);
+
+ protected:
+  std::vector<Double_t> fRho;                      //!rho (or pt) of the accepted objects
+  std::vector<Double_t> fE;                        //!energy of the accepted jets
+  std::vector<Double_t> fM;                        //!mass of the accepted jets
+
+ private:
+  AliRhoEstimator(const AliRhoEstimator&);             // not implemented
+  AliRhoEstimator& operator=(const AliRhoEstimator&);  // not implemented
+
+  ClassDef(AliRhoEstimator, 1); // Median and mean of the rho values of an event
+};
+#endif
@@ -18,6 +18,7 @@
 #pragma link C++ class AliAnalysisTaskRhoBaseDev+;
 #pragma link C++ class AliAnalysisTaskRhoDev+;
 #pragma link C++ class AliAnalysisTaskRhoTransDev+;
+#pragma link C++ class AliRhoEstimator+;
 #pragma link C++ class AliAnalysisTaskDeltaPt+;
 #pragma link C++ class AliAnalysisTaskScale+;
 #pragma link C++ class AliEmcalJetByJetCorrection+;
@@ -202,6 +202,8 @@ AliFMDEnergyFitter::CreateOutputObjects(TList* dir)
   d->Add(AliForwardUtil::MakeParameter("regCut",        fRegularizationCut));
   d->Add(AliForwardUtil::MakeParameter("deltaShift", 
 				       AliLandauGaus::EnableSigmaShift()));
+  d->Add(AliForwardUtil::MakeParameter("tabulated", 
+				       AliLandauGaus::EnableTabulation()));
 
   if (fRingHistos.GetEntries() <= 0) { 
     AliFatal("No ring histograms where defined - giving up!");
@@ -298,6 +300,23 @@ AliFMDEnergyFitter::SetEnableDeltaShift(Bool_t use)
 {
   AliLandauGaus::EnableSigmaShift(use ? 1 : 0);
 }
+//____________________________________________________________________
+void
+AliFMDEnergyFitter::SetEnableTabulation(Bool_t use) 
+{
+  AliLandauGaus::EnableTabulation(use ? 1 : 0);
+  if (!use) return;
+
+  // Check that the tabulated Landau-Gauss reproduces the numerical
+  // convolution over the whole table before using it in the fits
+  Double_t dev = AliLandauGaus::CheckTabulation();
+  AliInfoF("Tabulated Landau-Gauss deviates by at most %g from the "
+	   "numerical convolution", dev);
+  if (dev > 1e-3) { 
+    AliWarningF("Deviation %g too large, disabling the tabulation", dev);
+    AliLandauGaus::EnableTabulation(0);
+  }
+}
 
 //____________________________________________________________________
 Bool_t
@@ -583,6 +602,7 @@ AliFMDEnergyFitter::Print(Option_t*) const
   PFV("max(chi^2/nu)",	        fMaxChi2PerNDF);
   PFV("min(a_i)",	        fMinWeight);
   PFV("Regularization cut",     fRegularizationCut);
+  PFB("Tabulated Landau-Gauss", AliLandauGaus::EnableTabulation());
   TString r = "";
   switch (fResidualMethod) { 
   case kNoResiduals:              r = "None";       break;
@@ -299,6 +299,17 @@ public:
    * @param use If true, enable extra shift @f$\delta\Delta_p(\sigma/\xi)@f$  
    */
   void SetEnableDeltaShift(Bool_t use=true);
+  /**
+   * Whether to interpolate the Landau-Gauss in a table rather than
+   * doing the numerical convolution for each evaluation during the
+   * fits (see AliLandauGaus::FTab).  When enabled, the table is
+   * checked once against the numerical convolution over its full
+   * range, and the tabulation is disabled again if it deviates by
+   * more than @f$10^{-3}@f$.
+   *
+   * @param use If true, enable the tabulation
+   */
+  void SetEnableTabulation(Bool_t use=true);
 
   /* @} */
   // -----------------------------------------------------------------
@@ -13,6 +13,7 @@
 #include <TObject.h>
 #include <TF1.h>
 #include <TMath.h>
+#include <vector>
 
 /** 
  * This class contains static member functions to calculate the energy
@@ -162,6 +163,30 @@ public:
    * Number of steps to do in the Landau, Gaussiam convolution 
    */
   static Int_t NSteps() { return 100; }
+  /** 
+   * Smallest @f$ r=\sigma'/\xi@f$ in the table of @f$ f@f$ 
+   */
+  static Double_t TabRMin() { return 0.01; }
+  /** 
+   * Number of rows per decade of @f$ r=\sigma'/\xi@f$ in the table of
+   * @f$ f@f$
+   */
+  static Int_t TabNPerDecade() { return 20; }
+  /** 
+   * Number of rows of the table of @f$ f@f$ - @f$ r@f$ goes up to 10.
+   * Beyond that the integration steps are coarser than the width of
+   * the Landau, and the numerical integration is not smooth enough to
+   * be interpolated
+   */
+  static Int_t TabNR() { return 61; }
+  /** 
+   * Step in @f$ u=(x-\Delta_p)/\xi@f$ of the table of @f$ f@f$
+   */
+  static Double_t TabDU() { return 0.05; }
+  /** 
+   * Largest @f$ u=(x-\Delta_p)/\xi@f$ in the table of @f$ f@f$
+   */
+  static Double_t TabUMax() { return 150; }
   /* @} */
 
   //__________________________________________________________________
@@ -211,6 +236,48 @@ public:
   static Double_t F(Double_t x, Double_t delta, Double_t xi, 
 		    Double_t sigma, Double_t sigma_n);
   //------------------------------------------------------------------
+  /** 
+   * Calculate the value of a Landau convolved with a Gaussian by
+   * numerical integration (see F).  This is what F returns when the
+   * tabulation is not enabled, or outside the range of the table.
+   * 
+   * @param x         where to evaluate @f$ f@f$
+   * @param delta     @f$ \Delta_p@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
+   * @param xi        @f$ \xi@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
+   * @param sigma     @f$ \sigma@f$ of @f$\sigma'^2=\sigma^2-\sigma_n^2 @f$
+   * @param sigma_n   @f$ \sigma_n@f$ of @f$\sigma'^2=\sigma^2-\sigma_n^2 @f$
+   * 
+   * @return @f$ f@f$ evaluated at @f$ x@f$.  
+   */
+  static Double_t FConv(Double_t x, Double_t delta, Double_t xi, 
+			Double_t sigma, Double_t sigma_n);
+  //------------------------------------------------------------------
+  /** 
+   * Interpolate the value of a Landau convolved with a Gaussian in a
+   * table.  The numerical convolution only depends on @f$
+   * u=(x-\Delta_p)/\xi@f$ and @f$ r=\sigma'/\xi@f$
+   *
+   * @f[ 
+   *   f(x;\Delta_p,\xi,\sigma') = \frac{1}{\xi} f(u;0,1,r)
+   * @f]
+   *
+   * so it is tabulated once in @f$ u@f$ (steps of TabDU()) and @f$\log
+   * r@f$ (TabNPerDecade() rows per decade), and interpolated with
+   * third order polynomials in both directions.  The rows of the
+   * table are calculated with FConv the first time they are needed.
+   * 
+   * @param x         where to evaluate @f$ f@f$
+   * @param delta     @f$ \Delta_p@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
+   * @param xi        @f$ \xi@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
+   * @param sigma     @f$ \sigma@f$ of @f$\sigma'^2=\sigma^2-\sigma_n^2 @f$
+   * @param sigma_n   @f$ \sigma_n@f$ of @f$\sigma'^2=\sigma^2-\sigma_n^2 @f$
+   * @param f         On return, @f$ f@f$ evaluated at @f$ x@f$
+   * 
+   * @return false if @f$(u,r)@f$ is outside the table 
+   */
+  static Bool_t FTab(Double_t x, Double_t delta, Double_t xi, 
+		     Double_t sigma, Double_t sigma_n, Double_t& f);
+  //------------------------------------------------------------------
   /** 
    * Evaluate 
    * @f[ 
@@ -308,6 +375,28 @@ public:
    * @return whether the sigma shift is enabled or not 
    */
   static Bool_t EnableSigmaShift(Short_t val=-1);
+  /** 
+   * Set and check if F is interpolated in a table (see FTab) rather
+   * than calculated by numerical integration.
+   * 
+   * @param val if <0, then only check.  Otherwise set enabled (>0) or not (=0)
+   * 
+   * @return whether the tabulation is enabled or not 
+   */
+  static Bool_t EnableTabulation(Short_t val=-1);
+  /** 
+   * Compare the interpolation in the table to the numerical
+   * integration half way between the nodes of the table, for all
+   * the rows used by the interpolation with @f$ r=\sigma'/\xi@f$ in
+   * the given range, and up to the largest tabulated @f$ u@f$.  The
+   * defaults cover the full range in which the table is used.
+   * 
+   * @param rMin  Least @f$ r@f$ to check 
+   * @param rMax  Largest @f$ r@f$ to check 
+   * 
+   * @return The largest deviation relative to the maximum of @f$ f@f$
+   */
+  static Double_t CheckTabulation(Double_t rMin=0, Double_t rMax=10);
   /** 
    * Get the shift of the MPV due to convolution with a Gaussian. 
    *
@@ -474,6 +563,25 @@ public:
    */
   static Double_t CompFunc(Double_t* xp, Double_t* pp);
   /* @} */
+protected:
+  /** 
+   * Get a value of the table of @f$ f(u;0,1,r)@f$ - see FTab
+   * 
+   * @param k  Row, @f$ r=r_{min}10^{k/n}@f$ 
+   * @param j  Column, @f$ u=u_{min}(r)+j\delta u@f$ 
+   * 
+   * @return The tabulated value, 0 below the first column
+   */
+  static Double_t TabValue(Int_t k, Int_t j);
+  /** 
+   * Least @f$ u@f$ of a row of the table. Below that @f$ f(u;0,1,r)@f$
+   * vanishes.
+   * 
+   * @param r  @f$ r=\sigma'/\xi@f$ of the row 
+   * 
+   * @return Least @f$ u@f$ of the row 
+   */
+  static Double_t TabUMin(Double_t r) { return -8 - (NSigma()+1) * r; }
 };
 //____________________________________________________________________
 inline Bool_t
@@ -523,12 +631,32 @@ AliLandauGaus::Fl(Double_t x, Double_t delta, Double_t xi)
   return TMath::Landau(x, deltaP, xi, true);
 }
 //____________________________________________________________________
+inline Bool_t
+AliLandauGaus::EnableTabulation(Short_t val)
+{
+  static Bool_t enabled = false;
+  if (val >= 0) enabled = val == 1;
+  return enabled;
+}
+//____________________________________________________________________
 inline Double_t 
 AliLandauGaus::F(Double_t x, Double_t delta, Double_t xi,
 		 Double_t sigma, Double_t sigmaN)
 {
   if (xi <= 0) return 0;
 
+  Double_t f = 0;
+  if (EnableTabulation() && FTab(x, delta, xi, sigma, sigmaN, f)) return f;
+
+  return FConv(x, delta, xi, sigma, sigmaN);
+}
+//____________________________________________________________________
+inline Double_t 
+AliLandauGaus::FConv(Double_t x, Double_t delta, Double_t xi,
+		     Double_t sigma, Double_t sigmaN)
+{
+  if (xi <= 0) return 0;
+
   const Int_t    nSteps = NSteps();
   const Double_t nSigma = NSigma();
   const Double_t deltaP = delta; // - sigma * sigmaShift; // + sigma * mpshift;
@@ -547,6 +675,92 @@ AliLandauGaus::F(Double_t x, Double_t delta, Double_t xi,
   }
   return step * sum * InvSq2Pi() / sigma1;
 }
+//____________________________________________________________________
+inline Double_t 
+AliLandauGaus::TabValue(Int_t k, Int_t j)
+{
+  static std::vector<std::vector<Double_t> > table(TabNR());
+  if (j < 0) return 0;
+
+  std::vector<Double_t>& row = table[k];
+  if (row.empty()) { 
+    // f(u;0,1,r) - delta is such that the shifted Landau peaks at 0
+    const Double_t r    = TabRMin() * TMath::Power(10., Double_t(k) / TabNPerDecade());
+    const Double_t uMin = TabUMin(r);
+    const Int_t    n    = Int_t((TabUMax() - uMin) / TabDU()) + 1;
+    row.resize(n);
+    for (Int_t i = 0; i < n; i++) 
+      row[i] = FConv(uMin + i * TabDU(), MPShift(), 1, r, 0);
+  }
+  return row[j];
+}
+//____________________________________________________________________
+inline Bool_t 
+AliLandauGaus::FTab(Double_t x, Double_t delta, Double_t xi, 
+		    Double_t sigma, Double_t sigmaN, Double_t& f)
+{
+  if (xi <= 0) return false;
+
+  const Double_t sigma1 = sigmaN == 0 ? sigma : 
+    TMath::Sqrt(sigmaN*sigmaN + sigma*sigma);
+  const Double_t r      = sigma1 / xi;
+  const Double_t u      = (x - delta + xi * MPShift()) / xi;
+  if (r <= 0 || u > TabUMax() - 2 * TabDU()) return false;
+
+  // Row interpolation in log(r), using rows k-1 to k+2 
+  const Double_t t      = TMath::Log10(r / TabRMin()) * TabNPerDecade();
+  const Int_t    k      = Int_t(TMath::Floor(t));
+  if (k < 1 || k + 2 >= TabNR()) return false;
+
+  Double_t wr[4], wu[4];
+  Double_t g            = 0;
+  const Double_t fr     = t - k;
+  wr[0] = -fr * (fr - 1) * (fr - 2) / 6;
+  wr[1] = (fr + 1) * (fr - 1) * (fr - 2) / 2;
+  wr[2] = -(fr + 1) * fr * (fr - 2) / 2;
+  wr[3] = (fr + 1) * fr * (fr - 1) / 6;
+  for (Int_t ik = 0; ik < 4; ik++) { 
+    const Int_t    kk   = k - 1 + ik;
+    const Double_t rk   = TabRMin() * TMath::Power(10., Double_t(kk) / TabNPerDecade());
+    const Double_t s    = (u - TabUMin(rk)) / TabDU();
+    const Int_t    j    = Int_t(TMath::Floor(s));
+    if (j + 2 < 0) continue; // f vanishes here 
+
+    const Double_t fu   = s - j;
+    wu[0] = -fu * (fu - 1) * (fu - 2) / 6;
+    wu[1] = (fu + 1) * (fu - 1) * (fu - 2) / 2;
+    wu[2] = -(fu + 1) * fu * (fu - 2) / 2;
+    wu[3] = (fu + 1) * fu * (fu - 1) / 6;
+    Double_t gk = 0;
+    for (Int_t ij = 0; ij < 4; ij++) gk += wu[ij] * TabValue(kk, j - 1 + ij);
+    g += wr[ik] * gk;
+  }
+  // The interpolation may ring slightly below 0 where f rises steeply
+  f = (g > 0 ? g : 0) / xi;
+  return true;
+}
+//____________________________________________________________________
+inline Double_t 
+AliLandauGaus::CheckTabulation(Double_t rMin, Double_t rMax)
+{
+  Double_t maxDev = 0;
+  // FTab interpolates between rows k-1 and k+2 for 1 <= k < TabNR()-2
+  for (Int_t k = 1; k + 2 < TabNR(); k++) { 
+    // Half way between the rows, and between the columns
+    const Double_t rr = TabRMin() * TMath::Power(10., (k + .5) / TabNPerDecade());
+    if (rr < rMin || rr > rMax) continue;
+    Double_t maxF = 0, maxD = 0;
+    for (Double_t u = -5 - NSigma() * rr; u < TabUMax(); u += 7.5 * TabDU()) { 
+      const Double_t fc = FConv(u, MPShift(), 1, rr, 0);
+      Double_t       ft = 0;
+      if (!FTab(u, MPShift(), 1, rr, 0, ft)) continue;
+      maxF = TMath::Max(maxF, fc);
+      maxD = TMath::Max(maxD, TMath::Abs(ft - fc));
+    }
+    if (maxF > 0) maxDev = TMath::Max(maxDev, maxD / maxF);
+  }
+  return maxDev;
+}
 
 //____________________________________________________________________
 inline Double_t 
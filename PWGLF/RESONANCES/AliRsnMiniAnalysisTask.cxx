@@ -18,6 +18,7 @@
 #include <TList.h>
 #include <TTree.h>
 #include <TStopwatch.h>
+#include <TArrayD.h>
 #include "TRandom.h"
 
 #include "AliLog.h"
@@ -91,6 +92,7 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
    fMiniEvent(0x0),
    fBigOutput(kFALSE),
    fMixPrintRefresh(-1),
+   fMixCacheSize(100),
    fCheckDecay(kTRUE),
    fMaxNDaughters(-1),
    fCheckP(kFALSE),
@@ -152,6 +154,7 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const char *name, Bool_t useMC,Bo
    fMiniEvent(0x0),
    fBigOutput(kFALSE),
    fMixPrintRefresh(-1),
+   fMixCacheSize(100),
    fCheckDecay(kTRUE),
    fMaxNDaughters(-1),
    fCheckP(kFALSE),
@@ -219,6 +222,7 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const AliRsnMiniAnalysisTask &cop
    fMiniEvent(0x0),
    fBigOutput(copy.fBigOutput),
    fMixPrintRefresh(copy.fMixPrintRefresh),
+   fMixCacheSize(copy.fMixCacheSize),
    fCheckDecay(copy.fCheckDecay),
    fMaxNDaughters(copy.fMaxNDaughters),
    fCheckP(copy.fCheckP),
@@ -287,6 +291,7 @@ AliRsnMiniAnalysisTask &AliRsnMiniAnalysisTask::operator=(const AliRsnMiniAnalys
    fESDtrackCuts = copy.fESDtrackCuts;
    fBigOutput = copy.fBigOutput;
    fMixPrintRefresh = copy.fMixPrintRefresh;
+   fMixCacheSize = copy.fMixCacheSize;
    fCheckDecay = copy.fCheckDecay;
    fMaxNDaughters = copy.fMaxNDaughters;
    fCheckP = copy.fCheckP;
@@ -524,7 +529,7 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    // prepare variables
    Int_t ievt, nEvents = (Int_t)fEvBuffer->GetEntries();
    Int_t idef, nDefs   = fHistograms.GetEntries();
-   Int_t imix, iloop, ifill;
+   Int_t imix, ifill;
    AliRsnMiniOutput *def = 0x0;
    AliRsnMiniOutput::EComputation compType;
 
@@ -535,6 +540,17 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       else printNum = 0;
    }
 
+   // outputs with the same daughter definitions share the loop on pairs:
+   // the pairs are built once by the first of them and passed to the others
+   TArrayI pairLeader(nDefs);
+   TObjArray pairSharing(nDefs);
+   pairSharing.SetOwner(kTRUE);
+   GroupPairOutputs(pairLeader, pairSharing);
+
+   // the mixing variables of each event are kept while looping,
+   // so that the buffer does not need to be read again to find the matches
+   TArrayD evVz(nEvents), evMult(nEvents), evAngle(nEvents);
+
    // loop on events, and for each one fill all outputs
    // using the appropriate procedure depending on its type
    // only mother-related histograms are filled in UserExec,
@@ -543,6 +559,9 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    for (ievt = 0; ievt < nEvents; ievt++) {
       // get next entry
       fEvBuffer->GetEntry(ievt);
+      evVz[ievt]    = fMiniEvent->Vz();
+      evMult[ievt]  = fMiniEvent->Mult();
+      evAngle[ievt] = fMiniEvent->Angle();
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] Std.Event %d/%d",GetName(), ievt,nEvents));
          timer.Stop(); timer.Print(); fflush(stdout); timer.Start(kFALSE);
@@ -560,20 +579,16 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
                def->FillEvent(fMiniEvent, &fValues);
                break;
             case AliRsnMiniOutput::kTruePair:
-               //AliDebugClass(1, Form("Event %d, def '%s': true-pair histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
             case AliRsnMiniOutput::kTrackPair:
-               //AliDebugClass(1, Form("Event %d, def '%s': pair-value histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
             case AliRsnMiniOutput::kTrackPairRotated1:
-               //AliDebugClass(1, Form("Event %d, def '%s': rotated (1) background histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
             case AliRsnMiniOutput::kTrackPairRotated2:
-               //AliDebugClass(1, Form("Event %d, def '%s': rotated (2) background histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+               //AliDebugClass(1, Form("Event %d, def '%s': pair histogram filling", ievt, def->GetName()));
+               // filled together with the first output sharing the pairs
+               if (pairLeader[idef] != idef) {
+                  ifill = 0;
+                  break;
+               }
+               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues, kTRUE, (TObjArray *)pairSharing[idef]);
                break;
             default:
                // other kinds are processed elsewhere
@@ -592,83 +607,100 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       return;
    }
 
-   // initialize mixing counter
-   Int_t    nmatched[nEvents];
-   TString *smatched = new TString[nEvents];
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      smatched[ievt] = "|";
-      nmatched[ievt] = 0;
-   }
-
+   // initialize mixing counters: nmatched counts all the mixings of an event,
+   // while matched holds the (at most fNMix) partners chosen by each event
+   TArrayI nmatched(nEvents), nchosen(nEvents), matched(nEvents * fNMix);
 
    AliInfo(Form("[%s] Std.Event %d/%d",GetName(), nEvents,nEvents));
    timer.Stop(); timer.Print(); timer.Start(); fflush(stdout);
 
+   // index of the events sorted in Vz: the candidates for the mixing
+   // of an event are searched in a Vz window instead of the whole buffer
+   // (in binned mixing the bin around 0 is twice as large)
+   TArrayI sorted(nEvents);
+   TArrayD sortedVz(nEvents);
+   TMath::Sort(nEvents, evVz.GetArray(), sorted.GetArray(), kFALSE);
+   for (ievt = 0; ievt < nEvents; ievt++) sortedVz[ievt] = evVz[sorted[ievt]];
+   Double_t vzWindow = (fContinuousMix ? 1. : 2.) * TMath::Abs(fMaxDiffVz) * (1. + 1E-9) + 1E-12;
+
    // search for good matchings
+   // the candidates are visited in the same order as the buffer scan,
+   // i.e. starting from the next event and wrapping around
+   TArrayI candidates(nEvents), candOrder(nEvents), candDist(nEvents);
+   Int_t i, icand, ncand, ifirst, ilast;
    for (ievt = 0; ievt < nEvents; ievt++) {
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),ievt,nEvents));
          timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
       }
       if (nmatched[ievt] >= fNMix) continue;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      for (iloop = 1; iloop < nEvents; iloop++) {
-         imix = ievt + iloop;
-         if (imix >= nEvents) imix -= nEvents;
+      ifirst = TMath::Max(TMath::BinarySearch(nEvents, sortedVz.GetArray(), evVz[ievt] - vzWindow), 0);
+      ilast  = TMath::BinarySearch(nEvents, sortedVz.GetArray(), evVz[ievt] + vzWindow);
+      ncand = 0;
+      for (i = ifirst; i <= ilast; i++) {
+         imix = sorted[i];
          if (imix == ievt) continue;
-         // text next entry
-         fEvBuffer->GetEntry(imix);
          // skip if events are not matched
-         if (!EventsMatch(&evMain, fMiniEvent)) continue;
+         if (!EventsMatch(evVz[ievt], evMult[ievt], evAngle[ievt], evVz[imix], evMult[imix], evAngle[imix])) continue;
+         candidates[ncand] = imix;
+         candDist[ncand] = (imix > ievt) ? imix - ievt : imix - ievt + nEvents;
+         ncand++;
+      }
+      TMath::Sort(ncand, candDist.GetArray(), candOrder.GetArray(), kFALSE);
+      for (icand = 0; icand < ncand; icand++) {
+         imix = candidates[candOrder[icand]];
          // check that the array of good matches for mixed does not already contain main event
-         if (smatched[imix].Contains(Form("|%d|", ievt))) continue;
+         for (i = 0; i < nchosen[imix]; i++) if (matched[imix * fNMix + i] == ievt) break;
+         if (i < nchosen[imix]) continue;
          // check that the found good events has not enough matches already
          if (nmatched[imix] >= fNMix) continue;
          // add new mixing candidate
-         smatched[ievt].Append(Form("%d|", imix));
+         matched[ievt * fNMix + nchosen[ievt]] = imix;
+         nchosen[ievt]++;
          nmatched[ievt]++;
          nmatched[imix]++;
          if (nmatched[ievt] >= fNMix) break;
       }
-      AliDebugClass(1, Form("Matches for event %5d = %d [%s] (missing are declared above)", evMain.ID(), nmatched[ievt], smatched[ievt].Data()));
+      AliDebugClass(1, Form("Matches for event %5d = %d (missing are declared above)", ievt, nmatched[ievt]));
    }
 
    AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout); timer.Start();
 
    // perform mixing
-   TObjArray *list = 0x0;
-   TObjString *os = 0x0;
+   // the partners of an event are close to it in the buffer, so the last
+   // fMixCacheSize events read are kept in memory instead of being read again
+   Int_t cacheSize = TMath::Max(fMixCacheSize, 1);
+   TObjArray cache(cacheSize);
+   cache.SetOwner(kTRUE);
+   TArrayI cachedID(cacheSize);
+   cachedID.Reset(-1);
+   AliRsnMiniEvent *evMix = 0x0;
    for (ievt = 0; ievt < nEvents; ievt++) {
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] EventMixing %d/%d",GetName(),ievt,nEvents));
          timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
       }
+      if (nchosen[ievt] < 1) continue;
       ifill = 0;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      list = smatched[ievt].Tokenize("|");
-      TObjArrayIter next(list);
-      while ( (os = (TObjString *)next()) ) {
-         imix = os->GetString().Atoi();
-         fEvBuffer->GetEntry(imix);
+      AliRsnMiniEvent evMain(*GetBufferedEvent(ievt, cache, cachedID));
+      for (i = 0; i < nchosen[ievt]; i++) {
+         imix = matched[ievt * fNMix + i];
+         evMix = GetBufferedEvent(imix, cache, cachedID);
          for (idef = 0; idef < nDefs; idef++) {
             def = (AliRsnMiniOutput *)fHistograms[idef];
             if (!def) continue;
             if (!def->IsTrackPairMix()) continue;
-            ifill += def->FillPair(&evMain, fMiniEvent, &fValues, kTRUE);
+            if (pairLeader[idef] != idef) continue;
+            ifill += def->FillPair(&evMain, evMix, &fValues, kTRUE, (TObjArray *)pairSharing[idef]);
             if (!def->IsSymmetric()) {
                AliDebugClass(2, "Reflecting non symmetric pair");
-               ifill += def->FillPair(fMiniEvent, &evMain, &fValues, kFALSE);
+               ifill += def->FillPair(evMix, &evMain, &fValues, kFALSE, (TObjArray *)pairSharing[idef]);
             }
          }
       }
-      delete list;
    }
 
-   delete [] smatched;
-
    AliInfo(Form("[%s] EventMixing %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout);
 
@@ -1555,33 +1587,35 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
 //
 
    if (!event1 || !event2) return kFALSE;
+   return EventsMatch(event1->Vz(), event1->Mult(), event1->Angle(), event2->Vz(), event2->Mult(), event2->Angle());
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniAnalysisTask::EventsMatch(Double_t vz1, Double_t mult1, Double_t angle1, Double_t vz2, Double_t mult2, Double_t angle2) const
+{
+//
+// Check if two events are compatible, given their vz, mult and angle.
+// See the version above.
+//
+
    Int_t ivz1, ivz2, imult1, imult2, iangle1, iangle2;
    Double_t dv, dm, da;
 
    if (fContinuousMix) {
-      dv = TMath::Abs(event1->Vz()    - event2->Vz()   );
-      dm = TMath::Abs(event1->Mult()  - event2->Mult() );
-      da = TMath::Abs(event1->Angle() - event2->Angle());
-      if (dv > fMaxDiffVz) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Vz = %f", event1->ID(), event2->ID(), dv));
-         return kFALSE;
-      }
-      if (dm > fMaxDiffMult ) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Mult = %f", event1->ID(), event2->ID(), dm));
-         return kFALSE;
-      }
-      if (da > fMaxDiffAngle) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Angle = %f", event1->ID(), event2->ID(), da));
-         return kFALSE;
-      }
+      dv = TMath::Abs(vz1    - vz2   );
+      dm = TMath::Abs(mult1  - mult2 );
+      da = TMath::Abs(angle1 - angle2);
+      if (dv > fMaxDiffVz) return kFALSE;
+      if (dm > fMaxDiffMult ) return kFALSE;
+      if (da > fMaxDiffAngle) return kFALSE;
       return kTRUE;
    } else {
-      ivz1 = (Int_t)(event1->Vz() / fMaxDiffVz);
-      ivz2 = (Int_t)(event2->Vz() / fMaxDiffVz);
-      imult1 = (Int_t)(event1->Mult() / fMaxDiffMult);
-      imult2 = (Int_t)(event2->Mult() / fMaxDiffMult);
-      iangle1 = (Int_t)(event1->Angle() / fMaxDiffAngle);
-      iangle2 = (Int_t)(event2->Angle() / fMaxDiffAngle);
+      ivz1 = (Int_t)(vz1 / fMaxDiffVz);
+      ivz2 = (Int_t)(vz2 / fMaxDiffVz);
+      imult1 = (Int_t)(mult1 / fMaxDiffMult);
+      imult2 = (Int_t)(mult2 / fMaxDiffMult);
+      iangle1 = (Int_t)(angle1 / fMaxDiffAngle);
+      iangle2 = (Int_t)(angle2 / fMaxDiffAngle);
       if (ivz1 != ivz2) return kFALSE;
       if (imult1 != imult2) return kFALSE;
       if (iangle1 != iangle2) return kFALSE;
@@ -1589,6 +1623,67 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
    }
 }
 
+//__________________________________________________________________________________________________
+AliRsnMiniEvent *AliRsnMiniAnalysisTask::GetBufferedEvent(Int_t ievt, TObjArray &cache, TArrayI &cachedID)
+{
+//
+// Return the mini-event of the buffer with index ievt, from the cache of events
+// already read if it is there, otherwise it is read and stored in the cache
+// (replacing the event with the same index modulo the cache size).
+//
+
+   Int_t slot = ievt % cache.GetSize();
+   AliRsnMiniEvent *event = (AliRsnMiniEvent *)cache.At(slot);
+   if (event && cachedID[slot] == ievt) return event;
+
+   fEvBuffer->GetEntry(ievt);
+   if (!event) {
+      event = new AliRsnMiniEvent(*fMiniEvent);
+      cache.AddAt(event, slot);
+   } else {
+      *event = *fMiniEvent;
+   }
+   cachedID[slot] = ievt;
+   return event;
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::GroupPairOutputs(TArrayI &leader, TObjArray &sharing)
+{
+//
+// Group the pair-based outputs which build the same pairs (see AliRsnMiniOutput::SharesPairWith).
+// For each output, 'leader' is the index of the first output of its group;
+// for each leader, 'sharing' holds the list of the other outputs of the group.
+//
+
+   Int_t idef, jdef, nDefs = fHistograms.GetEntries();
+   AliRsnMiniOutput *def = 0x0, *first = 0x0;
+   TObjArray *list = 0x0;
+
+   leader.Set(nDefs);
+   sharing.Clear();
+   sharing.Expand(nDefs);
+   for (idef = 0; idef < nDefs; idef++) {
+      leader[idef] = idef;
+      def = (AliRsnMiniOutput *)fHistograms[idef];
+      if (!def) continue;
+      for (jdef = 0; jdef < idef; jdef++) {
+         if (leader[jdef] != jdef) continue;
+         first = (AliRsnMiniOutput *)fHistograms[jdef];
+         if (!first || !first->SharesPairWith(def)) continue;
+         leader[idef] = jdef;
+         list = (TObjArray *)sharing[jdef];
+         if (!list) {
+            list = new TObjArray(0);
+            sharing.AddAt(list, jdef);
+         }
+         list->Add(def);
+         AliDebugClass(1, Form("Def '%s' shares the pairs of def '%s'", def->GetName(), first->GetName()));
+         break;
+      }
+   }
+}
+
 //---------------------------------------------------------------------
 Double_t AliRsnMiniAnalysisTask::ApplyCentralityPatchPbPb2011(){
   //This part rejects randomly events such that the centrality gets flat for LHC11h Pb-Pb data
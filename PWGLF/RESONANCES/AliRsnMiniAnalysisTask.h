@@ -14,6 +14,7 @@
 
 #include <TString.h>
 #include <TClonesArray.h>
+#include <TArrayI.h>
 
 #include "AliAnalysisTaskSE.h"
 
@@ -62,6 +63,7 @@ public:
    void                SetMaxDiffAngle(Double_t val)      {fMaxDiffAngle = val;}
    void                SetEventCuts(AliRsnCutSet *cuts)   {fEventCuts    = cuts;}
    void                SetMixPrintRefresh(Int_t n)        {fMixPrintRefresh = n;}
+   void                SetMixCacheSize(Int_t n)           {fMixCacheSize = n;}
    void                SetCheckDecay(Bool_t checkDecay = kTRUE) {fCheckDecay = checkDecay;}
    void                SetMaxNDaughters(Short_t n)        {fMaxNDaughters = n;}
    void                SetCheckMomentumConservation(Bool_t checkP) {fCheckP = checkP;}
@@ -110,6 +112,9 @@ private:
    void     FillTrueMotherAOD(AliRsnMiniEvent *event);
    void     StoreTrueMother(AliRsnMiniPair *pair, AliRsnMiniEvent *event);
    Bool_t   EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2);
+   Bool_t   EventsMatch(Double_t vz1, Double_t mult1, Double_t angle1, Double_t vz2, Double_t mult2, Double_t angle2) const;
+   AliRsnMiniEvent *GetBufferedEvent(Int_t ievt, TObjArray &cache, TArrayI &cachedID);
+   void     GroupPairOutputs(TArrayI &leader, TObjArray &sharing);
    AliQnCorrectionsQnVector * GetQnVectorFromList(const TList *list,
                                                         const char *subdetector,
                                                         const char *expectedstep) const;
@@ -154,6 +159,7 @@ private:
    AliRsnMiniEvent     *fMiniEvent;       //! mini-event cursor
    Bool_t               fBigOutput;       // flag if open file for output list
    Int_t                fMixPrintRefresh; // how often info in mixing part is printed
+   Int_t                fMixCacheSize;    // mixing --> number of buffered mini-events kept in memory while mixing
    Bool_t               fCheckDecay;      // check if the mother decayed via the requested channel
    Short_t              fMaxNDaughters;   // maximum number of allowed mother's daughter
    Bool_t               fCheckP;          // flag to set in order to check the momentum conservation for mothers
@@ -171,7 +177,7 @@ private:
    Double_t             fSpherocity; // stores value of spherocity
    TObjArray            fResonanceFinders; // list of AliRsnMiniResonanceFinder objects
 
-   ClassDef(AliRsnMiniAnalysisTask, 18);   // AliRsnMiniAnalysisTask
+   ClassDef(AliRsnMiniAnalysisTask, 19);   // AliRsnMiniAnalysisTask
 };
 
 
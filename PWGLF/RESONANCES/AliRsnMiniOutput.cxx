@@ -17,6 +17,7 @@
 #include "THnSparse.h"
 #include "TString.h"
 #include "TClonesArray.h"
+#include "TObjArray.h"
 
 #include "AliRsnMiniParticle.h"
 #include "AliRsnMiniPair.h"
@@ -506,13 +507,16 @@ Bool_t AliRsnMiniOutput::FillMotherInAcceptance(const AliRsnMiniPair *pair, AliR
 }
 
 //________________________________________________________________________________________
-Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2, TClonesArray *valueList, Bool_t refFirst)
+Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2, TClonesArray *valueList, Bool_t refFirst, TObjArray *sharing)
 {
 //
 // Loops on the passed mini-event, and for each pair of particles
 // which satisfy the charge and cut requirements defined here, add an entry.
 // Returns the number of successful fillings.
 // Last argument tells if the reference event for event-based values is the first or the second.
+// The outputs in 'sharing' (if any) must have the same daughter definitions
+// as this one (see SharesPairWith): each pair is built once and then
+// checked and filled for this output and for all of them.
 //
 
    // check computation type
@@ -528,8 +532,11 @@ Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event
    }
 
    // loop variables
-   Int_t i1, i2, start, nadded = 0;
+   Int_t i1, i2, start, iout, nadded = 0;
+   Int_t nout = (sharing ? sharing->GetEntriesFast() : 0);
    AliRsnMiniParticle *p1, *p2;
+   AliRsnMiniOutput *out = 0x0;
+   AliRsnMiniEvent *refEvent = (refFirst ? event1 : event2);
    Double_t mass1, mass2;
 
    // it is necessary to know if criteria for the two daughters are the same
@@ -538,14 +545,18 @@ Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event
    Bool_t sameCriteria = ((fCharge[0] == fCharge[1]) && (fDaughter[0] == fDaughter[1]));
    Bool_t sameEvent = (event1->ID() == event2->ID());
 
-   TString selList1  = "";
-   TString selList2  = "";
    Int_t   n1 = event1->CountParticles(fSel1, fCharge[0], fCutID[0]);
    Int_t   n2 = event2->CountParticles(fSel2, fCharge[1], fCutID[1]);
-   for (i1 = 0; i1 < n1; i1++) selList1.Append(Form("%d ", fSel1[i1]));
-   for (i2 = 0; i2 < n2; i2++) selList2.Append(Form("%d ", fSel2[i2]));
-   AliDebugClass(1, Form("[%10s] Part #1: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", GetName(), (event1 == event2 ? "def" : "mix"), event1->ID(), fCharge[0], fCutID[0], n1, selList1.Data()));
-   AliDebugClass(1, Form("[%10s] Part #2: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", GetName(), (event1 == event2 ? "def" : "mix"), event2->ID(), fCharge[1], fCutID[1], n2, selList2.Data()));
+   // the lists of selected particles are printed only when debugging,
+   // since building them for every call is expensive
+   if (AliLog::GetDebugLevel("", ClassName()) >= 1) {
+      TString selList1  = "";
+      TString selList2  = "";
+      for (i1 = 0; i1 < n1; i1++) selList1.Append(Form("%d ", fSel1[i1]));
+      for (i2 = 0; i2 < n2; i2++) selList2.Append(Form("%d ", fSel2[i2]));
+      AliDebugClass(1, Form("[%10s] Part #1: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", GetName(), (event1 == event2 ? "def" : "mix"), event1->ID(), fCharge[0], fCutID[0], n1, selList1.Data()));
+      AliDebugClass(1, Form("[%10s] Part #2: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", GetName(), (event1 == event2 ? "def" : "mix"), event2->ID(), fCharge[1], fCutID[1], n2, selList2.Data()));
+   }
    if (!n1 || !n2) {
       AliDebugClass(1, "No pairs to mix");
       return 0;
@@ -554,9 +565,6 @@ Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event
    // external loop
    for (i1 = 0; i1 < n1; i1++) {
       p1 = event1->GetParticle(fSel1[i1]);
-      //p1 = event1->GetParticle(i1);
-      //if (p1->Charge() != fCharge[0]) continue;
-      //if (!p1->HasCutBit(fCutID[0])) continue;
       // define starting point for inner loop
       // if daughter selection criteria (charge, cuts) are the same
       // and the two events coincide, internal loop must start from
@@ -567,44 +575,65 @@ Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event
       // internal loop
       for (i2 = start; i2 < n2; i2++) {
          p2 = event2->GetParticle(fSel2[i2]);
-         //p2 = event2->GetParticle(i2);
-         //if (p2->Charge() != fCharge[1]) continue;
-         //if (!p2->HasCutBit(fCutID[1])) continue;
          // avoid to mix a particle with itself
          if (sameEvent && (p1->Index() == p2->Index()) && (!p1->IsResonance())) {
             AliDebugClass(2, "Skipping same index");
             continue;
          }
          // sum momenta
-          
          mass1 = p1->StoredMass(kFALSE);
          if(!fUseStoredMass[0] || mass1 < 0.0) mass1 = GetMass(0);
          mass2 = p2->StoredMass(kFALSE);
          if(!fUseStoredMass[1] || mass2 < 0.0) mass2 = GetMass(1);
          fPair.Fill(p1, p2, mass1, mass2, fMotherMass);
-	 
+
          // do rotation if needed
          if (fComputation == kTrackPairRotated1) fPair.InvertP(kTRUE);
          if (fComputation == kTrackPairRotated2) fPair.InvertP(kFALSE);
-         // if required, check that this is a true pair
-         if (fComputation == kTruePair) {
-            if (fPair.Mother() < 0)  {
-               continue;
-            } else if (fPair.MotherPDG() != fMotherPDG) {
-               continue;
-            }
-            Bool_t decayMatch = kFALSE;
-            if (AliRsnDaughter::IsEquivalentPDGCode(p1->PDGAbs() , GetPDG(0))
+
+         // check and fill this output and the ones sharing the pair
+         if (AcceptPair(p1, p2, fPair, refEvent, valueList)) nadded++;
+         for (iout = 0; iout < nout; iout++) {
+            out = (AliRsnMiniOutput *)sharing->UncheckedAt(iout);
+            if (out->AcceptPair(p1, p2, fPair, refEvent, valueList)) nadded++;
+         }
+      } // end internal loop
+   } // end external loop
+
+   AliDebugClass(1, Form("Pairs added in total = %4d", nadded));
+   return nadded;
+}
+
+//________________________________________________________________________________________
+Bool_t AliRsnMiniOutput::AcceptPair(AliRsnMiniParticle *p1, AliRsnMiniParticle *p2, const AliRsnMiniPair &pair, AliRsnMiniEvent *refEvent, TClonesArray *valueList)
+{
+//
+// Checks a pair built in FillPair (by this output or by another one
+// with the same daughter definitions) against the true-pair requirements
+// and the pair cuts of this output, and if accepted fills the histogram.
+//
+
+   if (&pair != &fPair) fPair = pair;
+
+   // if required, check that this is a true pair
+   if (fComputation == kTruePair) {
+      if (fPair.Mother() < 0)  {
+         return kFALSE;
+      } else if (fPair.MotherPDG() != fMotherPDG) {
+         return kFALSE;
+      }
+      Bool_t decayMatch = kFALSE;
+      if (AliRsnDaughter::IsEquivalentPDGCode(p1->PDGAbs() , GetPDG(0))
 		&& AliRsnDaughter::IsEquivalentPDGCode(p2->PDGAbs() , GetPDG(1)))
-               decayMatch = kTRUE;
-            if (AliRsnDaughter::IsEquivalentPDGCode(p2->PDGAbs() , GetPDG(0))
+         decayMatch = kTRUE;
+      if (AliRsnDaughter::IsEquivalentPDGCode(p2->PDGAbs() , GetPDG(0))
 		&& AliRsnDaughter::IsEquivalentPDGCode(p1->PDGAbs() , GetPDG(1)))
-               decayMatch = kTRUE;
-            if (!decayMatch) continue;
-	    if ( (fMaxNSisters>0) && (p1->NTotSisters()==p2->NTotSisters()) && (p1->NTotSisters()>fMaxNSisters)) continue;
+         decayMatch = kTRUE;
+      if (!decayMatch) return kFALSE;
+	    if ( (fMaxNSisters>0) && (p1->NTotSisters()==p2->NTotSisters()) && (p1->NTotSisters()>fMaxNSisters)) return kFALSE;
 	    if ( fCheckP &&(TMath::Abs(fPair.PmotherX()-(p1->Px(1)+p2->Px(1)))/(TMath::Abs(fPair.PmotherX())+1.e-13)) > 0.00001 &&
 		          (TMath::Abs(fPair.PmotherY()-(p1->Py(1)+p2->Py(1)))/(TMath::Abs(fPair.PmotherY())+1.e-13)) > 0.00001 &&
-     			  (TMath::Abs(fPair.PmotherZ()-(p1->Pz(1)+p2->Pz(1)))/(TMath::Abs(fPair.PmotherZ())+1.e-13)) > 0.00001 ) continue;
+  			  (TMath::Abs(fPair.PmotherZ()-(p1->Pz(1)+p2->Pz(1)))/(TMath::Abs(fPair.PmotherZ())+1.e-13)) > 0.00001 ) return kFALSE;
 	    if ( fCheckFeedDown ){
 	    		Int_t pdgGranma = 0;
 	  		Bool_t isFromB=kFALSE;
@@ -621,32 +650,53 @@ Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event
 			  }
 	  		if (pdgGranma == -99999){
 	  			AliDebug(2,"This particle does not have a quark in his genealogy\n");
-	  			continue;
+	  			return kFALSE;
 	  		}
 	  		if (pdgGranma == -9999){
 	  			AliDebug(2,"This particle come from a B decay channel but according to the settings of the task, we keep only the prompt charm particles\n");
-	  			continue;
+	  			return kFALSE;
 	  		}
 	 
 	  		if (pdgGranma == -999){
 	  			AliDebug(2,"This particle come from a prompt charm particles but according to the settings of the task, we want only the ones coming from B\n");
-	  			continue;
+	  			return kFALSE;
 	  		}
 		    }
-         }
-         // check pair against cuts
-         if (fPairCuts) {
-            if (!fPairCuts->IsSelected(&fPair)) continue;
-         }
-         // get computed values & fill histogram
-         nadded++;
-         if (refFirst) ComputeValues(event1, valueList); else ComputeValues(event2, valueList);
-         FillHistogram();
-      } // end internal loop
-   } // end external loop
+   }
+   // check pair against cuts
+   if (fPairCuts) {
+      if (!fPairCuts->IsSelected(&fPair)) return kFALSE;
+   }
+   // get computed values & fill histogram
+   ComputeValues(refEvent, valueList);
+   FillHistogram();
+   return kTRUE;
+}
 
-   AliDebugClass(1, Form("Pairs added in total = %4d", nadded));
-   return nadded;
+//________________________________________________________________________________________
+Bool_t AliRsnMiniOutput::SharesPairWith(const AliRsnMiniOutput *out) const
+{
+//
+// Tells if the pairs built for this output are the same as the ones of
+// the passed output, before the true-pair check and the pair cuts:
+// this requires the same daughter selection, masses and kind of computation
+// (true pairs are built in the same way as track pairs).
+//
+
+   if (!out) return kFALSE;
+
+   EComputation comp1 = (fComputation == kTruePair ? kTrackPair : fComputation);
+   EComputation comp2 = (out->fComputation == kTruePair ? kTrackPair : out->fComputation);
+   if (comp1 != comp2) return kFALSE;
+   if (comp1 != kTrackPair && comp1 != kTrackPairMix && comp1 != kTrackPairRotated1 && comp1 != kTrackPairRotated2) return kFALSE;
+
+   for (Int_t i = 0; i < 2; i++) {
+      if (fCutID[i]        != out->fCutID[i])        return kFALSE;
+      if (fCharge[i]       != out->fCharge[i])       return kFALSE;
+      if (fDaughter[i]     != out->fDaughter[i])     return kFALSE;
+      if (fUseStoredMass[i] != out->fUseStoredMass[i]) return kFALSE;
+   }
+   return (fMotherMass == out->fMotherMass);
 }
 //___________________________________________________________
 void AliRsnMiniOutput::SetDselection(UShort_t originDselection)
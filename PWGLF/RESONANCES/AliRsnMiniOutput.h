@@ -21,6 +21,7 @@ class TH1;
 
 class TList;
 class TClonesArray;
+class TObjArray;
 class AliRsnMiniAxis;
 class AliRsnMiniPair;
 class AliRsnMiniEvent;
@@ -109,7 +110,8 @@ public:
    Bool_t          FillMother(const AliRsnMiniPair *pair, AliRsnMiniEvent *event, TClonesArray *valueList);
    Bool_t          FillMotherInAcceptance(const AliRsnMiniPair *pair, AliRsnMiniEvent *event, TClonesArray *valueList);
    Bool_t          FillEvent(AliRsnMiniEvent *event, TClonesArray *valueList);
-   Int_t           FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2, TClonesArray *valueList, Bool_t refFirst = kTRUE);
+   Int_t           FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2, TClonesArray *valueList, Bool_t refFirst = kTRUE, TObjArray *sharing = 0x0);
+   Bool_t          SharesPairWith(const AliRsnMiniOutput *out) const;
 
 private:
 
@@ -117,6 +119,7 @@ private:
    void   CreateHistogramSparse(const char *name);
    void   ComputeValues(AliRsnMiniEvent *event, TClonesArray *valueList);
    void   FillHistogram();
+   Bool_t AcceptPair(AliRsnMiniParticle *p1, AliRsnMiniParticle *p2, const AliRsnMiniPair &pair, AliRsnMiniEvent *refEvent, TClonesArray *valueList);
 
    EOutputType      fOutputType;       //  type of output
    EComputation     fComputation;      //  type of computation